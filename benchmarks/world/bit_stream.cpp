@@ -0,0 +1,68 @@
+#include "inexor/vulkan-renderer/world/bit_stream.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+std::vector<unsigned char> random_bytes(std::size_t size) {
+    std::vector<unsigned char> data(size);
+    std::mt19937 generator(0);
+    for (auto &byte : data) {
+        byte = static_cast<unsigned char>(generator());
+    }
+    return data;
+}
+} // namespace
+
+void BitStreamGet(benchmark::State &state) {
+    const auto data = random_bytes(1 << 20);
+    const auto size = static_cast<std::uint8_t>(state.range(0));
+    for (auto _ : state) {
+        BitStream stream(data.data(), data.size());
+        std::uint64_t sum = 0;
+        while (const auto bits = stream.get(size)) {
+            sum += *bits;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BitStreamGet)->Arg(1)->Arg(2)->Arg(3)->Arg(8)->Arg(BitStream::MAX_BITS);
+
+void BitStreamGetIndentations(benchmark::State &state) {
+    const auto data = random_bytes(1 << 20);
+    for (auto _ : state) {
+        BitStream stream(data.data(), data.size());
+        std::uint64_t sum = 0;
+        while (const auto levels = stream.get_indentations()) {
+            sum += (*levels)[7].z;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BitStreamGetIndentations);
+
+void BitStreamGetIndentationsOneByOne(benchmark::State &state) {
+    const auto data = random_bytes(1 << 20);
+    for (auto _ : state) {
+        BitStream stream(data.data(), data.size());
+        std::uint64_t sum = 0;
+        while (const auto indented = stream.get(1)) {
+            if (*indented) {
+                const auto level = stream.get(3);
+                if (!level) {
+                    break;
+                }
+                sum += *level + 1;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BitStreamGetIndentationsOneByOne);
+} // namespace inexor::vulkan_renderer::world
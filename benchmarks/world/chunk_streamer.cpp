@@ -0,0 +1,26 @@
+#include "inexor/vulkan-renderer/world/chunk_streamer.hpp"
+#include "random_octree.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace inexor::vulkan_renderer::world {
+void ChunkStreamerUpdate(benchmark::State &state) {
+    // The cost of an update on the render thread while flying through an endless world.
+    ThreadPool thread_pool;
+    const auto data = random_octree(3);
+    StreamingOptions options;
+    options.load_radius = static_cast<float>(state.range(0));
+    options.memory_budget = std::size_t(16) << 20;
+    ChunkStreamer streamer(thread_pool, [data](const glm::ivec3 &) { return data; }, options);
+    const glm::vec3 velocity(8.0f, 0.0f, 2.0f);
+    glm::vec3 position(0.0f);
+    std::size_t loaded = 0;
+    for (auto _ : state) {
+        position += velocity / 60.0f;
+        loaded += streamer.update(position, velocity).loaded.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["loaded_per_update"] = benchmark::Counter(static_cast<double>(loaded) / state.iterations());
+}
+BENCHMARK(ChunkStreamerUpdate)->Arg(4)->Arg(8);
+} // namespace inexor::vulkan_renderer::world
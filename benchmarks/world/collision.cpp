@@ -0,0 +1,93 @@
+#include "inexor/vulkan-renderer/thread_pool.hpp"
+#include "inexor/vulkan-renderer/world/collision.hpp"
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/octree_generator.hpp"
+#include "terrain_octree.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// Create character sized capsules at random points around the surface of the terrain.
+std::vector<Capsule> random_capsules(std::size_t count) {
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<Capsule> capsules(count);
+    for (auto &capsule : capsules) {
+        const glm::vec3 foot = {distribution(generator), 0.3f + 0.4f * distribution(generator),
+                                distribution(generator)};
+        capsule = {foot, foot + glm::vec3(0.0f, 0.02f, 0.0f), 0.005f};
+    }
+    return capsules;
+}
+} // namespace
+
+void CollideSphere(benchmark::State &state) {
+    auto data = terrain_octree(static_cast<std::uint32_t>(state.range(0)));
+    Cube cube = Cube::parse(data);
+    const auto capsules = random_capsules(1024);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const Capsule &capsule = capsules[i++ % capsules.size()];
+        benchmark::DoNotOptimize(collides(cube, Sphere{capsule.start, capsule.radius}));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(CollideSphere)->Arg(5)->Arg(8);
+
+void CollideBox(benchmark::State &state) {
+    auto data = terrain_octree(static_cast<std::uint32_t>(state.range(0)));
+    Cube cube = Cube::parse(data);
+    const auto capsules = random_capsules(1024);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const Capsule &capsule = capsules[i++ % capsules.size()];
+        const glm::vec3 radius(capsule.radius);
+        benchmark::DoNotOptimize(collides(cube, Box{capsule.start - radius, capsule.end + radius}));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(CollideBox)->Arg(5)->Arg(8);
+
+void CollideCapsule(benchmark::State &state) {
+    auto data = terrain_octree(static_cast<std::uint32_t>(state.range(0)));
+    Cube cube = Cube::parse(data);
+    const auto capsules = random_capsules(1024);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(collides(cube, capsules[i++ % capsules.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(CollideCapsule)->Arg(5)->Arg(8);
+
+void CollideCapsuleRandom(benchmark::State &state) {
+    // Half of the leaves of the random octree are indented, which are tested against their polygons.
+    GeneratorSettings settings;
+    settings.depth = static_cast<std::uint32_t>(state.range(0));
+    settings.indentation_probability = 1.0f;
+    auto data = generate_octree_data(settings);
+    Cube cube = Cube::parse(data);
+    const auto capsules = random_capsules(1024);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(collides(cube, capsules[i++ % capsules.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(CollideCapsuleRandom)->Arg(5);
+
+void CollideCapsuleBatched(benchmark::State &state) {
+    auto data = terrain_octree(8);
+    Cube cube = Cube::parse(data);
+    const auto capsules = random_capsules(static_cast<std::size_t>(state.range(0)));
+    ThreadPool thread_pool;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(collides(cube, capsules, thread_pool));
+    }
+    state.SetItemsProcessed(state.iterations() * capsules.size());
+}
+BENCHMARK(CollideCapsuleBatched)->Arg(4096)->Arg(65536)->UseRealTime();
+} // namespace inexor::vulkan_renderer::world
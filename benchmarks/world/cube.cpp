@@ -0,0 +1,132 @@
+#include "inexor/vulkan-renderer/thread_pool.hpp"
+#include "inexor/vulkan-renderer/world/bit_stream_writer.hpp"
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "random_octree.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// Collect all leaves of CubeType::INDENTED of an octree.
+void indented_leaves(Cube &cube, std::vector<Cube *> &leaves) {
+    if (cube.type() == CubeType::INDENTED) {
+        leaves.push_back(&cube);
+    } else if (cube.type() == CubeType::OCTANT) {
+        for (const auto &octant : *cube.octants) {
+            indented_leaves(*octant, leaves);
+        }
+    }
+}
+} // namespace
+
+void CubeSerialize(benchmark::State &state) {
+    auto data = random_octree(state.range(0));
+    const Cube cube = Cube::parse(data);
+    for (auto _ : state) {
+        BitStreamWriter writer(data.size());
+        cube.serialize(writer);
+        benchmark::DoNotOptimize(writer.finish());
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(CubeSerialize)->Arg(3)->Arg(5);
+
+void BitStreamWriterPut(benchmark::State &state) {
+    const auto size = static_cast<std::uint8_t>(state.range(0));
+    constexpr std::size_t BYTES = 1 << 20;
+    for (auto _ : state) {
+        BitStreamWriter writer(BYTES);
+        for (std::size_t i = 0; i < BYTES * 8 / size; i++) {
+            writer.put(i & ((std::uint64_t{1} << size) - 1), size);
+        }
+        benchmark::DoNotOptimize(writer.finish());
+    }
+    state.SetBytesProcessed(state.iterations() * BYTES);
+}
+BENCHMARK(BitStreamWriterPut)->Arg(1)->Arg(2)->Arg(8)->Arg(BitStreamWriter::MAX_BITS);
+
+void CubeParseParallel(benchmark::State &state) {
+    const auto data = random_octree(state.range(0));
+    ThreadPool thread_pool;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Cube::parse(data, thread_pool, static_cast<std::uint32_t>(state.range(1))));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(CubeParseParallel)->Args({5, 1})->Args({5, 2})->Args({6, 2})->UseRealTime();
+
+void CubePolygonsParallel(benchmark::State &state) {
+    auto data = random_octree(state.range(0));
+    Cube cube = Cube::parse(data);
+    ThreadPool thread_pool(static_cast<std::size_t>(state.range(2)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cube.polygons(thread_pool, static_cast<std::uint32_t>(state.range(1))));
+    }
+    state.counters["leaves"] = static_cast<double>(cube.leaves());
+}
+// Octree depth, split depth and threads. Split depth 0 is a single task, which compares to CubePolygons.
+BENCHMARK(CubePolygonsParallel)
+    ->Args({5, 0, 6})
+    ->Args({5, 1, 6})
+    ->Args({5, 2, 6})
+    ->Args({5, 2, 12})
+    ->Args({6, 2, 6})
+    ->UseRealTime();
+
+void SubtreeIndexBuild(benchmark::State &state) {
+    const auto data = random_octree(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SubtreeIndex::build(data.data(), data.size(), 2));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(SubtreeIndexBuild)->Arg(5)->Arg(6);
+
+void CubeEditIndentations(benchmark::State &state) {
+    auto data = random_octree(state.range(0));
+    auto cube = std::make_shared<Cube>(Cube::parse(data));
+    cube->make_reactive();
+    std::size_t changed = 0;
+    cube->journal()->subscribe([&changed](const std::vector<Cube *> &cubes) { changed += cubes.size(); });
+    std::vector<Cube *> leaves;
+    indented_leaves(*cube, leaves);
+    std::uint8_t level = 0;
+    for (auto _ : state) {
+        // Every corner of every indented leaf is edited once per frame.
+        level = (level + 1) % MAX_INDENTATION;
+        for (Cube *leaf : leaves) {
+            for (auto &indentation : *leaf->indentations) {
+                indentation.set_x(level);
+            }
+        }
+        cube->journal()->flush();
+    }
+    benchmark::DoNotOptimize(changed);
+    state.SetItemsProcessed(state.iterations() * leaves.size() * 8);
+}
+BENCHMARK(CubeEditIndentations)->Arg(3)->Arg(5);
+
+void CubeEditAggregates(benchmark::State &state) {
+    // One leaf is edited per iteration, then the aggregates of the root are queried. Reactive octrees update the
+    // cached aggregates on the path to the root, other octrees visit all cubes.
+    auto data = random_octree(state.range(0));
+    auto cube = std::make_shared<Cube>(Cube::parse(data));
+    if (state.range(1) != 0) {
+        cube->make_reactive();
+    }
+    std::vector<Cube *> leaves;
+    indented_leaves(*cube, leaves);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        Cube *leaf = leaves[i++ % leaves.size()];
+        leaf->indentations.value()[7].set_y(static_cast<std::uint8_t>(i % MAX_INDENTATION));
+        benchmark::DoNotOptimize(cube->leaves());
+        benchmark::DoNotOptimize(cube->bounds());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+// Octree depth and whether the octree is reactive.
+BENCHMARK(CubeEditAggregates)->Args({5, 0})->Args({5, 1})->Args({6, 0})->Args({6, 1});
+} // namespace inexor::vulkan_renderer::world
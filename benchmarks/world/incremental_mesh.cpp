@@ -0,0 +1,77 @@
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/incremental_mesh.hpp"
+#include "random_octree.hpp"
+#include "terrain_octree.hpp"
+
+#include <benchmark/benchmark.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <memory>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// Find the first indented leaf of an octree.
+Cube *find_indented(Cube &cube) {
+    if (cube.type() == CubeType::INDENTED) {
+        return &cube;
+    }
+    if (cube.type() == CubeType::OCTANT) {
+        for (const auto &octant : *cube.octants) {
+            if (Cube *leaf = find_indented(*octant)) {
+                return leaf;
+            }
+        }
+    }
+    return nullptr;
+}
+} // namespace
+
+void CubeRemeshFull(benchmark::State &state) {
+    auto data = random_octree(state.range(0));
+    auto cube = std::make_shared<Cube>(Cube::parse(data));
+    cube->make_reactive();
+    Cube *leaf = find_indented(*cube);
+    std::uint8_t level = 0;
+    for (auto _ : state) {
+        (*leaf->indentations)[0].set_x(level++ % MAX_INDENTATION);
+        benchmark::DoNotOptimize(cube->polygons());
+    }
+}
+BENCHMARK(CubeRemeshFull)->Arg(3)->Arg(5);
+
+void IncrementalMeshRemesh(benchmark::State &state) {
+    auto data = random_octree(state.range(0));
+    auto cube = std::make_shared<Cube>(Cube::parse(data));
+    IncrementalMesh mesh(cube);
+    mesh.update();
+    Cube *leaf = find_indented(*cube);
+    std::uint8_t level = 0;
+    for (auto _ : state) {
+        (*leaf->indentations)[0].set_x(level++ % MAX_INDENTATION);
+        benchmark::DoNotOptimize(mesh.update());
+    }
+}
+BENCHMARK(IncrementalMeshRemesh)->Arg(3)->Arg(5);
+
+void IncrementalMeshVisible(benchmark::State &state) {
+    auto data = terrain_octree(static_cast<std::uint32_t>(state.range(0)));
+    auto cube = std::make_shared<Cube>(Cube::parse(data));
+    IncrementalMesh mesh(cube);
+    mesh.update();
+    // A camera within the map which looks along the negative z-axis towards the border of the map.
+    const glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.01f, 10.0f);
+    const Frustum frustum(projection * glm::translate(glm::mat4(1.0f), -glm::vec3(0.3f, 0.6f, 0.3f)));
+    std::vector<IncrementalMesh::Range> ranges;
+    for (auto _ : state) {
+        ranges = mesh.visible(frustum);
+        benchmark::DoNotOptimize(ranges);
+    }
+    std::size_t visible = 0;
+    for (const auto &range : ranges) {
+        visible += range.count;
+    }
+    state.counters["ranges"] = static_cast<double>(ranges.size());
+    state.counters["visible"] = static_cast<double>(visible) / static_cast<double>(mesh.polygons().size());
+}
+BENCHMARK(IncrementalMeshVisible)->Arg(5)->Arg(8);
+} // namespace inexor::vulkan_renderer::world
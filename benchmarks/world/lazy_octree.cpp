@@ -0,0 +1,52 @@
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/lazy_octree.hpp"
+#include "random_octree.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace inexor::vulkan_renderer::world {
+void LazyOctreeFind(benchmark::State &state) {
+    const auto data = random_octree(state.range(0));
+    std::size_t nodes = 0;
+    for (auto _ : state) {
+        LazyOctree octree(data.data(), data.size());
+        benchmark::DoNotOptimize(octree.find({0.9f, 0.9f, 0.9f}));
+        nodes = octree.node_count();
+    }
+    state.counters["nodes"] = static_cast<double>(nodes);
+}
+BENCHMARK(LazyOctreeFind)->Arg(5)->Arg(6);
+
+void LazyOctreeFindIndexed(benchmark::State &state) {
+    // The index is stored next to the data, so building it is not part of the measurement.
+    const auto data = random_octree(state.range(0));
+    const auto index = SubtreeIndex::build(data.data(), data.size(), static_cast<std::uint32_t>(state.range(1)));
+    for (auto _ : state) {
+        LazyOctree octree(data.data(), data.size(), *index);
+        benchmark::DoNotOptimize(octree.find({0.9f, 0.9f, 0.9f}));
+    }
+    state.counters["offsets"] = static_cast<double>(index->offsets().size());
+}
+BENCHMARK(LazyOctreeFindIndexed)->Args({5, 2})->Args({6, 2})->Args({6, 4});
+
+void LazyOctreeRegionPolygons(benchmark::State &state) {
+    const auto data = random_octree(state.range(0));
+    std::size_t memory = 0;
+    for (auto _ : state) {
+        LazyOctree octree(data.data(), data.size());
+        benchmark::DoNotOptimize(octree.polygons({0.0f, 0.0f, 0.0f}, {0.2f, 0.2f, 0.2f}));
+        memory = octree.memory_usage();
+    }
+    state.counters["bytes"] = static_cast<double>(memory);
+}
+BENCHMARK(LazyOctreeRegionPolygons)->Arg(5)->Arg(6);
+
+void LazyOctreePolygons(benchmark::State &state) {
+    const auto data = random_octree(state.range(0));
+    for (auto _ : state) {
+        LazyOctree octree(data.data(), data.size());
+        benchmark::DoNotOptimize(octree.polygons());
+    }
+}
+BENCHMARK(LazyOctreePolygons)->Arg(5);
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,29 @@
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/level_of_detail.hpp"
+#include "inexor/vulkan-renderer/world/mesher.hpp"
+#include "terrain_octree.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace inexor::vulkan_renderer::world {
+/// Select the level of detail and mesh a terrain whose leaves have size 1, so the view distance from the center of
+/// the map doubles with every level.
+void LevelOfDetailTerrain(benchmark::State &state) {
+    const auto depth = static_cast<std::uint32_t>(state.range(0));
+    auto data = terrain_octree(depth);
+    BitStream stream(data.data(), data.size());
+    const auto size = static_cast<float>(1u << depth);
+    Cube cube = Cube::parse(stream, size, DEFAULT_CUBE_POSITION);
+    const glm::vec3 camera = {size / 2, size * 0.7f, size / 2};
+    std::size_t triangles = 0;
+    for (auto _ : state) {
+        LevelOfDetail lod;
+        lod.update(cube, camera);
+        triangles = lod.polygons(cube).size();
+        benchmark::DoNotOptimize(triangles);
+    }
+    state.counters["triangles"] = static_cast<double>(triangles);
+    state.counters["full_detail"] = static_cast<double>(cube.leaves() * 12);
+}
+BENCHMARK(LevelOfDetailTerrain)->Arg(5)->Arg(6)->Arg(7)->Arg(8);
+} // namespace inexor::vulkan_renderer::world
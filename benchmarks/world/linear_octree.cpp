@@ -0,0 +1,83 @@
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/linear_octree.hpp"
+#include "random_octree.hpp"
+#include "terrain_octree.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// Create random points within the octree.
+std::vector<glm::vec3> random_points(std::size_t count) {
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<glm::vec3> points(count);
+    for (auto &point : points) {
+        point = {distribution(generator), distribution(generator), distribution(generator)};
+    }
+    return points;
+}
+
+/// Parse the octree of a benchmark, 0 selects the terrain and 1 the random octree.
+std::shared_ptr<Cube> benchmark_octree(const benchmark::State &state) {
+    const auto depth = static_cast<std::uint32_t>(state.range(0));
+    auto data = state.range(1) == 0 ? terrain_octree(depth) : random_octree(depth);
+    return std::make_shared<Cube>(Cube::parse(data));
+}
+} // namespace
+
+void CubeDescend(benchmark::State &state) {
+    auto cube = benchmark_octree(state);
+    const auto points = random_points(4096);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cube->find(points[i++ % points.size()]));
+    }
+}
+BENCHMARK(CubeDescend)->Args({8, 0})->Args({5, 1});
+
+void LinearOctreeFind(benchmark::State &state) {
+    auto cube = benchmark_octree(state);
+    const LinearOctree octree(cube);
+    const auto points = random_points(4096);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(octree.find(points[i++ % points.size()]));
+    }
+}
+BENCHMARK(LinearOctreeFind)->Args({8, 0})->Args({5, 1});
+
+void CubeDescendNeighbour(benchmark::State &state) {
+    auto cube = benchmark_octree(state);
+    std::vector<Cube *> leaves;
+    for (const auto &point : random_points(4096)) {
+        leaves.push_back(cube->find(point));
+    }
+    std::size_t i = 0;
+    for (auto _ : state) {
+        // The neighbour on the higher x side contains the point next to the center of that face.
+        Cube *leaf = leaves[i++ % leaves.size()];
+        const float half = leaf->size() / 2;
+        const glm::vec3 point = leaf->position() + glm::vec3(leaf->size() + half / 2, half, half);
+        benchmark::DoNotOptimize(point.x < 1.0f ? cube->find(point) : nullptr);
+    }
+}
+BENCHMARK(CubeDescendNeighbour)->Args({8, 0})->Args({5, 1});
+
+void LinearOctreeNeighbour(benchmark::State &state) {
+    auto cube = benchmark_octree(state);
+    const LinearOctree octree(cube);
+    std::vector<LinearOctree::Key> leaves;
+    for (const auto &point : random_points(4096)) {
+        leaves.push_back(*octree.locate(point));
+    }
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(octree.neighbour(leaves[i++ % leaves.size()], 1));
+    }
+}
+BENCHMARK(LinearOctreeNeighbour)->Args({8, 0})->Args({5, 1});
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,69 @@
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/indexed_mesh.hpp"
+#include "inexor/vulkan-renderer/world/mesher.hpp"
+#include "random_octree.hpp"
+#include "terrain_octree.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// Mesh an octree and report the number of triangles and how many of them are hidden or merged. The arguments 1 and 2
+/// of the benchmark select whether hidden faces are culled and whether faces are merged.
+void mesh(benchmark::State &state, std::vector<unsigned char> data) {
+    Cube cube = Cube::parse(data);
+    MeshOptions options;
+    options.cull_hidden_faces = state.range(1) != 0;
+    options.merge_faces = state.range(2) != 0;
+    Mesher mesher(options);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(mesher.polygons(cube));
+    }
+    const MeshStatistics &statistics = mesher.statistics();
+    state.counters["triangles"] = static_cast<double>(statistics.triangles);
+    state.counters["hidden"] = static_cast<double>(statistics.hidden_triangles);
+    state.counters["merged"] = static_cast<double>(statistics.merged_triangles);
+    state.counters["reduction"] =
+        1.0 - static_cast<double>(statistics.triangles) / static_cast<double>(statistics.leaves * 12);
+}
+} // namespace
+
+void MesherRandom(benchmark::State &state) {
+    mesh(state, random_octree(state.range(0)));
+}
+BENCHMARK(MesherRandom)->Args({4, 0, 0})->Args({4, 1, 0})->Args({4, 1, 1})->Args({5, 1, 0})->Args({5, 1, 1});
+
+void MesherTerrain(benchmark::State &state) {
+    mesh(state, terrain_octree(static_cast<std::uint32_t>(state.range(0))));
+}
+BENCHMARK(MesherTerrain)->Args({5, 0, 0})->Args({5, 1, 0})->Args({5, 1, 1})->Args({7, 1, 0})->Args({7, 1, 1});
+
+void MesherVertices(benchmark::State &state) {
+    // The polygons with the normals, texture coordinates and materials of their faces.
+    auto data = terrain_octree(static_cast<std::uint32_t>(state.range(0)));
+    Cube cube = Cube::parse(data);
+    MeshOptions options;
+    options.material = [](Cube & /*leaf*/, std::size_t face) { return static_cast<std::uint16_t>(face == 3 ? 1 : 0); };
+    Mesher mesher(options);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(mesher.vertices(cube));
+    }
+    state.counters["triangles"] = static_cast<double>(mesher.statistics().triangles);
+}
+BENCHMARK(MesherVertices)->Arg(5)->Arg(7);
+
+void IndexedMeshFromPolygons(benchmark::State &state) {
+    auto data = terrain_octree(static_cast<std::uint32_t>(state.range(0)));
+    Cube cube = Cube::parse(data);
+    const auto polygons = Mesher().polygons(cube);
+    std::size_t vertices = 0;
+    for (auto _ : state) {
+        const IndexedMesh mesh = IndexedMesh::from_polygons(polygons);
+        vertices = mesh.vertices.size();
+        benchmark::DoNotOptimize(mesh);
+    }
+    state.counters["vertices"] = static_cast<double>(polygons.size() * 3);
+    state.counters["unique"] = static_cast<double>(vertices);
+}
+BENCHMARK(IndexedMeshFromPolygons)->Arg(5)->Arg(7);
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,54 @@
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/octree_delta.hpp"
+#include "random_octree.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// Create deltas which replace random cubes at a depth by full or empty leaves.
+std::vector<OctreeDelta> random_deltas(std::size_t count, std::uint32_t depth) {
+    std::mt19937 generator(0);
+    std::vector<OctreeDelta> deltas(count);
+    for (auto &delta : deltas) {
+        delta.path.resize(depth);
+        for (auto &octant : delta.path) {
+            octant = generator() % 8;
+        }
+        delta.type = generator() % 2 ? CubeType::FULL : CubeType::EMPTY;
+    }
+    return deltas;
+}
+} // namespace
+
+void OctreeDeltaApply(benchmark::State &state) {
+    // Autosaving an edit costs its delta instead of the serialization of the whole octree (see CubeSerialize).
+    const auto depth = static_cast<std::uint32_t>(state.range(0));
+    auto data = random_octree(depth);
+    Cube octree = Cube::parse(data);
+    const auto deltas = random_deltas(static_cast<std::size_t>(state.range(1)), depth);
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        const auto encoded = encode_deltas(deltas);
+        apply_deltas(octree, decode_deltas(encoded));
+        bytes = encoded.size();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+    state.counters["bytes"] = static_cast<double>(bytes);
+}
+BENCHMARK(OctreeDeltaApply)->Args({6, 1})->Args({6, 256});
+
+void OctreeDeltaCompact(benchmark::State &state) {
+    // A log of edits which revisit the same cubes.
+    const auto deltas = random_deltas(static_cast<std::size_t>(state.range(0)), 2);
+    std::size_t compacted = 0;
+    for (auto _ : state) {
+        compacted = compact_deltas(deltas).size();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["compacted"] = static_cast<double>(compacted);
+}
+BENCHMARK(OctreeDeltaCompact)->Arg(4096);
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,38 @@
+#include "inexor/vulkan-renderer/world/octree_generator.hpp"
+#include "inexor/vulkan-renderer/world/octree_pool.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+GeneratorSettings settings(const benchmark::State &state) {
+    GeneratorSettings settings;
+    settings.depth = static_cast<std::uint32_t>(state.range(0));
+    settings.coherence = static_cast<float>(state.range(1)) / 100.0f;
+    return settings;
+}
+} // namespace
+
+void GenerateOctreeData(benchmark::State &state) {
+    std::vector<unsigned char> data;
+    for (auto _ : state) {
+        data = generate_octree_data(settings(state));
+        benchmark::DoNotOptimize(data);
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+// Arguments: depth, coherence in percent.
+BENCHMARK(GenerateOctreeData)->Args({6, 0})->Args({8, 0})->Args({9, 30})->Unit(benchmark::kMillisecond);
+
+void OctreePoolParseGenerated(benchmark::State &state) {
+    auto data = generate_octree_data(settings(state));
+    OctreePool pool;
+    for (auto _ : state) {
+        pool = OctreePool::parse(data);
+        benchmark::DoNotOptimize(pool);
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+    state.counters["octree_nodes"] = static_cast<double>(pool.statistics().octree_nodes);
+}
+BENCHMARK(OctreePoolParseGenerated)->Args({8, 0})->Args({9, 30})->Unit(benchmark::kMillisecond);
+} // namespace inexor::vulkan_renderer::world
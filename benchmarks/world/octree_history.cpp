@@ -0,0 +1,44 @@
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/octree_history.hpp"
+#include "random_octree.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+namespace inexor::vulkan_renderer::world {
+void OctreeHistoryAssign(benchmark::State &state) {
+    const auto depth = static_cast<std::uint32_t>(state.range(0));
+    auto data = random_octree(depth);
+    Cube octree = Cube::parse(data);
+    OctreeHistory history(octree, static_cast<std::size_t>(state.range(1)));
+    std::mt19937 generator(0);
+    std::vector<std::size_t> path(depth);
+    for (auto _ : state) {
+        // Replace a random leaf, the size and position are taken from the leaf of the current version.
+        Cube *leaf = history.snapshot().get();
+        for (auto &octant : path) {
+            octant = generator() % 8;
+            leaf = leaf->octants.value()[octant].get();
+        }
+        Cube full(CubeType::FULL, leaf->size(), leaf->position());
+        history.assign(path, full);
+    }
+    state.SetItemsProcessed(state.iterations());
+    // Each version keeps the copies of the cubes on the path.
+    state.counters["cubes_per_version"] = depth + 1;
+}
+BENCHMARK(OctreeHistoryAssign)->Args({4, 256})->Args({6, 256});
+
+void CubeDeepCopy(benchmark::State &state) {
+    // What a snapshot would cost without structural sharing.
+    auto data = random_octree(state.range(0));
+    Cube octree = Cube::parse(data);
+    for (auto _ : state) {
+        OctreeHistory history(octree);
+        benchmark::DoNotOptimize(history.snapshot());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(CubeDeepCopy)->Arg(5);
+} // namespace inexor::vulkan_renderer::world
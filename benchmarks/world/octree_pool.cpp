@@ -0,0 +1,100 @@
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/octree_pool.hpp"
+#include "random_octree.hpp"
+#include "terrain_octree.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace inexor::vulkan_renderer::world {
+void CubeParse(benchmark::State &state) {
+    auto data = random_octree(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Cube::parse(data));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+    // Lower bound, shared_ptr control blocks are not counted.
+    state.counters["bytes_per_node"] = sizeof(Cube);
+}
+BENCHMARK(CubeParse)->Arg(3)->Arg(5);
+
+void OctreePoolParse(benchmark::State &state) {
+    auto data = random_octree(state.range(0));
+    OctreePool pool;
+    for (auto _ : state) {
+        pool = OctreePool::parse(data);
+        benchmark::DoNotOptimize(pool);
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+    pool.shrink_to_fit();
+    state.counters["bytes_per_node"] = static_cast<double>(pool.memory_usage()) / pool.node_count();
+}
+BENCHMARK(OctreePoolParse)->Arg(3)->Arg(5);
+
+void OctreePoolParseShared(benchmark::State &state) {
+    const auto depth = static_cast<std::uint32_t>(state.range(0));
+    auto data = state.range(1) == 0 ? terrain_octree(depth) : random_octree(depth);
+    OctreePool pool;
+    for (auto _ : state) {
+        pool = OctreePool::parse(data, true);
+        benchmark::DoNotOptimize(pool);
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+    pool.shrink_to_fit();
+    state.counters["bytes_per_node"] = static_cast<double>(pool.memory_usage()) / pool.node_count();
+    state.counters["dedup_ratio"] = pool.statistics().ratio();
+}
+// Terrain at depth 6 and 8, random octree at depth 5.
+BENCHMARK(OctreePoolParseShared)->Args({6, 0})->Args({8, 0})->Args({5, 1});
+
+void CubePolygons(benchmark::State &state) {
+    auto data = random_octree(state.range(0));
+    Cube cube = Cube::parse(data);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cube.polygons());
+    }
+    state.counters["leaves"] = static_cast<double>(cube.leaves());
+}
+BENCHMARK(CubePolygons)->Arg(3)->Arg(5);
+
+void OctreePoolPolygons(benchmark::State &state) {
+    auto data = random_octree(state.range(0));
+    const OctreePool pool = OctreePool::parse(data);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pool.root().polygons());
+    }
+    state.counters["leaves"] = static_cast<double>(pool.root().leaves());
+}
+BENCHMARK(OctreePoolPolygons)->Arg(3)->Arg(5);
+
+void OctreePoolPolygonsBuffer(benchmark::State &state) {
+    auto data = random_octree(state.range(0));
+    const OctreePool pool = OctreePool::parse(data);
+    std::vector<std::array<glm::vec3, 3>> polygons;
+    for (auto _ : state) {
+        // The buffer keeps its capacity, so no memory is allocated after the first iteration.
+        polygons.clear();
+        pool.root().polygons(polygons);
+        benchmark::DoNotOptimize(polygons.data());
+    }
+    state.counters["leaves"] = static_cast<double>(pool.root().leaves());
+}
+BENCHMARK(OctreePoolPolygonsBuffer)->Arg(3)->Arg(5);
+
+void CubeLeaves(benchmark::State &state) {
+    auto data = random_octree(state.range(0));
+    Cube cube = Cube::parse(data);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cube.leaves());
+    }
+}
+BENCHMARK(CubeLeaves)->Arg(3)->Arg(5);
+
+void OctreePoolLeaves(benchmark::State &state) {
+    auto data = random_octree(state.range(0));
+    const OctreePool pool = OctreePool::parse(data);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pool.root().leaves());
+    }
+}
+BENCHMARK(OctreePoolLeaves)->Arg(3)->Arg(5);
+} // namespace inexor::vulkan_renderer::world
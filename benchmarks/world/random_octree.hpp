@@ -0,0 +1,17 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/world/octree_generator.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace inexor::vulkan_renderer::world {
+/// Generate the data of a random octree with the default settings.
+/// @param depth The depth of the octree.
+/// @return The binary data of the octree.
+inline std::vector<unsigned char> random_octree(std::int64_t depth) {
+    GeneratorSettings settings;
+    settings.depth = static_cast<std::uint32_t>(depth);
+    return generate_octree_data(settings);
+}
+} // namespace inexor::vulkan_renderer::world
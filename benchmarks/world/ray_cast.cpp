@@ -0,0 +1,61 @@
+#include "inexor/vulkan-renderer/thread_pool.hpp"
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/ray_cast.hpp"
+#include "random_octree.hpp"
+#include "terrain_octree.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// Create rays which look down onto the octree from random points above it.
+std::vector<Ray> random_rays(std::size_t count) {
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<Ray> rays(count);
+    for (auto &ray : rays) {
+        ray.origin = {distribution(generator), 1.5f, distribution(generator)};
+        ray.direction = {distribution(generator) - 0.5f, -1.0f, distribution(generator) - 0.5f};
+    }
+    return rays;
+}
+} // namespace
+
+void RayCastTerrain(benchmark::State &state) {
+    auto data = terrain_octree(static_cast<std::uint32_t>(state.range(0)));
+    Cube cube = Cube::parse(data);
+    const auto rays = random_rays(1024);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ray_cast(cube, rays[i++ % rays.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(RayCastTerrain)->Arg(5)->Arg(8);
+
+void RayCastRandom(benchmark::State &state) {
+    auto data = random_octree(state.range(0));
+    Cube cube = Cube::parse(data);
+    const auto rays = random_rays(1024);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ray_cast(cube, rays[i++ % rays.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(RayCastRandom)->Arg(5);
+
+void RayCastBatched(benchmark::State &state) {
+    auto data = terrain_octree(8);
+    Cube cube = Cube::parse(data);
+    const auto rays = random_rays(static_cast<std::size_t>(state.range(0)));
+    ThreadPool thread_pool;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ray_cast(cube, rays, thread_pool));
+    }
+    state.SetItemsProcessed(state.iterations() * rays.size());
+}
+BENCHMARK(RayCastBatched)->Arg(4096)->Arg(65536)->UseRealTime();
+} // namespace inexor::vulkan_renderer::world
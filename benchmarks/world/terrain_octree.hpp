@@ -0,0 +1,55 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/world/bit_stream_writer.hpp"
+#include "inexor/vulkan-renderer/world/cube.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace inexor::vulkan_renderer::world {
+/// Write a terrain like octree, which is full below a height field and empty above it.
+/// Cubes which are completely below or above the height field are not subdivided further.
+/// @param writer The writer to write the octree to.
+/// @param depth The number of levels to subdivide at most.
+/// @param size The size of the cube.
+/// @param position The position of the cube.
+inline void write_terrain_octree(BitStreamWriter &writer, std::uint32_t depth, float size, const glm::vec3 &position) {
+    const auto height = [](float x, float z) { return 0.5f + 0.2f * std::sin(x * 6.0f) * std::cos(z * 4.0f); };
+    float min = height(position.x, position.z);
+    float max = min;
+    // Sample the height field on the grid of the deepest level below this cube.
+    const std::uint32_t samples = 1u << depth;
+    for (std::uint32_t i = 0; i <= samples; i++) {
+        for (std::uint32_t j = 0; j <= samples; j++) {
+            const float h = height(position.x + size * i / samples, position.z + size * j / samples);
+            min = std::min(min, h);
+            max = std::max(max, h);
+        }
+    }
+    if (position.y + size <= min) {
+        writer.put(static_cast<std::uint8_t>(CubeType::FULL), 2);
+        return;
+    }
+    if (position.y >= max || depth == 0) {
+        writer.put(static_cast<std::uint8_t>(position.y + size / 2 < min ? CubeType::FULL : CubeType::EMPTY), 2);
+        return;
+    }
+    writer.put(static_cast<std::uint8_t>(CubeType::OCTANT), 2);
+    const float half = size / 2;
+    for (std::uint32_t i = 0; i < 8; i++) {
+        write_terrain_octree(writer, depth - 1, half,
+                             {position.x + ((i & 4) ? half : 0.0f), position.y + ((i & 2) ? half : 0.0f),
+                              position.z + ((i & 1) ? half : 0.0f)});
+    }
+}
+
+/// Create the binary data of a terrain like octree which is subdivided down to depth levels at the surface.
+/// @param depth The number of levels to subdivide at most.
+/// @return The binary data of the octree.
+inline std::vector<unsigned char> terrain_octree(std::uint32_t depth) {
+    BitStreamWriter writer;
+    write_terrain_octree(writer, depth, DEFAULT_CUBE_SIZE, DEFAULT_CUBE_POSITION);
+    return writer.finish();
+}
+} // namespace inexor::vulkan_renderer::world
@@ -1,12 +1,17 @@
 ﻿#pragma once
 
+#include "inexor/vulkan-renderer/octree_vertex.hpp"
 #include "inexor/vulkan-renderer/renderer.hpp"
 #include "inexor/vulkan-renderer/thread_pool.hpp"
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/incremental_mesh.hpp"
+#include "inexor/vulkan-renderer/world/quantization.hpp"
 
 #include <GLFW/glfw3.h>
 #include <vulkan/vulkan_core.h>
 
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -36,6 +41,29 @@ private:
 
     std::size_t current_frame = 0;
 
+    /// The octree of the map.
+    std::shared_ptr<world::Cube> octree;
+
+    /// The polygons of the octree, which are kept in sync with the vertex buffer of the octree.
+    std::unique_ptr<world::IncrementalMesh> octree_mesh;
+
+    /// The quantization of the vertex positions of the octree mesh.
+    world::PositionQuantization octree_quantization;
+
+    /// The matrix which transforms the octree into clip space, as of the last update of the uniform buffers.
+    glm::mat4 octree_clip_matrix = glm::mat4(1.0f);
+
+    /// The vertices and indices of a slot of the octree mesh, which replace the slot in the mesh buffer.
+    struct OctreeSlotUpdate {
+        std::vector<OctreeVertex> vertices;
+
+        /// The indices in the index type of the mesh buffer.
+        std::vector<std::uint8_t> indices;
+    };
+
+    /// The slots of the octree mesh which changed and have not been staged for a frame yet, by the index of the slot.
+    std::map<std::size_t, OctreeSlotUpdate> pending_octree_slots;
+
     // TODO: Refactor into a manger class.
     struct ShaderSetup {
         VkShaderStageFlagBits shader_type;
@@ -66,6 +94,26 @@ private:
 
     VkResult load_octree_geometry();
 
+    /// @brief Create the mesh buffer of the whole octree mesh, replaces all mesh buffers.
+    void create_octree_mesh_buffer();
+
+    /// @brief Convert the vertices of an indexed octree mesh with normals and materials to packed octree vertices.
+    /// @param mesh [in] The indexed mesh.
+    std::vector<OctreeVertex> generate_octree_vertices(const world::IndexedMesh &mesh);
+
+    /// @brief Select the level of detail of the octree from the camera position, remesh the parts of the octree which
+    /// changed and queue them for the next frame.
+    VkResult update_octree_geometry();
+
+    /// @brief Write the changed slots of the octree mesh into the staging buffer of a frame in flight and queue their
+    /// copies into the mesh buffer, which are recorded into the command buffer of the frame.
+    /// @param frame [in] The index of the frame in flight, whose fence must be signalled.
+    void stage_octree_mesh_updates(std::size_t frame);
+
+    /// @brief Cull the octree against the view frustum and record the command buffer which draws the visible parts.
+    /// @param image_index [in] The index of the swapchain image, which must not be in use.
+    VkResult update_octree_visibility(std::size_t image_index);
+
     VkResult check_application_specific_features();
 
     VkResult render_frame();
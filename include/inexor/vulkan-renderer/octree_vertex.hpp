@@ -3,15 +3,28 @@
 #include <glm/glm.hpp>
 #include <vulkan/vulkan_core.h>
 
+#include <array>
+#include <cstdint>
 #include <vector>
 
 namespace inexor::vulkan_renderer {
 
+/// The number of colors in the palette of the vertex shader.
+constexpr std::uint16_t OCTREE_PALETTE_SIZE = 16;
+
 // TODO: Generalize this setup using a builder pattern!
+/// A packed vertex of the octree mesh (12 bytes), which is decoded by the vertex shader.
+/// Positions are relative to the chunk (see world::PositionQuantization), the origin and step of the quantization are
+/// passed in UniformBufferObject::dequantization. Texture coordinates are projected from the position in the shader.
 struct OctreeVertex {
-    glm::vec3 pos;
-    glm::vec3 color;
-    glm::vec2 texture_coordinate;
+    /// The quantized position.
+    std::array<std::uint16_t, 3> position;
+
+    /// The index of the color in the palette of the vertex shader.
+    std::uint16_t palette_index;
+
+    /// The octahedral encoded normal (see world::encode_normal).
+    std::array<std::int16_t, 2> normal;
 
     [[nodiscard]] static VkVertexInputBindingDescription get_vertex_binding_description();
 
@@ -21,4 +34,6 @@ struct OctreeVertex {
     [[nodiscard]] static std::vector<VkVertexInputAttributeDescription> get_attribute_binding_description();
 };
 
+static_assert(sizeof(OctreeVertex) == 12);
+
 } // namespace inexor::vulkan_renderer
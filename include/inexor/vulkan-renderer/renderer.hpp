@@ -7,6 +7,7 @@
 #include "inexor/vulkan-renderer/msaa_target.hpp"
 #include "inexor/vulkan-renderer/settings_decision_maker.hpp"
 #include "inexor/vulkan-renderer/time_step.hpp"
+#include "inexor/vulkan-renderer/world/incremental_mesh.hpp"
 
 // Those components have been refactored to fulfill RAII idioms.
 #include "inexor/vulkan-renderer/wrapper/command_buffer.hpp"
@@ -16,6 +17,7 @@
 #include "inexor/vulkan-renderer/wrapper/fence.hpp"
 #include "inexor/vulkan-renderer/wrapper/framebuffer.hpp"
 #include "inexor/vulkan-renderer/wrapper/glfw_context.hpp"
+#include "inexor/vulkan-renderer/wrapper/gpu_memory_buffer.hpp"
 #include "inexor/vulkan-renderer/wrapper/graphics_pipeline.hpp"
 #include "inexor/vulkan-renderer/wrapper/image.hpp"
 #include "inexor/vulkan-renderer/wrapper/instance.hpp"
@@ -72,6 +74,9 @@ protected:
 
     std::vector<wrapper::Fence> in_flight_fences;
 
+    /// The fence of the frame which uses each swapchain image, nullptr if the image has not been used yet.
+    std::vector<wrapper::Fence *> images_in_flight;
+
     VkDebugReportCallbackEXT debug_report_callback = {};
 
     bool debug_report_callback_initialised = false;
@@ -108,6 +113,23 @@ protected:
     std::vector<wrapper::Texture> textures;
     std::vector<wrapper::UniformBuffer> uniform_buffers;
     std::vector<wrapper::MeshBuffer> mesh_buffers;
+
+    /// The ranges of polygons of the first mesh buffer which are drawn, all of them if std::nullopt.
+    std::optional<std::vector<world::IncrementalMesh::Range>> visible_polygons;
+
+    /// The staging buffer of each frame in flight, which holds the changed parts of the first mesh buffer until the
+    /// command buffer of that frame copies them. It is only written after the fence of its frame has been signalled.
+    std::vector<std::unique_ptr<wrapper::GPUMemoryBuffer>> mesh_staging_buffers;
+
+    /// The staging buffer which the copies into the first mesh buffer read from.
+    VkBuffer mesh_staging_buffer = VK_NULL_HANDLE;
+
+    /// The copies into the vertex buffer of the first mesh buffer, recorded at the start of the next command buffer.
+    std::vector<VkBufferCopy> vertex_buffer_copies;
+
+    /// The copies into the index buffer of the first mesh buffer, recorded at the start of the next command buffer.
+    std::vector<VkBufferCopy> index_buffer_copies;
+
     std::vector<wrapper::Descriptor> descriptors;
 
     // TODO(Hanni): Remove this with RAII refactoring of descriptors!
@@ -164,6 +186,16 @@ protected:
     /// @brief Records the command buffers.
     VkResult record_command_buffers();
 
+    /// @brief Records the command buffer of one swapchain image, the image must not be in use.
+    /// @param image_index [in] The index of the swapchain image.
+    VkResult record_command_buffer(std::size_t image_index);
+
+    /// @brief Get the staging buffer of a frame in flight for the copies into the first mesh buffer.
+    /// @param frame [in] The index of the frame in flight, whose fence must be signalled.
+    /// @param size [in] The number of bytes to stage, the staging buffer is grown if it is too small.
+    /// @return The mapped memory of the staging buffer.
+    std::uint8_t *map_mesh_staging_buffer(std::size_t frame, VkDeviceSize size);
+
     /// @brief Creates the semaphores neccesary for synchronisation.
     VkResult create_synchronisation_objects();
 
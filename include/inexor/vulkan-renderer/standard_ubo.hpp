@@ -11,6 +11,8 @@ struct UniformBufferObject {
     glm::mat4 model;
     glm::mat4 view;
     glm::mat4 proj;
+    /// The origin (xyz) and step (w) of the quantized vertex positions, see world::PositionQuantization.
+    glm::vec4 dequantization;
 };
 
 } // namespace inexor::vulkan_renderer
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace inexor::vulkan_renderer::tools {
+
+/// @brief A class for mapping files read-only into memory.
+/// In contrast to File, no data is read up front: the operating system loads pages on first access and may drop them
+/// again under memory pressure.
+class MappedFile {
+private:
+    /// The mapped file data.
+    const unsigned char *file_data = nullptr;
+
+    /// The size of the file.
+    std::size_t file_size = 0;
+
+#ifdef _WIN32
+    /// The handle of the opened file.
+    void *file_handle = nullptr;
+
+    /// The handle of the file mapping.
+    void *mapping_handle = nullptr;
+#endif
+
+    /// @brief Unmaps the file if one is mapped.
+    void unmap();
+
+public:
+    MappedFile() = default;
+
+    // Delete the copy constructor so mapped files are move-only objects.
+    MappedFile(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+
+    // Delete the copy assignment operator so mapped files are move-only objects.
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    ~MappedFile();
+
+    /// @brief Returns the size of the file.
+    [[nodiscard]] std::size_t get_file_size() const;
+
+    /// @brief Returns the file's data, which stays valid until the file is unmapped.
+    [[nodiscard]] const unsigned char *get_file_data() const;
+
+    /// @brief Maps the entire file into memory.
+    /// @param file_name The name of the file.
+    /// @return True if file was mapped successfully, false otherwise.
+    [[nodiscard]] bool map_file(const std::string &file_name);
+};
+
+} // namespace inexor::vulkan_renderer::tools
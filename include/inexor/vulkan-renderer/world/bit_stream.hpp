@@ -1,52 +1,105 @@
 #pragma once
 
 #include <boost/dynamic_bitset.hpp>
+#include <glm/vec3.hpp>
 
 #include <array>
+#include <cassert>
 #include <cstdint>
 #include <optional>
 
 namespace inexor::vulkan_renderer::world {
-constexpr std::array<std::uint8_t, 9> KEEP_FIRST_N_BITS{0b0000'0000, 0b1000'0000, 0b1100'0000, 0b1110'0000, 0b1111'0000,
-                                                        0b1111'1000, 0b1111'1100, 0b1111'1110, 0b1111'1111};
-
-constexpr std::array<std::uint8_t, 9> DISCARD_FIRST_N_BITS{0b1111'1111, 0b0111'1111, 0b0011'1111,
-                                                           0b0001'1111, 0b0000'1111, 0b0000'0111,
-                                                           0b0000'0011, 0b0000'0001, 0b0000'0000};
-
 /// Create a BitStream
 /// Extract a certain number of bits from binary data e.g. for binary file parsing.
+/// The bits are read from the most significant to the least significant bit of each byte.
+/// Up to 64 bits are buffered in a register, which is refilled one word at a time.
 class BitStream {
 private:
-    /// Pointer to the current data.
-    unsigned char *data{};
-
-    /// Offset in the current byte from the start of the byte.
-    std::uint8_t offset{};
+    /// Pointer to the next byte which has not been loaded into the buffer yet.
+    const unsigned char *data{};
 
-    /// Number of bytes left in the stream.
+    /// Number of bytes which have not been loaded into the buffer yet.
     std::size_t bytes_left{};
 
+    /// The buffered bits, left aligned (the next bit of the stream is the most significant bit).
+    std::uint64_t buffer{};
+
+    /// Number of valid bits in the buffer.
+    std::uint8_t bits_in_buffer{};
+
+    /// Load as many complete bytes as possible into the buffer, guarantees at least MAX_BITS buffered bits if the
+    /// stream is long enough.
+    void refill();
+
 public:
+    /// The maximum number of bits which can be read with a single call.
+    static constexpr std::uint8_t MAX_BITS = 57;
+
     /// The data to create bitstream from.
     /// @param data
     /// @param byte_size
-    explicit BitStream(unsigned char *data, std::size_t byte_size);
+    explicit BitStream(const unsigned char *data, std::size_t byte_size);
+
+    /// Create a bitstream which starts at a bit offset of the data.
+    /// @param data The data to create bitstream from.
+    /// @param byte_size The size of the data in bytes.
+    /// @param bit_offset The number of bits to skip at the start of the data.
+    BitStream(const unsigned char *data, std::size_t byte_size, std::size_t bit_offset);
 
     BitStream();
 
+    /// Get the number of bits which are left in the stream.
+    /// @return number of bits left.
+    [[nodiscard]] std::size_t bits_left() const;
+
+    /// Get size bits from the stream without removing them.
+    /// Defined in the header as it is called for every value of an octree.
+    /// @param size Bits to get (0 < size <= MAX_BITS).
+    /// @return <size> next bits of the stream, std::nullopt if the stream is too short.
+    std::optional<std::uint64_t> peek(std::uint8_t size) {
+        assert(size && size <= MAX_BITS);
+        if (this->bits_in_buffer < size) {
+            this->refill();
+            if (this->bits_in_buffer < size) {
+                return std::nullopt;
+            }
+        }
+        return this->buffer >> (64 - size);
+    }
+
+    /// Remove size bits from the stream.
+    /// @param size Bits to skip (0 < size <= MAX_BITS).
+    /// @return Whether the stream was long enough, nothing is skipped otherwise.
+    bool skip(std::uint8_t size) {
+        if (!this->peek(size)) {
+            return false;
+        }
+        this->buffer <<= size;
+        this->bits_in_buffer -= size;
+        return true;
+    }
+
     /// Get size bits from the stream.
-    /// As octree file format only requires up to one-byte values, the function is restricted to that size (for easier
-    /// implementation).
-    /// @param size Bits to get (<9).
-    /// @return <size> next bits of the stream.
-    std::optional<std::uint8_t> get(std::uint8_t size);
+    /// @param size Bits to get (0 < size <= MAX_BITS).
+    /// @return <size> next bits of the stream, std::nullopt if the stream is too short.
+    std::optional<std::uint64_t> get(std::uint8_t size) {
+        const std::optional<std::uint64_t> bits = this->peek(size);
+        if (bits) {
+            this->buffer <<= size;
+            this->bits_in_buffer -= size;
+        }
+        return bits;
+    }
 
     /// Get size bits from the stream.
-    /// As octree file format only requires up to one-byte values, the function is restricted to that size (for easier
-    /// implementation).
-    /// @param size Bits to get (<9).
-    /// @return <size> next bits of the stream.
+    /// @param size Bits to get (0 < size <= MAX_BITS).
+    /// @return <size> next bits of the stream, std::nullopt if the stream is too short.
     std::optional<boost::dynamic_bitset<>> get_bitset(std::uint8_t size);
+
+    /// Get the indentation levels of all 8 corners of an indented cube at once.
+    /// Each level is stored as one bit whether the axis is indented, followed by three bits of the level - 1 if so.
+    /// @return The indentation levels of each corner, std::nullopt if the stream ended before (the stream is left at
+    /// an unspecified position in that case).
+    std::optional<std::array<glm::tvec3<std::uint8_t>, 8>> get_indentations();
 };
 } // namespace inexor::vulkan_renderer::world
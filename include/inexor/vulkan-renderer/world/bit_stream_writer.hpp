@@ -0,0 +1,68 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace inexor::vulkan_renderer::world {
+/// Write binary data bit by bit, the counterpart of BitStream.
+/// The bits are written from the most significant to the least significant bit of each byte.
+/// Up to 64 bits are collected in a register, which is flushed one word at a time.
+class BitStreamWriter {
+private:
+    /// The written data, may contain up to 8 bytes of scratch space behind bytes_written.
+    std::vector<unsigned char> data;
+
+    /// Number of completely written bytes in data.
+    std::size_t bytes_written{};
+
+    /// The collected bits, left aligned (the next written bit goes behind the last valid bit).
+    std::uint64_t buffer{};
+
+    /// Number of valid bits in the buffer.
+    std::uint8_t bits_in_buffer{};
+
+    /// Write all complete bytes of the buffer to the data.
+    void flush();
+
+public:
+    /// The maximum number of bits which can be written with a single call.
+    static constexpr std::uint8_t MAX_BITS = 57;
+
+    BitStreamWriter();
+
+    /// Create a BitStreamWriter.
+    /// @param byte_capacity The number of bytes to reserve.
+    explicit BitStreamWriter(std::size_t byte_capacity);
+
+    /// Get the number of bits which have been written.
+    /// @return number of written bits.
+    [[nodiscard]] std::size_t bits_written() const;
+
+    /// Write the lowest size bits of value.
+    /// Defined in the header as it is called for every value of an octree.
+    /// @param value The value to write, must fit into size bits.
+    /// @param size Bits to write (0 < size <= MAX_BITS).
+    void put(std::uint64_t value, std::uint8_t size) {
+        assert(size && size <= MAX_BITS);
+        assert(value >> size == 0);
+        if (this->bits_in_buffer + size > 64) {
+            this->flush();
+        }
+        this->buffer |= value << (64 - this->bits_in_buffer - size);
+        this->bits_in_buffer += size;
+    }
+
+    /// Write the indentation levels of all 8 corners of an indented cube, counterpart of BitStream::get_indentations.
+    /// @param levels The indentation levels of each corner.
+    void put_indentations(const std::array<glm::tvec3<std::uint8_t>, 8> &levels);
+
+    /// Pad the last byte with zero bits and return the written data.
+    /// The writer is empty afterwards.
+    /// @return The written data.
+    std::vector<unsigned char> finish();
+};
+} // namespace inexor::vulkan_renderer::world
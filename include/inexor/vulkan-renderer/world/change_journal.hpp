@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace inexor::vulkan_renderer::world {
+class Cube;
+
+/// Collects the cubes of an octree which changed, so that subscribers process all changes of a frame at once instead
+/// of being notified of every single edit.
+///
+/// A cube is recorded only once per batch, it remembers in a dirty bit that it is in the journal already. Subscribers
+/// receive the batch when the journal is flushed, which should happen once per frame. A cube which is destroyed while
+/// it is recorded is removed from the batch.
+///
+/// The journal is not thread safe, the octree must not be edited from several threads at once.
+class ChangeJournal {
+public:
+    /// A subscriber receives the cubes which changed since the last flush, each of them once, in the order of their
+    /// first change.
+    using Subscriber = std::function<void(const std::vector<Cube *> &)>;
+
+private:
+    /// The cubes which changed since the last flush.
+    std::vector<Cube *> changes;
+
+    /// The subscribers with their ids.
+    std::vector<std::pair<std::size_t, Subscriber>> subscribers;
+
+    /// The id of the next subscriber.
+    std::size_t next_id = 0;
+
+public:
+    ChangeJournal() = default;
+
+    ChangeJournal(const ChangeJournal &) = delete;
+    ChangeJournal &operator=(const ChangeJournal &) = delete;
+
+    /// Record a cube which changed, called by the cube itself unless it is recorded already.
+    /// @param cube The cube.
+    void record(Cube *cube);
+
+    /// Remove a cube from the batch, called by a recorded cube which is destroyed.
+    /// @param cube The cube.
+    void forget(const Cube *cube);
+
+    /// Add a subscriber.
+    /// @param subscriber The subscriber.
+    /// @return The id of the subscriber.
+    std::size_t subscribe(Subscriber subscriber);
+
+    /// Remove a subscriber.
+    /// @param id The id of the subscriber.
+    void unsubscribe(std::size_t id);
+
+    /// Pass the cubes which changed since the last flush to all subscribers and start a new batch.
+    /// Changes made by the subscribers are recorded into the new batch.
+    void flush();
+
+    /// Get the cubes which changed since the last flush.
+    /// @return The cubes in the order of their first change.
+    [[nodiscard]] const std::vector<Cube *> &pending() const;
+
+    /// Get whether any cube changed since the last flush.
+    /// @return Whether the batch is empty.
+    [[nodiscard]] bool empty() const;
+};
+} // namespace inexor::vulkan_renderer::world
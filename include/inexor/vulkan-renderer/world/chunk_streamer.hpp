@@ -0,0 +1,174 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/thread_pool.hpp"
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/mesher.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace inexor::vulkan_renderer::world {
+/// Options of the ChunkStreamer.
+struct StreamingOptions {
+    /// The size of a chunk, the chunk (x, y, z) is the cube at (x, y, z) * chunk_size.
+    float chunk_size = DEFAULT_CUBE_SIZE;
+
+    /// Chunks whose center is within this distance of the camera are loaded.
+    float load_radius = 4.0f;
+
+    /// The time in seconds the camera movement is prefetched ahead, chunks within the load radius of the path of the
+    /// camera until then are loaded as well.
+    float prefetch_time = 1.0f;
+
+    /// The memory usage of the loaded chunks in bytes above which the least recently used chunks are evicted.
+    std::size_t memory_budget = std::size_t(256) << 20;
+
+    /// The maximum number of chunks which are loaded at the same time.
+    std::size_t max_pending = 8;
+
+    /// The options of the mesher.
+    MeshOptions mesh_options;
+};
+
+/// Get the binary data of the octree of a chunk by its grid coordinate, called on the worker threads.
+using ChunkLoader = std::function<std::vector<unsigned char>(const glm::ivec3 &coordinate)>;
+
+/// A chunk of the world, which is not changed after it has been loaded.
+struct Chunk {
+    /// The coordinate of the chunk in the grid.
+    glm::ivec3 coordinate;
+
+    /// The octree of the chunk.
+    std::shared_ptr<Cube> octree;
+
+    /// The polygons of the octree with the attributes of their faces, ready to be uploaded.
+    std::vector<std::array<MeshVertex, 3>> mesh;
+
+    /// The memory used by the octree and the mesh in bytes (an estimate for the octree).
+    std::size_t memory_usage;
+};
+
+/// Streams the chunks of a world which is a grid of octrees around the camera.
+///
+/// Chunks are loaded, parsed and meshed on the thread pool, ChunkStreamer::update only collects the chunks which have
+/// been loaded and schedules new ones, so it never waits for a chunk. The chunks within the load radius of the path
+/// the camera takes during the prefetch time are requested, the closest to the camera first. When the loaded chunks
+/// use more memory than the budget, the chunks which have not been requested for the longest time are evicted, chunks
+/// which are requested by the current update are kept even above the budget.
+///
+/// Uploading the meshes is left to the caller, which gets the loaded and evicted chunks of every update. Not thread
+/// safe, update is meant to be called once per frame.
+///
+/// A chunk whose loader or data throws is reported as failed by the update which collects it. It is not requested
+/// again until it has left the requested chunks, so it is retried when the camera returns instead of every frame.
+class ChunkStreamer {
+public:
+    /// A chunk which could not be loaded.
+    struct Failure {
+        /// The coordinate of the chunk.
+        glm::ivec3 coordinate;
+
+        /// The message of the exception which was thrown while loading the chunk.
+        std::string error;
+    };
+
+    /// The result of an update.
+    struct Update {
+        /// The chunks which have been loaded since the last update.
+        std::vector<std::shared_ptr<const Chunk>> loaded;
+
+        /// The coordinates of the chunks which have been evicted.
+        std::vector<glm::ivec3> evicted;
+
+        /// The chunks which failed to load since the last update.
+        std::vector<Failure> failed;
+    };
+
+private:
+    struct CoordinateHash {
+        std::size_t operator()(const glm::ivec3 &coordinate) const;
+    };
+
+    /// A loaded chunk with the last update which requested it.
+    struct Entry {
+        std::shared_ptr<const Chunk> chunk;
+        std::uint64_t last_used;
+    };
+
+    ThreadPool &thread_pool;
+    ChunkLoader loader;
+    StreamingOptions options;
+
+    /// The loaded chunks.
+    std::unordered_map<glm::ivec3, Entry, CoordinateHash> chunks;
+
+    /// The chunks which are being loaded.
+    std::unordered_map<glm::ivec3, std::future<std::shared_ptr<const Chunk>>, CoordinateHash> pending;
+
+    /// The chunks which failed to load with the last update which requested them.
+    std::unordered_map<glm::ivec3, std::uint64_t, CoordinateHash> failed;
+
+    /// The memory used by the loaded chunks in bytes.
+    std::size_t used_memory = 0;
+
+    /// The number of updates.
+    std::uint64_t updates = 0;
+
+    /// Get the coordinates of the chunks within the load radius of the path of the camera, the closest first.
+    /// @param camera_position The position of the camera.
+    /// @param camera_velocity The velocity of the camera in units per second.
+    /// @return The coordinates of the chunks.
+    [[nodiscard]] std::vector<glm::ivec3> requested_chunks(const glm::vec3 &camera_position,
+                                                           const glm::vec3 &camera_velocity) const;
+
+    /// Evict the least recently used chunks until the memory usage is within the budget.
+    /// @param evicted The vector to append the coordinates of the evicted chunks to.
+    void evict(std::vector<glm::ivec3> &evicted);
+
+public:
+    /// Create a chunk streamer, no chunks are loaded until the first update.
+    /// @param thread_pool The thread pool to load the chunks on, which has to outlive the chunk streamer.
+    /// @param loader Gives the binary data of the octree of a chunk.
+    /// @param options The options of the chunk streamer.
+    ChunkStreamer(ThreadPool &thread_pool, ChunkLoader loader, StreamingOptions options = {});
+
+    ChunkStreamer(const ChunkStreamer &) = delete;
+    ChunkStreamer &operator=(const ChunkStreamer &) = delete;
+
+    /// Waits for the chunks which are being loaded.
+    ~ChunkStreamer();
+
+    /// Collect the chunks which have been loaded, request the chunks around the camera and evict chunks if the memory
+    /// budget is exceeded.
+    /// @param camera_position The position of the camera.
+    /// @param camera_velocity The velocity of the camera in units per second.
+    /// @return The chunks which have been loaded, evicted or failed to load.
+    Update update(const glm::vec3 &camera_position, const glm::vec3 &camera_velocity);
+
+    /// Get a loaded chunk.
+    /// @param coordinate The coordinate of the chunk.
+    /// @return The chunk, nullptr if it is not loaded.
+    [[nodiscard]] std::shared_ptr<const Chunk> chunk(const glm::ivec3 &coordinate) const;
+
+    /// Get the number of loaded chunks.
+    /// @return The number of chunks.
+    [[nodiscard]] std::size_t loaded_count() const;
+
+    /// Get the number of chunks which are being loaded.
+    /// @return The number of chunks.
+    [[nodiscard]] std::size_t pending_count() const;
+
+    /// Get the memory used by the loaded chunks.
+    /// @return The memory usage in bytes.
+    [[nodiscard]] std::size_t memory_usage() const;
+};
+} // namespace inexor::vulkan_renderer::world
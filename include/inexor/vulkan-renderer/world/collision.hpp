@@ -0,0 +1,112 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/world/cube.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace inexor {
+class ThreadPool;
+} // namespace inexor
+
+namespace inexor::vulkan_renderer::world {
+/// A sphere.
+struct Sphere {
+    /// The center of the sphere.
+    glm::vec3 center;
+
+    /// The radius of the sphere.
+    float radius;
+};
+
+/// An axis aligned box.
+struct Box {
+    /// The corner of the box with the lowest coordinates.
+    glm::vec3 min;
+
+    /// The corner of the box with the highest coordinates.
+    glm::vec3 max;
+};
+
+/// A capsule: all points within a radius around a line segment.
+struct Capsule {
+    /// The start of the line segment.
+    glm::vec3 start;
+
+    /// The end of the line segment.
+    glm::vec3 end;
+
+    /// The radius of the capsule.
+    float radius;
+};
+
+// Collision queries against the solid geometry of an octree.
+// Only octants whose bounds overlap the shape are visited. Full leaves are tested exactly against their bounds,
+// indented leaves against their polygons and, for shapes which lie completely within them, against their volume.
+// Shapes which touch a leaf collide with it.
+
+/// Check whether a sphere collides with the leaves of an octree.
+/// @param cube The octree.
+/// @param sphere The sphere.
+/// @return Whether any leaf (CubeType::FULL or CubeType::INDENTED) overlaps the sphere.
+[[nodiscard]] bool collides(Cube &cube, const Sphere &sphere);
+
+/// Check whether an axis aligned box collides with the leaves of an octree.
+/// @param cube The octree.
+/// @param box The box.
+/// @return Whether any leaf (CubeType::FULL or CubeType::INDENTED) overlaps the box.
+[[nodiscard]] bool collides(Cube &cube, const Box &box);
+
+/// Check whether a capsule collides with the leaves of an octree.
+/// @param cube The octree.
+/// @param capsule The capsule.
+/// @return Whether any leaf (CubeType::FULL or CubeType::INDENTED) overlaps the capsule.
+[[nodiscard]] bool collides(Cube &cube, const Capsule &capsule);
+
+/// Find the leaves of an octree which overlap a sphere.
+/// @param cube The octree.
+/// @param sphere The sphere.
+/// @param leaves The buffer to append the overlapping leaves to.
+void overlaps(Cube &cube, const Sphere &sphere, std::vector<Cube *> &leaves);
+
+/// Find the leaves of an octree which overlap an axis aligned box.
+/// @param cube The octree.
+/// @param box The box.
+/// @param leaves The buffer to append the overlapping leaves to.
+void overlaps(Cube &cube, const Box &box, std::vector<Cube *> &leaves);
+
+/// Find the leaves of an octree which overlap a capsule.
+/// @param cube The octree.
+/// @param capsule The capsule.
+/// @param leaves The buffer to append the overlapping leaves to.
+void overlaps(Cube &cube, const Capsule &capsule, std::vector<Cube *> &leaves);
+
+/// Check spheres for collisions with an octree in parallel, the octree must not change until all spheres are checked.
+/// @param cube The octree.
+/// @param spheres The spheres.
+/// @param thread_pool The thread pool to check the spheres on.
+/// @param batch_size The number of spheres which are checked by one task.
+/// @return Whether each sphere collides, in the order of the spheres.
+[[nodiscard]] std::vector<char> collides(Cube &cube, const std::vector<Sphere> &spheres, ThreadPool &thread_pool,
+                                         std::size_t batch_size = 1024);
+
+/// Check axis aligned boxes for collisions with an octree in parallel, see the overload for spheres.
+/// @param cube The octree.
+/// @param boxes The boxes.
+/// @param thread_pool The thread pool to check the boxes on.
+/// @param batch_size The number of boxes which are checked by one task.
+/// @return Whether each box collides, in the order of the boxes.
+[[nodiscard]] std::vector<char> collides(Cube &cube, const std::vector<Box> &boxes, ThreadPool &thread_pool,
+                                         std::size_t batch_size = 1024);
+
+/// Check capsules for collisions with an octree in parallel, see the overload for spheres.
+/// @param cube The octree.
+/// @param capsules The capsules.
+/// @param thread_pool The thread pool to check the capsules on.
+/// @param batch_size The number of capsules which are checked by one task.
+/// @return Whether each capsule collides, in the order of the capsules.
+[[nodiscard]] std::vector<char> collides(Cube &cube, const std::vector<Capsule> &capsules, ThreadPool &thread_pool,
+                                         std::size_t batch_size = 1024);
+} // namespace inexor::vulkan_renderer::world
@@ -1,15 +1,22 @@
 #pragma once
 
 #include "inexor/vulkan-renderer/world/bit_stream.hpp"
+#include "inexor/vulkan-renderer/world/bit_stream_writer.hpp"
+#include "inexor/vulkan-renderer/world/change_journal.hpp"
+#include "inexor/vulkan-renderer/world/subtree_index.hpp"
 
 #include <boost/dynamic_bitset.hpp>
-#include <boost/signals2.hpp>
 #include <glm/vec3.hpp>
 
 #include <array>
 #include <cstdint>
+#include <memory>
 #include <optional>
 
+namespace inexor {
+class ThreadPool;
+} // namespace inexor
+
 namespace inexor::vulkan_renderer::world {
 /// How often a cube can be indented, results in MAX_INDENTATION+1 steps.
 constexpr std::uint8_t MAX_INDENTATION = 8;
@@ -33,9 +40,13 @@ enum class CubeType {
     OCTANT = 0b11
 };
 
+class Cube;
+
 class Indentation {
 private:
-    /// Run on-change events.
+    friend class Cube;
+
+    /// Mark the cube which owns this indentation as changed.
     void change();
 
     /// Copy the values from another indentation to this one.
@@ -48,14 +59,23 @@ private:
     /// @return The indentation level on that axis.
     static std::uint8_t parse_one(BitStream &stream);
 
-    /// Indentation level on the x-axis.
-    std::uint8_t x_level = 0;
+    /// Number of bits of one indentation level.
+    static constexpr std::uint32_t LEVEL_BITS = 4;
 
-    /// Indentation level on the y-axis.
-    std::uint8_t y_level = 0;
+    /// Mask of the bits of one indentation level.
+    static constexpr std::uint16_t LEVEL_MASK = (1u << LEVEL_BITS) - 1;
 
-    /// Indentation level on the z-axis.
-    std::uint8_t z_level = 0;
+    /// Set the indentation levels on all three axes without running on-change events.
+    /// @param x Indentation level on the x-axis.
+    /// @param y Indentation level on the y-axis.
+    /// @param z Indentation level on the z-axis.
+    void set_levels(std::uint8_t x, std::uint8_t y, std::uint8_t z);
+
+    /// Indentation levels on the x-, y- and z-axis with LEVEL_BITS each, starting at the lowest bits.
+    std::uint16_t levels = 0;
+
+    /// The cube which owns this indentation, if the cube is attached to a change journal. Not copied with the values.
+    Cube *owner = nullptr;
 
 public:
     /// Create an Indentation to assign to a cube corner.
@@ -71,10 +91,6 @@ public:
 
     Indentation(Indentation &&indentation) noexcept;
 
-    /// Signal emitted when one of the indentation levels changes.
-    /// Argument: the indentation emitting the signal ("this").
-    boost::signals2::signal<void(Indentation *)> on_change;
-
     Indentation &operator=(Indentation &&lhs) noexcept;
 
     Indentation &operator=(const Indentation &rhs);
@@ -112,6 +128,11 @@ public:
     /// @return The indentation on all three axes.
     static Indentation parse(BitStream &stream);
 
+    /// Parse the indentation levels of one corner from a bitstream without creating an Indentation.
+    /// @param stream The stream to extract the levels from.
+    /// @return The indentation levels on all three axes.
+    static glm::tvec3<std::uint8_t> parse_levels(BitStream &stream);
+
     /// Get the x-axis indentation level.
     /// @return the x-axis indentation level.
     [[nodiscard]] std::uint8_t x() const;
@@ -163,50 +184,77 @@ private:
          const std::optional<std::array<Indentation, 8>> &indentations,
          std::optional<std::array<std::shared_ptr<Cube>, 8>> octants);
 
-    /// Insert all polygons into memory.
-    /// @param polygons Pointer to the memory where the polygons should be saved to.
-    void all_polygons(std::array<glm::vec3, 3> *&polygons);
-
-    /// Run on-change events.
+    /// Record this cube in its change journal, unless it is recorded already.
     void change();
 
-    /// Run on-change events.
-    void change(Indentation *indentation);
+    /// Attach this octree to a change journal.
+    /// @param journal The change journal.
+    /// @param force Whether to descend into subtrees which are attached to the journal already.
+    void attach(const std::shared_ptr<ChangeJournal> &journal, bool force);
 
     /// Copy the values from another cube to this one.
+    /// The octants are shared with the other cube, unless this cube is reactive, which copies them with their subtrees.
     /// @param cube The cube to copy the values from.
     /// @return Whether any value has changed (this != &cube).
     bool copy_values(const Cube &cube);
 
-    /// Get all vertices of this cube (not its children).
-    /// @return vertices of this cube.
-    [[nodiscard]] std::array<glm::vec3, 8> vertices();
-
-    /// Get the polygons of this cube as if it is a full cube.
-    /// @return polygons of this cube as if it is a full cube
-    std::array<std::array<glm::vec3, 3>, 12> full_polygons();
-
-    /// Get the vertices in a structure which is ordered in triangles of the order of a full cube.
-    /// @param v The vertices of the the sides of a cube.
-    /// @return polygons of this cube in the order of a full cube.
-    std::array<std::array<glm::vec3, 3>, 12> full_polygons(std::array<glm::vec3, 8> &v);
-
-    /// Get the polygons of this cube (only when it is an indented cube).
-    /// @return polygons of this cube
-    std::array<std::array<glm::vec3, 3>, 12> indented_polygons();
+    /// Get the polygons of an indented cube.
+    /// @param v The vertices of the indented cube.
+    /// @param in The indentation levels of each corner.
+    /// @return polygons of the indented cube.
+    static std::array<std::array<glm::vec3, 3>, 12>
+    indented_polygons(const std::array<glm::vec3, 8> &v, const std::array<glm::tvec3<std::uint8_t>, 8> &in);
 
     /// Get the indentation levels for each side of the cube.
     /// @return The indentation lebvels for each side of the cube.
     std::array<glm::tvec3<std::uint8_t>, 8> indentation_levels();
 
-    /// Cache of this cubes polygons. Not of its octants (i.e., empty of the cube is of type CubeType::OCTANTS).
-    std::array<std::array<glm::vec3, 3>, 12> polygons_cache = {}; // Vertices of this cube (not its octants)
+    /// Values which are aggregated over the leaves of a subtree.
+    struct Aggregates {
+        /// The number of leaves.
+        std::uint64_t leaves = 0;
+
+        /// The corner of the bounds of the leaves with the lowest coordinates, only valid if there are leaves.
+        glm::vec3 min = {0.0f, 0.0f, 0.0f};
+
+        /// The corner of the bounds of the leaves with the highest coordinates, only valid if there are leaves.
+        glm::vec3 max = {0.0f, 0.0f, 0.0f};
+    };
+
+    /// Get the aggregates of this subtree, which are cached in a reactive octree.
+    /// @return The aggregates.
+    Aggregates aggregate();
+
+    /// Count the leaves of this subtree without computing their bounds, for octrees which do not cache aggregates.
+    /// @return The number of leaves.
+    [[nodiscard]] std::uint64_t count_leaves() const;
+
+    /// Mark the cached aggregates of this cube and its ancestors as outdated.
+    void invalidate_aggregates();
+
+    /// Write all polygons of this octree to consecutive memory, like Cube::polygons appends them to a buffer.
+    /// @param polygons The position to write the first polygon to, advanced past the last polygon.
+    /// @param end The end of the memory, a leaf which does not fit anymore throws std::runtime_error.
+    void write_polygons(std::array<glm::vec3, 3> *&polygons, const std::array<glm::vec3, 3> *end);
+
+    friend class ChangeJournal;
+    friend class Indentation;
+
+    /// The change journal this cube records its changes in, shared by all cubes of a reactive octree.
+    std::shared_ptr<ChangeJournal> change_journal;
+
+    /// Whether this cube is recorded in the current batch of its change journal.
+    bool journaled = false;
+
+    /// Whether the cached aggregates are up to date. Only set in a reactive octree, where all changes are noticed, and
+    /// not for cubes with a subtree which is shared by several cubes. If a cube is outdated, so are its ancestors.
+    bool aggregated = false;
 
-    /// Whether this->polygons_cache is valid and might be used.
-    bool valid_cache = false;
+    /// The cached aggregates of this subtree.
+    Aggregates aggregates;
 
-    /// Whether this octree is reactive (i.e. updates when childs update).
-    bool is_reactive = false;
+    /// The cube which has this cube as an octant in a reactive octree, set when the octant is attached.
+    Cube *parent = nullptr;
 
     /// Type of the cube.
     CubeType cube_type = CubeType::EMPTY;
@@ -219,10 +267,6 @@ private:
     float cube_size = 32;
 
 public:
-    /// Signal emitted when any of the geometry of this cube or its child cubes changes.
-    /// Argument: the cube which was originally changed ("this" or a child-cube).
-    boost::signals2::signal<void(Cube *)> on_change;
-
     /// The indentations of this cube if this cube is of CubeType::INDENTED.
     /// Ordered as following:
     /// 0. Corner with lower x-axis-value, lower y-value, lower z-value.
@@ -274,10 +318,16 @@ public:
 
     Cube(Cube &&cube) noexcept;
 
+    ~Cube();
+
     Cube &operator=(Cube &&lhs) noexcept;
 
     Cube &operator=(const Cube &rhs);
 
+    /// Copy this cube together with its subtree, unlike the copy constructor which shares the octants.
+    /// @return The copy, which shares no cube with this one and is not reactive.
+    [[nodiscard]] std::shared_ptr<Cube> clone() const;
+
     /// Parse an octree from binary data.
     /// @param data The data to parse the octree from.
     /// @return Cube object representing the cubes / octrees from the data.
@@ -288,7 +338,7 @@ public:
     /// @return Cube object representing the cubes / octrees from the stream.
     static Cube parse(BitStream &stream);
 
-    /// Parse an octree from a BitStream.
+    /// Parse an octree from a BitStream, data which ends before the octree is complete throws std::runtime_error.
     /// @param stream The BitStream to parse the octree from.
     /// @param size The maximum size of the cube.
     /// @param position The position of the cube in the coordinate system (i.e., the vector from (0, 0, 0) to the bounds
@@ -296,15 +346,89 @@ public:
     /// @return Cube object representing the cubes / octrees from the stream.
     static Cube parse(BitStream &stream, float size, const glm::vec3 &position);
 
+    /// Get the vertices of a leaf cube (CubeType::FULL or CubeType::INDENTED) from its raw values.
+    /// Used by every octree representation which does not store Cube objects.
+    /// @param type The type of the cube.
+    /// @param size The maximum size of the cube.
+    /// @param position The position of the cube in the coordinate system.
+    /// @param levels The indentation levels of each corner, ignored if type is CubeType::FULL.
+    /// @return vertices of the cube.
+    [[nodiscard]] static std::array<glm::vec3, 8> leaf_vertices(CubeType type, float size, const glm::vec3 &position,
+                                                                const std::array<glm::tvec3<std::uint8_t>, 8> &levels);
+
+    /// Get the vertices in a structure which is ordered in triangles of the order of a full cube.
+    /// @param v The vertices of the the sides of a cube (or any box).
+    /// @return polygons of this cube in the order of a full cube.
+    [[nodiscard]] static std::array<std::array<glm::vec3, 3>, 12> full_polygons(const std::array<glm::vec3, 8> &v);
+
+    /// Get the polygons of a leaf cube (CubeType::FULL or CubeType::INDENTED) from its raw values.
+    /// @param type The type of the cube.
+    /// @param size The maximum size of the cube.
+    /// @param position The position of the cube in the coordinate system.
+    /// @param levels The indentation levels of each corner, ignored if type is CubeType::FULL.
+    /// @return polygons of the cube in the order of a full cube.
+    [[nodiscard]] static std::array<std::array<glm::vec3, 3>, 12>
+    leaf_polygons(CubeType type, float size, const glm::vec3 &position,
+                  const std::array<glm::tvec3<std::uint8_t>, 8> &levels);
+
+    /// Parse an octree from binary data in parallel.
+    /// Everything above the depth of the index is parsed directly, every subtree at the depth of the index is parsed
+    /// as an independent task on the thread pool.
+    /// @param data The data to parse the octree from, must outlive the call.
+    /// @param thread_pool The thread pool to parse the subtrees on.
+    /// @param index The offsets of the subtrees in the data, missing offsets or offsets behind the end of the data throw
+    /// std::runtime_error.
+    /// @return Cube object representing the cubes / octrees from the data.
+    static Cube parse(const std::vector<unsigned char> &data, ThreadPool &thread_pool, const SubtreeIndex &index);
+
+    /// Parse an octree from binary data in parallel, the subtree index is built with a pre-pass.
+    /// @param data The data to parse the octree from, must outlive the call.
+    /// @param thread_pool The thread pool to parse the subtrees on.
+    /// @param split_depth The depth of the subtrees which are parsed as independent tasks (up to 8^split_depth).
+    /// @return Cube object representing the cubes / octrees from the data.
+    static Cube parse(const std::vector<unsigned char> &data, ThreadPool &thread_pool, std::uint32_t split_depth);
+
+    /// Serialize this octree into the binary format which is read by Cube::parse.
+    /// @return The binary data of this octree.
+    [[nodiscard]] std::vector<unsigned char> serialize() const;
+
+    /// Serialize this octree into the binary format which is read by Cube::parse.
+    /// @param writer The BitStreamWriter to write the octree to.
+    void serialize(BitStreamWriter &writer) const;
+
     /// Get the type of the cube.
     /// @return type of the cube.
     [[nodiscard]] CubeType type();
 
+    /// Get the maximum size of the cube.
+    /// @return size of the cube.
+    [[nodiscard]] float size() const;
+
+    /// Get the position of the cube in the coordinate system.
+    /// @return position of the cube.
+    [[nodiscard]] glm::vec3 position() const;
+
     /// Get the number of leaves, this octree contains.
     /// Leaves are cubes of CubeType::INDENTED or CubeTYPE::FULL.
+    /// The number is cached in every cube of a reactive octree and updated along the path to the root after an edit,
+    /// other octrees count the leaves of the whole subtree. This applies to Cube::triangles and Cube::bounds as well, but
+    /// only Cube::bounds computes the vertices of indented leaves if the octree is not reactive.
     /// @return Number of leaves, this octree contains.
     [[nodiscard]] std::uint64_t leaves();
 
+    /// Get the number of triangles of this octree, as generated by Cube::polygons.
+    /// @return Number of triangles, 12 per leaf.
+    [[nodiscard]] std::uint64_t triangles();
+
+    /// Get the bounds of the geometry of this octree, which are smaller than the cube if its leaves are indented.
+    /// @return The corners of the bounds with the lowest and highest coordinates, std::nullopt without leaves.
+    [[nodiscard]] std::optional<std::array<glm::vec3, 2>> bounds();
+
+    /// Find the leaf or empty cube which contains a point by descending through the octants.
+    /// @param point The point to find the cube of, points outside of this cube are clamped to its nearest octants.
+    /// @return The cube without octants which contains the point.
+    [[nodiscard]] Cube *find(const glm::vec3 &point);
+
     // [[nodiscard]] dynamic_bitset<> bits(); // Bit representation of this cube
     // [[nodiscard]] vector<array<glm::vec3, 8>> vertices(); // All vertices this cube contains.
     // [[nodiscard]] vector<array<glm::vec3, 4>> sides(); // All sides this cube contains.
@@ -312,11 +436,30 @@ public:
     /// @return A vector which contains the three vertices representing a triangle.
     [[nodiscard]] std::vector<std::array<glm::vec3, 3>> polygons(); // All polygons this cube contains.
 
-    /// Invalidate the cache of this cube / octree (not its children).
-    void invalidate_cache();
+    /// Append all polygons (triangles) of each cube of this octree to a buffer.
+    /// The polygons are generated on demand, a buffer which is kept by the caller reuses its memory.
+    /// @param polygons The buffer to append the polygons to.
+    void polygons(std::vector<std::array<glm::vec3, 3>> &polygons);
+
+    /// Get all polygons (triangles) of each cube of this octree in parallel, in the same order as Cube::polygons.
+    /// The leaves of the subtrees at the split depth are counted on the thread pool first. A prefix sum of the counts
+    /// assigns each subtree its range of the output, which the subtrees fill concurrently. A subtree whose leaves do
+    /// not match its count (e.g. because it was changed meanwhile) throws std::runtime_error instead of leaving its
+    /// range.
+    /// @param thread_pool The thread pool to generate the polygons on.
+    /// @param split_depth The depth of the subtrees which are processed as independent tasks (up to 8^split_depth).
+    /// @return A vector which contains the three vertices representing a triangle.
+    [[nodiscard]] std::vector<std::array<glm::vec3, 3>> polygons(ThreadPool &thread_pool, std::uint32_t split_depth);
 
-    /// Make this octree reactive (update its values when one of its attributes changes).
-    /// @param force Whether to make it reactive again even though the connections were established before.
+    /// Make this octree reactive: every cube records its changes (of its type, indentations or octants) in the change
+    /// journal of the octree, which is created if this cube has none yet.
+    /// Cubes which are assigned within a reactive octree are attached to its journal on assignment. Octants have to be
+    /// replaced by assigning to them (not by replacing the pointers in Cube::octants) for the change to be noticed.
+    /// @param force Whether to descend into subtrees which are attached to the journal already.
     void make_reactive(bool force = false);
+
+    /// Get the change journal of this octree.
+    /// @return The change journal, nullptr if the octree is not reactive.
+    [[nodiscard]] const std::shared_ptr<ChangeJournal> &journal() const;
 };
 } // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <array>
+
+namespace inexor::vulkan_renderer::world {
+/// The view frustum of a camera, described by six planes whose normals point inwards.
+class Frustum {
+private:
+    /// The planes (left, right, bottom, top, near, far), a point p is on the inner side if dot(xyz, p) + w >= 0.
+    std::array<glm::vec4, 6> planes;
+
+public:
+    /// The intersection of a box with the frustum.
+    enum class Intersection {
+        /// The box is completely outside of the frustum.
+        OUTSIDE,
+        /// The box is partly inside of the frustum (or can not be proven to be outside).
+        INTERSECTING,
+        /// The box is completely inside of the frustum.
+        INSIDE
+    };
+
+    /// Extract the frustum from a matrix which transforms into clip space with depth from 0 to 1 (as used by Vulkan).
+    /// @param matrix The projection matrix multiplied by the view matrix (and model matrix, to get the frustum in the
+    /// coordinate system of the model).
+    explicit Frustum(const glm::mat4 &matrix);
+
+    /// Intersect an axis aligned box with the frustum.
+    /// @param min The corner of the box with the lowest values.
+    /// @param max The corner of the box with the highest values.
+    /// @return The intersection of the box with the frustum.
+    [[nodiscard]] Intersection intersect(const glm::vec3 &min, const glm::vec3 &max) const;
+};
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,246 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/frustum.hpp"
+#include "inexor/vulkan-renderer/world/indexed_mesh.hpp"
+#include "inexor/vulkan-renderer/world/level_of_detail.hpp"
+#include "inexor/vulkan-renderer/world/mesher.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace inexor::vulkan_renderer::world {
+/// The polygons of an octree which are kept up to date by remeshing only the leaves which changed.
+///
+/// Every leaf owns a fixed slot of 12 polygons in the mesh, in the same order as Cube::polygons. Edits of a leaf (e.g.
+/// of its indentations or its type as long as it stays a leaf) only regenerate the slot of that leaf, a leaf which
+/// became empty keeps its slot filled with degenerated polygons. Changes of the structure of the octree (a leaf which
+/// is split into octants, octants which are replaced, an empty cube which is filled) rebuild the whole mesh.
+///
+/// Hidden faces are culled like by the Mesher, but they keep their place in the slot as degenerated polygons. As the
+/// visibility of a face depends on the neighbouring leaves, an edit of a leaf also rewrites the slots of the leaves
+/// which touch it on one of its six sides. Faces are never culled against the leaves of a collapsed subtree, which are
+/// drawn as their approximation.
+///
+/// With a level of detail, the slots are still assigned to the leaves, so that the layout of the mesh does not depend
+/// on the selection of collapsed subtrees. A collapsed subtree draws the polygons of its approximation in the first
+/// slot of its leaves and degenerates the other ones. A change of the selection or within a collapsed subtree only
+/// rewrites the slots of the affected subtrees.
+///
+/// The slots of the leaves of every subtree are contiguous, so that the mesh can be culled hierarchically: the octree
+/// nodes are stored with their bounds in depth first order, each node knows where its subtree ends, and whole subtrees
+/// are skipped or drawn as one range depending on their intersection with the view frustum.
+///
+/// The mesh is meant to be uploaded once and patched afterwards, see IncrementalMesh::update. It is not thread safe.
+class IncrementalMesh {
+public:
+    /// A range of polygons in the mesh.
+    struct Range {
+        /// Index of the first polygon.
+        std::size_t first;
+
+        /// Number of polygons.
+        std::size_t count;
+    };
+
+    /// The result of an update of the mesh.
+    struct Update {
+        /// Whether the whole mesh has been rebuilt, its size may have changed in that case.
+        bool rebuilt = false;
+
+        /// The ranges of polygons which changed, ordered and not overlapping.
+        std::vector<Range> ranges;
+    };
+
+private:
+    /// A node of the octree with its bounds and polygons, only nodes which own polygons are stored.
+    struct Node {
+        /// The corner of the bounds with the lowest values.
+        glm::vec3 min;
+
+        /// The corner of the bounds with the highest values.
+        glm::vec3 max;
+
+        /// The polygons of all slots within the subtree of the node.
+        Range polygons;
+
+        /// The index of the node after the subtree of this node.
+        std::size_t end;
+
+        /// The cube of the node.
+        Cube *cube;
+    };
+
+    /// The octree.
+    std::shared_ptr<Cube> root;
+
+    /// The polygons of all slots.
+    std::vector<std::array<glm::vec3, 3>> mesh;
+
+    /// The material of each face of every slot.
+    std::vector<std::array<std::uint16_t, Mesher::FACES>> materials;
+
+    /// The options of the mesher.
+    MeshOptions options;
+
+    /// The nodes of the octree in depth first order.
+    std::vector<Node> nodes;
+
+    /// The index of the first polygon of each leaf.
+    std::unordered_map<const Cube *, std::size_t> slots;
+
+    /// The leaves which changed since the last update.
+    std::unordered_set<Cube *> dirty;
+
+    /// The first polygons of the slots which have been rewritten for the level of detail since the last update.
+    std::vector<std::size_t> changed;
+
+    /// The collapsed subtrees as drawn in the mesh, with the polygons of their approximation (empty if the
+    /// approximation is empty or the subtree has no slots).
+    std::unordered_map<Cube *, Range> collapsed;
+
+    /// The leaves within collapsed subtrees, with the collapsed subtree which they belong to.
+    std::unordered_map<const Cube *, Cube *> hidden;
+
+    /// The level of detail, if distant subtrees are collapsed.
+    std::optional<LevelOfDetail> level_of_detail;
+
+    /// Whether the structure of the octree changed since the last update.
+    bool rebuild_required = true;
+
+    /// The change journal of the octree.
+    std::shared_ptr<ChangeJournal> journal;
+
+    /// The id of the subscription to the change journal.
+    std::size_t subscription;
+
+    /// Called for every batch of changes of the octree.
+    /// @param cubes The cubes which changed.
+    void change(const std::vector<Cube *> &cubes);
+
+    /// Assign the slots of all leaves of a cube and insert their polygons and nodes.
+    /// @param cube The cube.
+    void insert(Cube &cube);
+
+    /// Get the materials of the faces of a leaf or collapsed subtree.
+    /// @param cube The leaf or collapsed subtree.
+    /// @return The material of each face.
+    [[nodiscard]] std::array<std::uint16_t, Mesher::FACES> face_materials(Cube &cube) const;
+
+    /// Find the neighbouring cube of the same size on a side of a cube, or the neighbouring leaf of a larger size.
+    /// @param cube The cube.
+    /// @param face The side of the cube.
+    /// @return The neighbour, nullptr outside of the octree or within a collapsed subtree.
+    [[nodiscard]] Cube *neighbour(const Cube &cube, std::size_t face) const;
+
+    /// Get whether a side of a cube is completely covered by leaves which are not collapsed.
+    /// @param cube The cube, may be nullptr.
+    /// @param face The side of the cube.
+    /// @return Whether the side is covered.
+    [[nodiscard]] bool is_covered(Cube *cube, std::size_t face) const;
+
+    /// Get the polygons of the slot of a leaf, hidden faces and empty leaves are degenerated.
+    /// @param leaf The leaf.
+    /// @return The polygons of the slot.
+    [[nodiscard]] std::array<std::array<glm::vec3, 3>, 12> slot_polygons(Cube &leaf) const;
+
+    /// Rewrite the slot of a leaf which is not within a collapsed subtree.
+    /// @param leaf The leaf.
+    void patch(Cube &leaf);
+
+    /// Rewrite the slots of the leaves which touch a cube on one of its sides, whose faces may have been uncovered or
+    /// covered by a change of the cube.
+    /// @param cube The cube.
+    void patch_neighbours(Cube &cube);
+
+    /// Collect the leaves of a cube which own a slot, are not within a collapsed subtree and touch a side of the cube.
+    /// @param cube The cube.
+    /// @param face The side of the cube.
+    /// @param leaves The vector to append the leaves to.
+    void collect_touching(Cube &cube, std::size_t face, std::vector<Cube *> &leaves) const;
+
+    /// Insert the polygons of a leaf or collapsed subtree into a new slot.
+    /// @param cube The leaf or collapsed subtree.
+    /// @param polygons The polygons of the slot.
+    void insert_slot(Cube &cube, const std::array<std::array<glm::vec3, 3>, 12> &polygons);
+
+    /// Collect the leaves of a cube which own a slot, in the order of their slots.
+    /// @param cube The cube.
+    /// @param leaves The vector to append the leaves to.
+    void collect_slots(Cube &cube, std::vector<Cube *> &leaves) const;
+
+    /// Draw a collapsed subtree as its approximation in the first slot of its leaves, the other slots are degenerated.
+    /// @param cube The collapsed subtree.
+    void collapse(Cube &cube);
+
+    /// Rewrite the slots of a subtree with respect to the current selection of collapsed subtrees.
+    /// @param cube The subtree.
+    void reslot(Cube &cube);
+
+    /// Regenerate all slots.
+    void rebuild();
+
+public:
+    /// Number of polygons in the slot of a leaf.
+    static constexpr std::size_t SLOT_SIZE = 12;
+
+    /// Number of vertices of a face in the indexed mesh, the corners of the side of the cube.
+    static constexpr std::size_t FACE_VERTICES = 4;
+
+    /// Number of vertices in the slot of a leaf of the indexed mesh, the faces do not share vertices so that each
+    /// vertex has the normal and material of its face.
+    static constexpr std::size_t SLOT_VERTICES = Mesher::FACES * FACE_VERTICES;
+
+    /// Create the mesh of an octree, makes the octree reactive.
+    /// @param root The octree.
+    /// @param lod_options The options of the level of detail, std::nullopt to always mesh all leaves.
+    /// @param options Whether hidden faces are culled and the material of each face of a leaf or collapsed subtree.
+    explicit IncrementalMesh(std::shared_ptr<Cube> root, const std::optional<LodOptions> &lod_options = std::nullopt,
+                             MeshOptions options = {});
+
+    IncrementalMesh(const IncrementalMesh &) = delete;
+    IncrementalMesh &operator=(const IncrementalMesh &) = delete;
+
+    ~IncrementalMesh();
+
+    /// Select the collapsed subtrees for a camera position, the slots of the subtrees which are collapsed or expanded
+    /// are rewritten and returned by the next update. Does nothing without a level of detail.
+    /// @param camera_position The position of the camera.
+    /// @return Whether the selection changed.
+    bool update_level_of_detail(const glm::vec3 &camera_position);
+
+    /// Remesh the leaves which changed since the last update, flushes the change journal of the octree.
+    /// @return The polygons which changed.
+    Update update();
+
+    /// Get the polygons of all slots as of the last update.
+    /// @return A vector which contains the three vertices representing a triangle.
+    [[nodiscard]] const std::vector<std::array<glm::vec3, 3>> &polygons() const;
+
+    /// Get the polygons of a range of slots as indexed mesh with normals and materials, the vertices are shared within
+    /// each face. Every slot has SLOT_VERTICES vertices (unused ones are padding) and SLOT_SIZE * 3 indices, so that
+    /// the slots of the indexed mesh can be patched just like the polygons. The indices refer to the vertices of the
+    /// whole mesh.
+    /// @param range The range of polygons, which has to consist of whole slots.
+    /// @return The vertices and indices of the slots.
+    [[nodiscard]] IndexedMesh indexed(const Range &range) const;
+
+    /// Get the polygons which are within a view frustum as of the last update.
+    /// Slots are culled with the bounds of their cube, so patching a slot never makes its polygons invisible.
+    /// @param frustum The view frustum in the coordinate system of the octree.
+    /// @return The ranges of visible polygons, ordered and not overlapping.
+    [[nodiscard]] std::vector<Range> visible(const Frustum &frustum) const;
+
+    /// Get whether the octree changed since the last update.
+    /// @return Whether an update is pending.
+    [[nodiscard]] bool is_dirty() const;
+};
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace inexor::vulkan_renderer::world {
+/// Polygons (triangles) which share their vertices, each polygon is described by three indices into the vertices.
+class IndexedMesh {
+public:
+    /// The unique vertices.
+    std::vector<glm::vec3> vertices;
+
+    /// The normal of each vertex, empty if the mesh has no normals.
+    std::vector<glm::vec3> normals;
+
+    /// The material of each vertex, empty if the mesh has no materials.
+    std::vector<std::uint16_t> materials;
+
+    /// Three indices into the vertices for each polygon, in the order of the polygons.
+    std::vector<std::uint32_t> indices;
+
+    /// Create an indexed mesh from polygons, vertices with the same position are merged.
+    /// @param polygons The polygons.
+    /// @return The indexed mesh.
+    [[nodiscard]] static IndexedMesh from_polygons(const std::vector<std::array<glm::vec3, 3>> &polygons);
+
+    /// Get whether all indices fit into 16 bit, so that the index buffer can be half as large.
+    /// Indices may refer to vertices which are not part of this mesh (see IncrementalMesh::indexed).
+    /// @return Whether 16 bit indices can be used.
+    [[nodiscard]] bool has_16_bit_indices() const;
+
+    /// Get the indices as 16 bit values, only valid if has_16_bit_indices is true.
+    /// @return The indices.
+    [[nodiscard]] std::vector<std::uint16_t> indices_16_bit() const;
+};
+} // namespace inexor::vulkan_renderer::world
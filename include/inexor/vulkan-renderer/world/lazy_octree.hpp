@@ -0,0 +1,169 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/tools/mapped_file.hpp"
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/subtree_index.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace inexor::vulkan_renderer::world {
+/// An octree which is decoded from its binary data only as far as it is accessed.
+///
+/// A node only stores its type and the bit offset of its data. The children of an octant are created on first
+/// access, indentations are decoded from the data every time they are requested. Regions of the map which are never
+/// traversed, queried or meshed cost neither memory nor parse time. Finding the children of a node skips over the
+/// subtrees of their previous siblings, which reads but does not create them. Near the root these subtrees are most of
+/// the octree, so the first access to a point decodes the whole data before it. A SubtreeIndex which is passed to the
+/// constructor avoids this for every node up to the depth of the index, its children are found by their offsets.
+///
+/// The binary data is usually a mapped file (see LazyOctree::open), so that untouched parts of the map are not even
+/// loaded from disk. The octree is not thread safe, as reading may create nodes.
+class LazyOctree {
+private:
+    /// A node of the octree.
+    struct Node {
+        /// The offset of the node in the binary data in bits.
+        std::size_t bit_offset;
+
+        /// Index of the first of the 8 children or 0 if they have not been created yet (the root can not be a child).
+        std::uint32_t children;
+
+        /// Type of the node.
+        CubeType type;
+    };
+
+    /// The mapped file if the octree owns its data.
+    std::optional<tools::MappedFile> file;
+
+    /// The binary data of the octree.
+    const unsigned char *data = nullptr;
+
+    /// The size of the binary data in bytes.
+    std::size_t data_size = 0;
+
+    /// Bit offsets of the nodes up to the depth of the subtree index in stream order, empty without an index.
+    std::vector<std::size_t> index_offsets;
+
+    /// For every entry of the subtree index, the entry which follows the entries of its subtree.
+    std::vector<std::uint32_t> index_ends;
+
+    /// All created nodes, the root node is at index 0.
+    std::vector<Node> nodes;
+
+    /// The maximum size of the root cube.
+    float root_size = DEFAULT_CUBE_SIZE;
+
+    /// The position of the root cube in the coordinate system.
+    glm::vec3 root_position = DEFAULT_CUBE_POSITION;
+
+    /// Create the 8 children of a node of CubeType::OCTANT if they do not exist yet.
+    /// @param node The index of the node.
+    void materialize(std::uint32_t node);
+
+    /// Check the offsets of an entry of the subtree index and its subtree against the data and link their ends.
+    /// @param entry The entry of the subtree index.
+    /// @param depth The depth of the node of the entry.
+    /// @param index_depth The deepest level which is indexed.
+    /// @return The entry which follows the entries of the subtree.
+    std::uint32_t link_index(std::uint32_t entry, std::uint32_t depth, std::uint32_t index_depth);
+
+    /// Insert all polygons of the leaves which intersect a region into memory.
+    /// @param node The index of the node.
+    /// @param size The maximum size of the node.
+    /// @param position The position of the node.
+    /// @param min The lower corner of the region.
+    /// @param max The upper corner of the region.
+    /// @param polygons The vector to append the polygons to.
+    void collect_polygons(std::uint32_t node, float size, const glm::vec3 &position, const glm::vec3 &min,
+                          const glm::vec3 &max, std::vector<std::array<glm::vec3, 3>> &polygons);
+
+public:
+    /// Create a lazy octree from binary data, only the type of the root node is read.
+    /// Data which ends before a node that is read throws std::runtime_error, here or when the node is accessed.
+    /// @param data The binary data of the octree, which has to outlive the octree.
+    /// @param byte_size The size of the data in bytes.
+    /// @param size The maximum size of the root cube.
+    /// @param position The position of the root cube in the coordinate system.
+    LazyOctree(const unsigned char *data, std::size_t byte_size, float size = DEFAULT_CUBE_SIZE,
+               const glm::vec3 &position = DEFAULT_CUBE_POSITION);
+
+    /// Create a lazy octree from binary data and a subtree index, the children of indexed nodes are found by their
+    /// offsets instead of skipping the subtrees of their previous siblings.
+    /// Offsets which do not match the data throw std::runtime_error.
+    /// @param data The binary data of the octree, which has to outlive the octree.
+    /// @param byte_size The size of the data in bytes.
+    /// @param index The offsets of the nodes up to the depth of the index, e.g. stored next to the data.
+    /// @param size The maximum size of the root cube.
+    /// @param position The position of the root cube in the coordinate system.
+    LazyOctree(const unsigned char *data, std::size_t byte_size, const SubtreeIndex &index,
+               float size = DEFAULT_CUBE_SIZE, const glm::vec3 &position = DEFAULT_CUBE_POSITION);
+
+    /// Create a lazy octree from a mapped octree file.
+    /// @param file_name The name of the octree file.
+    /// @param size The maximum size of the root cube.
+    /// @param position The position of the root cube in the coordinate system.
+    /// @return The octree, std::nullopt if the file could not be mapped or is empty.
+    static std::optional<LazyOctree> open(const std::string &file_name, float size = DEFAULT_CUBE_SIZE,
+                                          const glm::vec3 &position = DEFAULT_CUBE_POSITION);
+
+    /// Get the index of the root node.
+    /// @return index of the root node.
+    [[nodiscard]] static constexpr std::uint32_t root() {
+        return 0;
+    }
+
+    /// Get the type of a node.
+    /// @param node The index of the node.
+    /// @return type of the node.
+    [[nodiscard]] CubeType type(std::uint32_t node) const;
+
+    /// Get the index of the first child of a node of CubeType::OCTANT, creates the children on first access.
+    /// @param node The index of the node.
+    /// @return index of the first child, the other children follow directly.
+    [[nodiscard]] std::uint32_t children(std::uint32_t node);
+
+    /// Get whether the children of a node have been created.
+    /// @param node The index of the node.
+    /// @return Whether the children have been created.
+    [[nodiscard]] bool is_materialized(std::uint32_t node) const;
+
+    /// Decode the indentation levels of a node of CubeType::INDENTED.
+    /// @param node The index of the node.
+    /// @return indentation levels of each corner.
+    [[nodiscard]] std::array<glm::tvec3<std::uint8_t>, 8> indentation_levels(std::uint32_t node) const;
+
+    /// Find the leaf (or empty cube) which contains a point, only creates the nodes along the path.
+    /// @param point The point to search for.
+    /// @return index of the node, std::nullopt if the point is outside of the octree.
+    [[nodiscard]] std::optional<std::uint32_t> find(const glm::vec3 &point);
+
+    /// Get the number of leaves, this octree contains, creates all nodes.
+    /// Leaves are cubes of CubeType::INDENTED or CubeTYPE::FULL.
+    /// @return Number of leaves, this octree contains.
+    [[nodiscard]] std::uint64_t leaves();
+
+    /// Get all polygons (triangles) of each cube of this octree, creates all nodes.
+    /// @return A vector which contains the three vertices representing a triangle.
+    [[nodiscard]] std::vector<std::array<glm::vec3, 3>> polygons();
+
+    /// Get the polygons (triangles) of each cube which intersects a region, only creates the nodes in that region.
+    /// @param min The lower corner of the region.
+    /// @param max The upper corner of the region.
+    /// @return A vector which contains the three vertices representing a triangle.
+    [[nodiscard]] std::vector<std::array<glm::vec3, 3>> polygons(const glm::vec3 &min, const glm::vec3 &max);
+
+    /// Get the number of nodes which have been created.
+    /// @return number of created nodes.
+    [[nodiscard]] std::size_t node_count() const;
+
+    /// Get the memory which is used by the created nodes and the subtree index (not the binary data).
+    /// @return used memory in bytes.
+    [[nodiscard]] std::size_t memory_usage() const;
+};
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/world/cube.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <array>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+namespace inexor::vulkan_renderer::world {
+/// Options of the LevelOfDetail.
+struct LodOptions {
+    /// A subtree is collapsed if its distance to the camera is larger than its size times this factor.
+    float detail_factor = 16.0f;
+
+    /// Relative margin around the distance at which a subtree is collapsed, within which its current level of detail
+    /// is kept, so that subtrees do not flicker between both levels while the camera moves along the boundary.
+    float hysteresis = 0.1f;
+
+    /// Minimum fraction of solid volume of a collapsed subtree to be represented by geometry.
+    float solid_threshold = 0.5f;
+};
+
+/// A leaf which approximates a subtree of the octree.
+struct LodApproximation {
+    /// CubeType::EMPTY, CubeType::FULL or CubeType::INDENTED.
+    CubeType type = CubeType::EMPTY;
+
+    /// The indentation levels of each corner if the type is CubeType::INDENTED.
+    std::array<glm::tvec3<std::uint8_t>, 8> levels{};
+};
+
+/// Selects the subtrees of an octree which are replaced by a single coarse leaf depending on the camera position.
+///
+/// A subtree is collapsed when it is so far away from the camera that its size falls below a fixed fraction of the
+/// distance, so the number of leaves which are drawn per distance band (and with it the number of triangles) stays
+/// roughly the same as the view distance grows. The distance is measured from the camera to the closest point of the
+/// bounds of the subtree.
+///
+/// A collapsed subtree is approximated from the solid volume of its octants: it is empty if most of its volume is
+/// empty, otherwise it is a leaf whose corners are indented towards its center by the empty fraction of the octant at
+/// that corner.
+class LevelOfDetail {
+private:
+    /// The options of the level of detail.
+    LodOptions options;
+
+    /// The subtrees which are collapsed as of the last update.
+    std::unordered_set<const Cube *> collapsed;
+
+    /// Select the collapsed subtrees of a cube.
+    /// @param cube The cube.
+    /// @param camera_position The position of the camera.
+    /// @param selection The set to insert the collapsed subtrees into.
+    void select(Cube &cube, const glm::vec3 &camera_position, std::unordered_set<const Cube *> &selection) const;
+
+    /// Insert the polygons of a cube with respect to the collapsed subtrees.
+    /// @param cube The cube.
+    /// @param polygons The vector to append the polygons to.
+    void insert(Cube &cube, std::vector<std::array<glm::vec3, 3>> &polygons) const;
+
+public:
+    /// Create a level of detail selection, nothing is collapsed until the first update.
+    /// @param options The options of the level of detail.
+    explicit LevelOfDetail(const LodOptions &options = {});
+
+    /// Select the collapsed subtrees of an octree for a camera position, should be called once per frame.
+    /// @param root The octree.
+    /// @param camera_position The position of the camera.
+    /// @return Whether the selection changed.
+    bool update(Cube &root, const glm::vec3 &camera_position);
+
+    /// Get whether a subtree is collapsed as of the last update.
+    /// @param cube The subtree.
+    /// @return Whether the subtree is drawn as a single leaf.
+    [[nodiscard]] bool is_collapsed(const Cube *cube) const;
+
+    /// Get the collapsed subtrees as of the last update.
+    /// @return The collapsed subtrees.
+    [[nodiscard]] const std::unordered_set<const Cube *> &collapsed_subtrees() const;
+
+    /// Get the number of collapsed subtrees as of the last update.
+    /// @return Number of collapsed subtrees.
+    [[nodiscard]] std::size_t collapsed_count() const;
+
+    /// Get all polygons of an octree, collapsed subtrees are replaced by their approximation.
+    /// @param root The octree.
+    /// @return A vector which contains the three vertices representing a triangle.
+    [[nodiscard]] std::vector<std::array<glm::vec3, 3>> polygons(Cube &root) const;
+
+    /// Get the leaf which approximates a cube.
+    /// @param cube The cube.
+    /// @return The approximation of the cube.
+    [[nodiscard]] LodApproximation approximate(Cube &cube) const;
+
+    /// Get the fraction of the volume of a cube which is solid.
+    /// Indented leaves are estimated by the average indentation of their corners.
+    /// @param cube The cube.
+    /// @return The solid fraction of the volume between 0 and 1.
+    [[nodiscard]] static float solid_fraction(Cube &cube);
+};
+} // namespace inexor::vulkan_renderer::world
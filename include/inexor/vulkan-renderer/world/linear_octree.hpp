@@ -0,0 +1,147 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/world/cube.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace inexor::vulkan_renderer::world {
+/// A linear octree: every cube of an octree is stored in a hash map under its Morton key.
+///
+/// The key of a cube is a 1 bit followed by the octant indices (3 bits each, see Cube::octants) on the path from the
+/// root to the cube, which equals the interleaved bits of its integer coordinates on the grid of its depth. The key of
+/// the root is 1. Point location and neighbour queries compute the key of the cube at the deepest level and binary
+/// search the depth of the leaf, so they need O(log MAX_DEPTH) hash lookups instead of a descent through the octants.
+///
+/// The index is kept in sync with the octree through its change journal, a changed cube reindexes its subtree. Changes
+/// are applied when the journal is flushed. It is not thread safe.
+class LinearOctree {
+public:
+    /// The Morton key of a cube.
+    using Key = std::uint64_t;
+
+    /// The maximum depth of an octree which can be indexed.
+    static constexpr std::uint32_t MAX_DEPTH = 21;
+
+private:
+    /// A cube in the index.
+    struct Node {
+        /// The cube.
+        Cube *cube;
+
+        /// The type of the cube when it was indexed, only cubes of CubeType::OCTANT have indexed children.
+        CubeType type;
+    };
+
+    /// The octree.
+    std::shared_ptr<Cube> root;
+
+    /// All cubes by their key.
+    std::unordered_map<Key, Node> nodes;
+
+    /// The keys of all cubes.
+    std::unordered_map<const Cube *, Key> keys;
+
+    /// The depth of the deepest cube which has been indexed, the grid of point location has this depth.
+    std::uint32_t max_depth = 0;
+
+    /// The change journal of the octree.
+    std::shared_ptr<ChangeJournal> journal;
+
+    /// The id of the subscription to the change journal.
+    std::size_t subscription;
+
+    /// Called for every batch of changes of the octree.
+    /// @param cubes The cubes which changed.
+    void change(const std::vector<Cube *> &cubes);
+
+    /// Index a cube and its subtree.
+    /// @param cube The cube.
+    /// @param key The key of the cube.
+    void insert(Cube &cube, Key key);
+
+    /// Remove a cube and its subtree from the index.
+    /// @param key The key of the cube.
+    void remove(Key key);
+
+    /// Find the deepest cube on the path to a key.
+    /// @param key The key.
+    /// @return The key of the deepest cube, which is a leaf unless the key itself is indexed.
+    [[nodiscard]] Key deepest(Key key) const;
+
+public:
+    /// Index an octree, makes the octree reactive.
+    /// @param root The octree, its depth must not exceed MAX_DEPTH.
+    explicit LinearOctree(std::shared_ptr<Cube> root);
+
+    LinearOctree(const LinearOctree &) = delete;
+    LinearOctree &operator=(const LinearOctree &) = delete;
+
+    ~LinearOctree();
+
+    /// Get the key of an octant.
+    /// @param key The key of the parent.
+    /// @param octant The index of the octant.
+    /// @return The key of the octant.
+    [[nodiscard]] static Key child(Key key, std::size_t octant);
+
+    /// Get the key of the parent of a cube.
+    /// @param key The key of the cube, must not be the root.
+    /// @return The key of the parent.
+    [[nodiscard]] static Key parent(Key key);
+
+    /// Get the depth of a cube.
+    /// @param key The key of the cube.
+    /// @return The depth, 0 for the root.
+    [[nodiscard]] static std::uint32_t depth(Key key);
+
+    /// Get the key of a cube from its integer coordinates on the grid of its depth.
+    /// @param depth The depth of the cube.
+    /// @param coordinates The coordinates, each below 2^depth.
+    /// @return The key of the cube.
+    [[nodiscard]] static Key encode(std::uint32_t depth, const std::array<std::uint32_t, 3> &coordinates);
+
+    /// Get the integer coordinates of a cube on the grid of its depth.
+    /// @param key The key of the cube.
+    /// @return The coordinates.
+    [[nodiscard]] static std::array<std::uint32_t, 3> decode(Key key);
+
+    /// Get the cube with a key.
+    /// @param key The key.
+    /// @return The cube, nullptr if there is no cube with this key.
+    [[nodiscard]] Cube *find(Key key) const;
+
+    /// Get the key of a cube of the octree.
+    /// @param cube The cube.
+    /// @return The key, std::nullopt if the cube is not part of the octree.
+    [[nodiscard]] std::optional<Key> key(const Cube *cube) const;
+
+    /// Get the key of the leaf (or empty cube) which contains a point.
+    /// @param point The point.
+    /// @return The key of the leaf, std::nullopt if the point is outside of the octree.
+    [[nodiscard]] std::optional<Key> locate(const glm::vec3 &point) const;
+
+    /// Get the leaf (or empty cube) which contains a point.
+    /// @param point The point.
+    /// @return The leaf, nullptr if the point is outside of the octree.
+    [[nodiscard]] Cube *find(const glm::vec3 &point) const;
+
+    /// Get the neighbour of a cube on one of its faces.
+    /// @param key The key of the cube.
+    /// @param face The face in the order of Cube::polygons: lower x, higher x, lower y, higher y, lower z, higher z.
+    /// @return The key of the neighbouring cube of the same size (which may have octants) or of the larger leaf which
+    /// contains it, std::nullopt at the border of the octree.
+    [[nodiscard]] std::optional<Key> neighbour(Key key, std::size_t face) const;
+
+    /// Get the number of indexed cubes.
+    /// @return The number of cubes.
+    [[nodiscard]] std::size_t size() const;
+};
+} // namespace inexor::vulkan_renderer::world
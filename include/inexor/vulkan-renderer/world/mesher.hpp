@@ -0,0 +1,159 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/world/cube.hpp"
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace inexor::vulkan_renderer::world {
+/// Get the material of a face of a leaf (see Mesher for the numbering of faces).
+using MaterialFunction = std::function<std::uint16_t(Cube &leaf, std::size_t face)>;
+
+/// Options of the Mesher.
+struct MeshOptions {
+    /// Skip faces which are completely covered by a neighbouring leaf.
+    bool cull_hidden_faces = true;
+
+    /// Merge coplanar neighbouring faces of the same size which cover the whole side of their cube into rectangles.
+    bool merge_faces = false;
+
+    /// The material of each face, all faces have material 0 if not set. Only faces of the same material are merged.
+    MaterialFunction material;
+};
+
+/// A vertex generated by the mesher with the attributes of its face.
+struct MeshVertex {
+    glm::vec3 position;
+
+    /// The normal of the face, pointing outwards.
+    glm::vec3 normal;
+
+    /// The planar texture coordinate, see Mesher::texture_coordinate.
+    glm::vec2 texture_coordinate;
+
+    /// The material of the face.
+    std::uint16_t material;
+};
+
+/// Statistics of the last octree meshed by the Mesher.
+struct MeshStatistics {
+    /// Number of leaves (cubes of CubeType::FULL or CubeType::INDENTED).
+    std::uint64_t leaves = 0;
+
+    /// Number of triangles which have been generated.
+    std::uint64_t triangles = 0;
+
+    /// Number of triangles which have been skipped as they are hidden.
+    std::uint64_t hidden_triangles = 0;
+
+    /// Number of triangles which have been saved by merging faces.
+    std::uint64_t merged_triangles = 0;
+};
+
+/// Generates the polygons of an octree, optionally with the normals, texture coordinates and materials of their faces.
+///
+/// Faces are numbered in the order of their polygons in Cube::polygons: lower x, higher x, lower y, higher y,
+/// lower z, higher z. The two polygons of a face are wound clockwise seen from the outside. A face is hidden if it lies
+/// in the plane of its side of the cube and the neighbouring leaves on that side cover the whole side. Neighbours are
+/// found across octant and level boundaries by passing the neighbours of each cube down while descending the octree.
+///
+/// Faces are merged by greedy meshing: the faces of each plane, direction and size are placed on a grid of their size,
+/// and every face which has not been merged yet is extended first along the one and then along the other axis of the
+/// plane as far as possible. Faces of different sizes are not merged with each other, so the grid never has more
+/// cells than faces.
+class Mesher {
+private:
+    /// The grid coordinates of faces which are merged, by face, plane, size and material.
+    using FaceGroups = std::map<std::tuple<std::size_t, float, float, std::uint16_t>,
+                                std::vector<std::pair<std::int32_t, std::int32_t>>>;
+
+    /// The options of the mesher.
+    MeshOptions options;
+
+    /// The statistics of the last octree.
+    MeshStatistics mesh_statistics;
+
+    /// The faces of the current octree which are merged after all leaves have been visited.
+    FaceGroups mergeable_faces;
+
+    /// The position of the current octree, the origin of the grids of the merged faces.
+    glm::vec3 origin = DEFAULT_CUBE_POSITION;
+
+    /// Mesh an octree.
+    /// @param cube The octree.
+    /// @param polygons The vector to append the polygons to.
+    template <typename Polygon>
+    void mesh(Cube &cube, std::vector<Polygon> &polygons);
+
+    /// Merge the collected faces and insert the polygons of the resulting rectangles.
+    /// @param polygons The vector to append the polygons to.
+    template <typename Polygon>
+    void merge(std::vector<Polygon> &polygons);
+
+    /// Insert the polygons of a cube.
+    /// @param cube The cube.
+    /// @param neighbours The neighbouring cubes of the same size or the neighbouring leaves of a larger size for each
+    /// face, nullptr outside of the octree.
+    /// @param polygons The vector to append the polygons to.
+    template <typename Polygon>
+    void insert(Cube &cube, const std::array<Cube *, 6> &neighbours, std::vector<Polygon> &polygons);
+
+public:
+    /// Number of faces of a cube.
+    static constexpr std::size_t FACES = 6;
+
+    /// Create a mesher.
+    /// @param options The options of the mesher.
+    explicit Mesher(const MeshOptions &options = {});
+
+    /// Get all polygons (triangles) of the visible faces of an octree.
+    /// @param cube The octree.
+    /// @return A vector which contains the three vertices representing a triangle.
+    [[nodiscard]] std::vector<std::array<glm::vec3, 3>> polygons(Cube &cube);
+
+    /// Get all polygons (triangles) of the visible faces of an octree with the attributes of their faces, which are
+    /// generated in the same pass. The positions are the same as those of Mesher::polygons.
+    /// @param cube The octree.
+    /// @return A vector which contains the three vertices representing a triangle.
+    [[nodiscard]] std::vector<std::array<MeshVertex, 3>> vertices(Cube &cube);
+
+    /// Get whether a face of a leaf lies in the plane of its side of the cube.
+    /// @param leaf The leaf.
+    /// @param face The face.
+    /// @return Whether the face lies in the plane of the side.
+    [[nodiscard]] static bool is_on_side(Cube &leaf, std::size_t face);
+
+    /// Get whether a side of a cube is completely covered.
+    /// @param cube The cube, may be nullptr.
+    /// @param face The side of the cube.
+    /// @return Whether the side is covered.
+    [[nodiscard]] static bool is_covered(Cube *cube, std::size_t face);
+
+    /// Get the normal of a face from its two polygons.
+    /// @param first The first polygon of the face.
+    /// @param second The second polygon of the face.
+    /// @param face The face, which gives the normal if the polygons are degenerated.
+    /// @return The normalized normal, pointing outwards.
+    [[nodiscard]] static glm::vec3 face_normal(const std::array<glm::vec3, 3> &first,
+                                               const std::array<glm::vec3, 3> &second, std::size_t face);
+
+    /// Get the planar texture coordinate of a position, which is projected along the main axis of the normal.
+    /// The vertex shader projects the position the same way.
+    /// @param position The position.
+    /// @param normal The normal of the face.
+    /// @return The texture coordinate.
+    [[nodiscard]] static glm::vec2 texture_coordinate(const glm::vec3 &position, const glm::vec3 &normal);
+
+    /// Get the statistics of the last octree which has been meshed.
+    /// @return The statistics.
+    [[nodiscard]] const MeshStatistics &statistics() const;
+};
+} // namespace inexor::vulkan_renderer::world
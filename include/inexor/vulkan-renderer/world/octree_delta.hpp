@@ -0,0 +1,78 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/world/cube.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace inexor::vulkan_renderer::world {
+/// The maximum depth of the cube which is changed by an OctreeDelta.
+constexpr std::size_t MAX_DELTA_DEPTH = 31;
+
+/// A change of an octree: the cube at a path is replaced together with its subtree.
+///
+/// The replacement is a leaf or a cube whose octants are all EMPTY or all FULL leaves, more complex subtrees are
+/// described by several deltas. A delta does not depend on the cube it replaces, so a later delta on the same path or
+/// on a path to an ancestor makes it obsolete (see compact_deltas).
+struct OctreeDelta {
+    /// The octants on the path from the root to the cube.
+    std::vector<std::size_t> path;
+
+    /// The type of the new cube.
+    CubeType type{CubeType::EMPTY};
+
+    /// The indentation levels of each corner if the new cube is CubeType::INDENTED.
+    std::array<glm::tvec3<std::uint8_t>, 8> levels{};
+
+    /// The type of the octants (CubeType::EMPTY or CubeType::FULL) if the new cube is CubeType::OCTANT.
+    CubeType octant_type{CubeType::EMPTY};
+
+    /// Create the new cube.
+    /// @param size The size of the replaced cube.
+    /// @param position The position of the replaced cube.
+    /// @return The new cube.
+    [[nodiscard]] Cube cube(float size, const glm::vec3 &position) const;
+};
+
+/// Encode deltas into a compact binary format.
+/// The number of deltas (32 bits) is followed by each delta: the depth of the path (5 bits), 3 bits per octant on the
+/// path, the type (2 bits) and the indentation levels in the format of Cube::serialize if the new cube is indented or
+/// the type of the octants (1 bit) if the new cube is split.
+/// @param deltas The deltas.
+/// @return The binary data.
+[[nodiscard]] std::vector<unsigned char> encode_deltas(const std::vector<OctreeDelta> &deltas);
+
+/// Decode deltas which have been encoded with encode_deltas.
+/// @param data The binary data.
+/// @return The deltas.
+[[nodiscard]] std::vector<OctreeDelta> decode_deltas(const std::vector<unsigned char> &data);
+
+/// Apply deltas to an octree in their order.
+/// The cubes are replaced in place by assigning to them, so subtrees which the octree shares with other octrees (e.g.
+/// copies or versions of an OctreeHistory) change in those as well. If the octree is reactive, its change journal is
+/// flushed once after all deltas have been applied, so that the subscribers (e.g. an IncrementalMesh) process the
+/// whole batch with a single remesh.
+/// @param root The octree.
+/// @param deltas The deltas.
+void apply_deltas(Cube &root, const std::vector<OctreeDelta> &deltas);
+
+/// Remove the deltas which are replaced by later ones on the same path or on the path to an ancestor.
+/// Applying the compacted deltas has the same result as applying all of them.
+/// @param deltas The deltas.
+/// @return The remaining deltas in their order.
+[[nodiscard]] std::vector<OctreeDelta> compact_deltas(const std::vector<OctreeDelta> &deltas);
+
+/// Get the deltas which change an octree into another one.
+/// Subtrees which both octrees share (e.g. versions of an OctreeHistory) are skipped, so the cost is proportional to
+/// the changes rather than to the size of the octrees in that case.
+/// @param before The octree before the changes.
+/// @param after The octree after the changes, which has the size and position of before.
+/// @return The deltas.
+[[nodiscard]] std::vector<OctreeDelta> diff_octrees(const std::shared_ptr<Cube> &before,
+                                                    const std::shared_ptr<Cube> &after);
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/world/cube.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace inexor::vulkan_renderer::world {
+/// The parameters of a randomly generated octree.
+struct GeneratorSettings {
+    /// The seed of the random numbers, the same settings always generate the same octree.
+    std::uint32_t seed{0};
+
+    /// The number of levels to subdivide at most.
+    std::uint32_t depth{5};
+
+    /// The probability that a point of the octree is within a leaf which is not empty.
+    float fill_ratio{0.5f};
+
+    /// The probability that a leaf which is not empty is indented, with random indentations.
+    float indentation_probability{0.25f};
+
+    /// How much neighbouring cubes resemble each other, between 0 (independent leaves on the deepest level) and 1 (a
+    /// single leaf). It is the probability that a cube is not subdivided further as well as the probability that an
+    /// octant has the type of its parent instead of a new random one.
+    float coherence{0.0f};
+};
+
+/// Generate the binary data of a random octree in the format which is read by Cube::parse.
+/// Each cube has a type which is either inherited from its parent or drawn with the fill ratio. A cube becomes a leaf
+/// of its type when it is not subdivided further, so the fill ratio holds for any coherence in expectation.
+/// The output sequence of std::mt19937 is fixed by the standard and the distributions are implemented locally, so the
+/// data is the same with all standard libraries.
+/// @param settings The parameters of the octree.
+/// @return The binary data of the octree.
+[[nodiscard]] std::vector<unsigned char> generate_octree_data(const GeneratorSettings &settings);
+
+/// Generate a random octree of size 1, see generate_octree_data.
+/// @param settings The parameters of the octree.
+/// @return The octree.
+[[nodiscard]] Cube generate_octree(const GeneratorSettings &settings);
+} // namespace inexor::vulkan_renderer::world
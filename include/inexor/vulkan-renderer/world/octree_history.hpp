@@ -0,0 +1,76 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/world/cube.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace inexor::vulkan_renderer::world {
+/// A persistent octree: every edit creates a new version, which shares all unchanged subtrees with the previous one.
+///
+/// An edit copies only the cubes on the path from the root to the edited cube, the copies point to the same octants as
+/// the originals apart from the one on the path. Versions are never changed after they have been created, so the
+/// mesher or culling jobs can read a snapshot on another thread while the edit thread keeps going. The previous
+/// versions form the undo history, which costs one path of cubes per edit.
+///
+/// Edits, undo and redo must happen on one thread, snapshots can be taken from any thread.
+class OctreeHistory {
+private:
+    /// The current version.
+    std::shared_ptr<Cube> current;
+
+    /// Protects the current version, which is read by other threads.
+    mutable std::mutex current_mutex;
+
+    /// The versions before the current one, the most recent one last.
+    std::deque<std::shared_ptr<Cube>> undo_versions;
+
+    /// The versions which have been undone, the most recently undone one last.
+    std::vector<std::shared_ptr<Cube>> redo_versions;
+
+    /// The maximum number of versions before the current one which are kept.
+    std::size_t max_undo;
+
+    /// Replace the current version.
+    /// @param version The new version.
+    void publish(std::shared_ptr<Cube> version);
+
+public:
+    /// Create a history with a copy of an octree as its first version.
+    /// @param root The octree, which is copied completely.
+    /// @param max_undo The maximum number of versions before the current one which are kept.
+    explicit OctreeHistory(Cube &root, std::size_t max_undo = 256);
+
+    OctreeHistory(const OctreeHistory &) = delete;
+    OctreeHistory &operator=(const OctreeHistory &) = delete;
+
+    /// Get the current version of the octree.
+    /// The version stays valid and unchanged while the snapshot is kept, it must not be changed by the caller.
+    /// @return The root of the current version.
+    [[nodiscard]] std::shared_ptr<Cube> snapshot() const;
+
+    /// Replace a cube of the octree, creating a new version. Versions which have been undone are discarded.
+    /// @param path The octants on the path from the root to the cube, empty for the root.
+    /// @param cube The new cube with the size and position of the replaced one, which is copied completely.
+    void assign(const std::vector<std::size_t> &path, Cube &cube);
+
+    /// Go back to the previous version.
+    /// @return Whether there was a previous version.
+    bool undo();
+
+    /// Go forward to the version which has been undone last.
+    /// @return Whether there was a version which has been undone.
+    bool redo();
+
+    /// Get the number of versions which can be undone.
+    /// @return The number of versions.
+    [[nodiscard]] std::size_t undo_count() const;
+
+    /// Get the number of versions which can be redone.
+    /// @return The number of versions.
+    [[nodiscard]] std::size_t redo_count() const;
+};
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,306 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/world/bit_stream.hpp"
+#include "inexor/vulkan-renderer/world/cube.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace inexor::vulkan_renderer::world {
+class OctreePool;
+
+/// A lightweight, copyable view onto one cube of an OctreePool.
+/// Provides the read-only part of the Cube API, type, position and size of the cube are taken from its parent while
+/// descending.
+class CubeView {
+private:
+    /// The pool the cube lives in.
+    const OctreePool *pool = nullptr;
+
+    /// The type of the cube.
+    CubeType cube_type = CubeType::EMPTY;
+
+    /// Index of the cube in the pool of its type (nodes or indentations), unused for CubeType::EMPTY and
+    /// CubeType::FULL.
+    std::uint32_t node = 0;
+
+    /// The maximum size of the cube.
+    float cube_size = 0;
+
+    /// The position of the cube in the coordinate system.
+    glm::vec3 cube_position = {0.0f, 0.0f, 0.0f};
+
+public:
+    /// Create a view onto a cube of an octree pool.
+    /// @param pool The pool the cube lives in.
+    /// @param type The type of the cube.
+    /// @param node The index of the cube in the pool of its type.
+    /// @param size The maximum size of the cube.
+    /// @param position The position of the cube in the coordinate system.
+    CubeView(const OctreePool *pool, CubeType type, std::uint32_t node, float size, const glm::vec3 &position);
+
+    /// Get the index of the cube in the pool of its type (nodes or indentations).
+    /// @return index of the cube, 0 for CubeType::EMPTY and CubeType::FULL.
+    [[nodiscard]] std::uint32_t index() const;
+
+    /// Get the type of the cube.
+    /// @return type of the cube.
+    [[nodiscard]] CubeType type() const;
+
+    /// Get the maximum size of the cube.
+    /// @return size of the cube.
+    [[nodiscard]] float size() const;
+
+    /// Get the position of the cube in the coordinate system.
+    /// @return position of the cube.
+    [[nodiscard]] glm::vec3 position() const;
+
+    /// Get one octant of this cube (only when it is of CubeType::OCTANT).
+    /// @param octant The octant to get, ordered like Cube::octants.
+    /// @return view onto the octant.
+    [[nodiscard]] CubeView octant(std::size_t octant) const;
+
+    /// Get all octants of this cube (only when it is of CubeType::OCTANT).
+    /// @return views onto the octants, ordered like Cube::octants.
+    [[nodiscard]] std::array<CubeView, 8> octants() const;
+
+    /// Get the indentation levels for each corner of the cube (only when it is of CubeType::INDENTED).
+    /// @return The indentation levels of each corner, ordered like Cube::indentations.
+    [[nodiscard]] std::array<glm::tvec3<std::uint8_t>, 8> indentation_levels() const;
+
+    /// Get the number of leaves, this octree contains.
+    /// Leaves are cubes of CubeType::INDENTED or CubeTYPE::FULL.
+    /// @return Number of leaves, this octree contains.
+    [[nodiscard]] std::uint64_t leaves() const;
+
+    /// Get all polygons (triangles) of each cube of this octree.
+    /// @return A vector which contains the three vertices representing a triangle.
+    [[nodiscard]] std::vector<std::array<glm::vec3, 3>> polygons() const;
+
+    /// Append all polygons (triangles) of each cube of this octree to a buffer.
+    /// @param polygons The buffer to append the polygons to.
+    void polygons(std::vector<std::array<glm::vec3, 3>> &polygons) const;
+};
+
+/// An octree which stores all of its cubes in contiguous pools with a compact encoding instead of one heap allocation
+/// per cube.
+///
+/// Only cubes of CubeType::OCTANT are stored as nodes. A node holds the types of its 8 octants with 2 bits each, so
+/// octants of CubeType::EMPTY and CubeType::FULL take no memory of their own. The octants of a node of CubeType::OCTANT
+/// lie next to each other in the node pool, the ones of CubeType::INDENTED next to each other in the indentation pool.
+/// A node only stores the index of its first octant in each pool, an octant is found by counting the octants of the
+/// same type before it. The indentation levels of a cube are packed into 4 bits per level. No geometry is stored, the
+/// polygons are generated on demand.
+///
+/// Identical subtrees can share their storage (sparse voxel DAG): the octants of a node are stored as one run in each
+/// pool, identical runs are stored once, so identical subtrees get identical nodes and only the node itself is stored
+/// for every occurrence. Subtrees are shared during parsing or afterwards by OctreePool::share_subtrees. Views, meshing
+/// and queries work the same on shared subtrees. Edits copy the nodes on the path to the edited cube instead of
+/// changing them (copy-on-write), so the other occurrences of a shared subtree are not affected.
+class OctreePool {
+public:
+    /// The indentation levels of a cube: one word per axis, the level of corner i takes the bits 4i to 4i+3.
+    using PackedIndentations = std::array<std::uint32_t, 3>;
+
+private:
+    /// A cube of CubeType::OCTANT.
+    struct Node {
+        /// Index of the first octant of CubeType::OCTANT in the node pool.
+        std::uint32_t octants;
+
+        /// Index of the first octant of CubeType::INDENTED in the indentation pool.
+        std::uint32_t indentations;
+
+        /// The types of the octants, octant i takes the bits 2i and 2i+1.
+        std::uint16_t types;
+
+        bool operator==(const Node &other) const;
+    };
+
+    /// Hash of the content of a node.
+    struct NodeHash {
+        std::size_t operator()(const Node &node) const;
+    };
+
+    /// The runs of octants which are stored in the pools, used to share identical runs.
+    struct RunIndex;
+
+    /// All cubes of CubeType::OCTANT, the octants of a node lie before it.
+    std::vector<Node> nodes;
+
+    /// Indentation levels of all cubes of CubeType::INDENTED.
+    std::vector<PackedIndentations> indentation_pool;
+
+    /// The type of the root cube.
+    CubeType root_type = CubeType::EMPTY;
+
+    /// Index of the root cube in the pool of its type.
+    std::uint32_t root_index = 0;
+
+    /// The maximum size of the root cube.
+    float root_size = DEFAULT_CUBE_SIZE;
+
+    /// The position of the root cube in the coordinate system.
+    glm::vec3 root_position = DEFAULT_CUBE_POSITION;
+
+    /// The number of cubes of CubeType::OCTANT in the octree, shared subtrees are counted for every occurrence.
+    /// Updated while parsing, copying and assigning cubes, so that OctreePool::node_count does not traverse the octree.
+    std::size_t octree_nodes = 0;
+
+    /// Append the octants of a node to the pools.
+    /// @param octant_nodes The octants of CubeType::OCTANT.
+    /// @param octant_count The number of octants of CubeType::OCTANT.
+    /// @param octant_indentations The octants of CubeType::INDENTED.
+    /// @param indented_count The number of octants of CubeType::INDENTED.
+    /// @param types The types of the octants.
+    /// @param index The runs to share the octants with, nullptr to append them.
+    /// @return The node, which is not appended yet.
+    Node append(const std::array<Node, 8> &octant_nodes, std::size_t octant_count,
+                const std::array<PackedIndentations, 8> &octant_indentations, std::size_t indented_count,
+                std::uint16_t types, RunIndex *index);
+
+    /// Parse the octants of a cube of CubeType::OCTANT from a BitStream.
+    /// The subtrees of the octants are appended to the pools first, then the octants themselves.
+    /// @param stream The BitStream to parse the octants from.
+    /// @param index The runs to share the octants with, nullptr to append them.
+    /// @return The node of the cube, which is not appended yet.
+    Node parse_node(BitStream &stream, RunIndex *index);
+
+    /// Copy the octants of a Cube of CubeType::OCTANT like OctreePool::parse_node.
+    /// @param cube The cube to copy.
+    /// @param index The runs to share the octants with, nullptr to append them.
+    /// @return The node of the cube, which is not appended yet.
+    Node copy_node(Cube &cube, RunIndex *index);
+
+    /// Copy the octants of a node of another pool like OctreePool::parse_node.
+    /// @param source The pool to copy from.
+    /// @param node The node to copy.
+    /// @param index The runs to share the octants with, nullptr to append them.
+    /// @param copies The nodes which have been copied already, subtrees which are shared in the source stay shared.
+    /// @return The node, which is not appended yet.
+    Node copy_node(const OctreePool &source, const Node &node, RunIndex *index,
+                   std::unordered_map<Node, Node, NodeHash> &copies);
+
+    /// Copy the octants of a node and replace one of them.
+    /// @param node The index of the node.
+    /// @param octant The octant to replace.
+    /// @param type The type of the new octant.
+    /// @param octant_node The new octant if it is of CubeType::OCTANT.
+    /// @param indentations The new octant if it is of CubeType::INDENTED.
+    /// @return The copy of the node, which is not appended yet.
+    Node replace(std::uint32_t node, std::size_t octant, CubeType type, const Node &octant_node,
+                 const PackedIndentations &indentations);
+
+    /// Count the cubes of CubeType::OCTANT and CubeType::INDENTED in the subtree of a node, including the node itself.
+    /// Shared subtrees are counted for every occurrence, but traversed only once.
+    /// @param node The node to count the cubes of.
+    /// @return The number of cubes of CubeType::OCTANT and the number of cubes of CubeType::INDENTED.
+    [[nodiscard]] std::pair<std::size_t, std::size_t> count_cubes(const Node &node) const;
+
+    /// Copy the octree which is reachable from the root into new pools.
+    /// @param share Whether identical subtrees share their storage.
+    void rebuild(bool share);
+
+public:
+    /// Create an octree pool with a single empty root node.
+    /// @param size The maximum size of the root cube.
+    /// @param position The position of the root cube in the coordinate system.
+    explicit OctreePool(float size = DEFAULT_CUBE_SIZE, const glm::vec3 &position = DEFAULT_CUBE_POSITION);
+
+    /// Copy an octree made of Cube objects into a pool.
+    /// @param cube The root cube of the octree.
+    /// @param share Whether identical subtrees share their storage.
+    explicit OctreePool(Cube &cube, bool share = false);
+
+    /// Parse an octree from binary data.
+    /// @param data The data to parse the octree from.
+    /// @param share Whether identical subtrees share their storage.
+    /// @return OctreePool representing the cubes / octrees from the data.
+    static OctreePool parse(std::vector<unsigned char> &data, bool share = false);
+
+    /// Parse an octree from a BitStream, data which ends before the octree is complete throws std::runtime_error.
+    /// @param stream The BitStream to parse the octree from.
+    /// @param size The maximum size of the root cube.
+    /// @param position The position of the root cube in the coordinate system.
+    /// @param share Whether identical subtrees share their storage.
+    /// @return OctreePool representing the cubes / octrees from the stream.
+    static OctreePool parse(BitStream &stream, float size = DEFAULT_CUBE_SIZE,
+                            const glm::vec3 &position = DEFAULT_CUBE_POSITION, bool share = false);
+
+    /// Get a view onto the root cube.
+    /// @return view onto the root cube.
+    [[nodiscard]] CubeView root() const;
+
+    /// Get the type of an octant of a node.
+    /// @param node The index of the node.
+    /// @param octant The octant, ordered like Cube::octants.
+    /// @return type of the octant.
+    [[nodiscard]] CubeType type(std::uint32_t node, std::size_t octant) const;
+
+    /// Get the index of an octant of a node in the pool of its type.
+    /// @param node The index of the node.
+    /// @param octant The octant (of CubeType::OCTANT or CubeType::INDENTED), ordered like Cube::octants.
+    /// @return index of the octant in the node pool or the indentation pool.
+    [[nodiscard]] std::uint32_t child(std::uint32_t node, std::size_t octant) const;
+
+    /// Get the indentation levels of a cube of CubeType::INDENTED.
+    /// @param index The index of the cube in the indentation pool.
+    /// @return indentation levels of each corner.
+    [[nodiscard]] std::array<glm::tvec3<std::uint8_t>, 8> indentation_levels(std::uint32_t index) const;
+
+    /// Get the number of cubes in the octree, which is kept up to date instead of counting the cubes.
+    /// @return number of cubes.
+    [[nodiscard]] std::size_t node_count() const;
+
+    /// Get the memory which is used by the pools.
+    /// @return used memory in bytes.
+    [[nodiscard]] std::size_t memory_usage() const;
+
+    /// Release unused capacity of the pools.
+    void shrink_to_fit();
+
+    /// Replace a cube of the octree. Nodes on the path to the cube are copied, shared subtrees are not changed.
+    /// The copied nodes stay in the pools until OctreePool::compact or OctreePool::share_subtrees is called.
+    /// @param path The octants on the path from the root to the cube, empty for the root.
+    /// @param cube The new cube, its size and position are ignored.
+    void assign(const std::vector<std::size_t> &path, Cube &cube);
+
+    /// Let identical subtrees share their storage and drop nodes which are not reachable from the root anymore.
+    /// Invalidates the indices of views onto the pool.
+    void share_subtrees();
+
+    /// Drop nodes which are not reachable from the root anymore, subtrees which are shared stay shared.
+    /// Invalidates the indices of views onto the pool.
+    void compact();
+
+    /// Statistics about the storage of the octree.
+    struct Statistics {
+        /// The number of cubes of CubeType::OCTANT in the octree, shared subtrees are counted for every occurrence.
+        std::size_t octree_nodes = 0;
+
+        /// The number of cubes of CubeType::INDENTED in the octree, shared subtrees are counted for every occurrence.
+        std::size_t octree_indentations = 0;
+
+        /// The number of nodes in the node pool, including the ones which are not reachable anymore.
+        std::size_t stored_nodes = 0;
+
+        /// The number of entries in the indentation pool, including the ones which are not reachable anymore.
+        std::size_t stored_indentations = 0;
+
+        /// Get how much memory sharing saves: the size of the octree without sharing divided by the size of the pools.
+        /// Nodes and indentations take the same memory, so the ratio of the counts is the ratio of the memory.
+        /// @return The deduplication ratio, 1 if nothing is shared.
+        [[nodiscard]] double ratio() const;
+    };
+
+    /// Get statistics about the storage of the octree.
+    /// @return The statistics.
+    [[nodiscard]] Statistics statistics() const;
+};
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+
+#include <array>
+#include <cstdint>
+
+namespace inexor::vulkan_renderer::world {
+/// The number of levels below a chunk whose vertices are quantized without loss.
+/// The vertices of a cube are on a grid of its size divided by MAX_INDENTATION, which needs 3 more bits.
+constexpr std::uint32_t QUANTIZATION_DEPTH = 12;
+
+/// Quantization of the vertex positions within a chunk (an octree) to 16 bit per axis.
+/// The positions of cubes up to QUANTIZATION_DEPTH levels below the chunk are represented exactly, positions of deeper
+/// cubes are rounded to the closest step.
+struct PositionQuantization {
+    /// The position of the step 0.
+    glm::vec3 origin{0.0f};
+
+    /// The distance between two steps.
+    float step{1.0f};
+
+    /// Get the quantization of the positions within a chunk.
+    /// @param size The size of the chunk.
+    /// @param position The position of the chunk.
+    /// @return The quantization.
+    [[nodiscard]] static PositionQuantization for_chunk(float size, const glm::vec3 &position);
+
+    /// Quantize a position, positions outside of the chunk are clamped.
+    /// @param position The position.
+    /// @return The steps along each axis.
+    [[nodiscard]] std::array<std::uint16_t, 3> encode(const glm::vec3 &position) const;
+
+    /// Get the position of quantized steps.
+    /// @param steps The steps along each axis.
+    /// @return The position.
+    [[nodiscard]] glm::vec3 decode(const std::array<std::uint16_t, 3> &steps) const;
+};
+
+/// Encode a normal with the octahedral mapping into two signed normalized 16 bit values.
+/// The normal is projected onto an octahedron, whose lower half is folded over its upper half.
+/// @param normal The normal, which does not need to be normalized. A zero vector is encoded as (0, 0, 1).
+/// @return The encoded normal.
+[[nodiscard]] std::array<std::int16_t, 2> encode_normal(const glm::vec3 &normal);
+
+/// Decode a normal which has been encoded with encode_normal, the counterpart of decode_normal in the vertex shader.
+/// @param encoded The encoded normal.
+/// @return The normalized normal.
+[[nodiscard]] glm::vec3 decode_normal(const std::array<std::int16_t, 2> &encoded);
+} // namespace inexor::vulkan_renderer::world
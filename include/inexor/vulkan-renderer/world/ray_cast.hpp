@@ -0,0 +1,64 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/world/cube.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace inexor {
+class ThreadPool;
+} // namespace inexor
+
+namespace inexor::vulkan_renderer::world {
+/// A ray, distances along the ray are measured in multiples of the length of its direction.
+struct Ray {
+    /// The point the ray starts at.
+    glm::vec3 origin;
+
+    /// The direction of the ray, must not be zero.
+    glm::vec3 direction;
+};
+
+/// The first intersection of a ray with the surface of an octree.
+struct RayHit {
+    /// The leaf (CubeType::FULL or CubeType::INDENTED) which has been hit.
+    Cube *leaf;
+
+    /// The face of the leaf which has been hit, in the order of Cube::polygons: lower x, higher x, lower y, higher y,
+    /// lower z, higher z.
+    std::size_t face;
+
+    /// The point of intersection.
+    glm::vec3 point;
+
+    /// The distance from the origin of the ray to the point of intersection.
+    float distance;
+};
+
+/// Cast a ray against an octree.
+/// The octree is traversed front to back, only octants whose bounds are intersected closer than the current hit are
+/// visited. Full leaves are intersected with their bounds, indented leaves with their polygons. Faces are hit from
+/// both sides, so a ray which starts within a leaf hits the face it leaves the leaf through.
+/// @param cube The octree.
+/// @param ray The ray.
+/// @param max_distance The maximum distance of a hit.
+/// @return The first hit along the ray, std::nullopt if nothing is hit.
+[[nodiscard]] std::optional<RayHit> ray_cast(Cube &cube, const Ray &ray,
+                                             float max_distance = std::numeric_limits<float>::infinity());
+
+/// Cast rays against an octree in parallel, the octree must not change until all rays are cast.
+/// @param cube The octree.
+/// @param rays The rays.
+/// @param thread_pool The thread pool to cast the rays on.
+/// @param max_distance The maximum distance of a hit.
+/// @param batch_size The number of rays which are cast by one task.
+/// @return The first hit along each ray, in the order of the rays.
+[[nodiscard]] std::vector<std::optional<RayHit>> ray_cast(Cube &cube, const std::vector<Ray> &rays,
+                                                          ThreadPool &thread_pool,
+                                                          float max_distance = std::numeric_limits<float>::infinity(),
+                                                          std::size_t batch_size = 1024);
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/world/bit_stream.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace inexor::vulkan_renderer::world {
+/// The bit offsets of the upper nodes of a binary octree.
+/// The position of an octant in the stream is only known after all octants before it have been read. With the
+/// offsets, the subtrees below index depth can be parsed independently of each other (e.g. on a ThreadPool).
+/// The offsets can either be built with a fast pre-pass over the stream, or be stored next to the octree data.
+class SubtreeIndex {
+private:
+    /// The deepest level which is indexed, the root has depth 0.
+    std::uint32_t index_depth = 0;
+
+    /// Bit offsets of all nodes up to the index depth in the order they appear in the stream.
+    std::vector<std::size_t> node_offsets;
+
+    /// Collect the offsets of a node and its children up to the index depth, skip everything below.
+    /// @param stream The BitStream positioned at the node.
+    /// @param stream_bits The number of bits of the whole stream.
+    /// @param depth The depth of the node.
+    /// @return Whether the subtree was complete.
+    bool collect(BitStream &stream, std::size_t stream_bits, std::uint32_t depth);
+
+public:
+    SubtreeIndex() = default;
+
+    /// Create an index from offsets which have been stored before.
+    /// @param depth The deepest level which is indexed.
+    /// @param offsets Bit offsets of all nodes up to the index depth in the order they appear in the stream.
+    SubtreeIndex(std::uint32_t depth, std::vector<std::size_t> offsets);
+
+    /// Build the index of an octree with a pre-pass over its binary data, no nodes are created.
+    /// @param data The binary data of the octree.
+    /// @param byte_size The size of the data in bytes.
+    /// @param depth The deepest level to index.
+    /// @return The index, std::nullopt if the data ended before the octree was complete.
+    static std::optional<SubtreeIndex> build(const unsigned char *data, std::size_t byte_size, std::uint32_t depth);
+
+    /// Skip a whole subtree of a binary octree.
+    /// @param stream The BitStream positioned at the subtree.
+    /// @return Whether the subtree was complete.
+    static bool skip(BitStream &stream);
+
+    /// Get the deepest level which is indexed.
+    /// @return index depth.
+    [[nodiscard]] std::uint32_t depth() const;
+
+    /// Get the bit offsets of all nodes up to the index depth in the order they appear in the stream.
+    /// @return bit offsets.
+    [[nodiscard]] const std::vector<std::size_t> &offsets() const;
+};
+} // namespace inexor::vulkan_renderer::world
@@ -62,6 +62,10 @@ public:
         return buffer;
     }
 
+    [[nodiscard]] VkDeviceSize get_buffer_size() const {
+        return buffer_size;
+    }
+
     [[nodiscard]] const VmaAllocation get_allocation() const {
         return allocation;
     }
@@ -34,6 +34,10 @@ private:
 
     std::uint32_t number_of_vertices = 0;
 
+    VkDeviceSize size_of_vertex_structure = 0;
+
+    VkDeviceSize size_of_index_structure = 0;
+
     std::uint32_t number_of_indices = 0;
 
     // Don't forget that index buffers are optional!
@@ -49,6 +53,7 @@ public:
     MeshBuffer &operator=(MeshBuffer &&) noexcept = default;
 
     /// @brief Creates a new vertex buffer and an associated index buffer.
+    /// @note The size of the index structure has to be 2 or 4 bytes (VK_INDEX_TYPE_UINT16 or VK_INDEX_TYPE_UINT32).
     MeshBuffer(const VkDevice device, VkQueue data_transfer_queue, const std::uint32_t data_transfer_queue_family_index,
                const VmaAllocator vma_allocator, const std::string &name, const VkDeviceSize size_of_vertex_structure,
                const std::size_t number_of_vertices, void *vertices, const VkDeviceSize size_of_index_structure,
@@ -82,9 +87,10 @@ public:
         return number_of_indices;
     }
 
-    // TODO: Update data!
-    // void update_vertex_buffer();
-    // void update_index_buffer();
+    [[nodiscard]] VkIndexType get_index_type() const {
+        assert(index_buffer);
+        return size_of_index_structure == sizeof(std::uint16_t) ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+    }
 };
 
 } // namespace inexor::vulkan_renderer::wrapper
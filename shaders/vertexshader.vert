@@ -4,17 +4,39 @@ layout(binding = 0) uniform UniformBufferObject {
     mat4 model;
     mat4 view;
     mat4 proj;
+    vec4 dequantization;
 } ubo;
 
-layout(location = 0) in vec3 inPosition;
-layout(location = 1) in vec3 inColor;
-layout(location = 2) in vec2 inTexCoord;
+// The quantized position (xyz) and the palette index (w).
+layout(location = 0) in uvec4 inPosition;
+// The octahedral encoded normal.
+layout(location = 1) in vec2 inNormal;
 
 layout(location = 0) out vec3 fragColor;
 layout(location = 1) out vec2 fragTexCoord;
 
+const vec3 palette[16] = vec3[](
+    vec3(0.90, 0.90, 0.90), vec3(0.60, 0.60, 0.60), vec3(0.35, 0.35, 0.35), vec3(0.55, 0.40, 0.25),
+    vec3(0.75, 0.60, 0.40), vec3(0.30, 0.55, 0.25), vec3(0.45, 0.70, 0.30), vec3(0.20, 0.40, 0.65),
+    vec3(0.40, 0.60, 0.85), vec3(0.80, 0.30, 0.25), vec3(0.90, 0.55, 0.20), vec3(0.95, 0.85, 0.35),
+    vec3(0.55, 0.35, 0.65), vec3(0.85, 0.50, 0.65), vec3(0.30, 0.65, 0.65), vec3(0.15, 0.15, 0.20)
+);
+
+// Counterpart of world::decode_normal.
+vec3 decode_normal(vec2 encoded) {
+    vec3 normal = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float fold = max(-normal.z, 0.0);
+    normal.x += normal.x >= 0.0 ? -fold : fold;
+    normal.y += normal.y >= 0.0 ? -fold : fold;
+    return normalize(normal);
+}
+
 void main() {
-    gl_Position = ubo.proj * ubo.view * ubo.model * vec4(inPosition, 1.0);
-    fragColor = inColor;
-    fragTexCoord = inTexCoord;
+    vec3 position = ubo.dequantization.xyz + vec3(inPosition.xyz) * ubo.dequantization.w;
+    vec3 normal = decode_normal(inNormal);
+    gl_Position = ubo.proj * ubo.view * ubo.model * vec4(position, 1.0);
+    fragColor = palette[inPosition.w % 16u];
+    // Planar texture coordinates, projected along the main axis of the normal (see world::Mesher::texture_coordinate).
+    vec3 axis = abs(normal);
+    fragTexCoord = axis.x >= axis.y && axis.x >= axis.z ? position.zy : (axis.y >= axis.z ? position.xz : position.xy);
 }
@@ -2,15 +2,15 @@
 
 #include "inexor/vulkan-renderer/debug_callback.hpp"
 #include "inexor/vulkan-renderer/error_handling.hpp"
-#include "inexor/vulkan-renderer/octree_vertex.hpp"
 #include "inexor/vulkan-renderer/standard_ubo.hpp"
 #include "inexor/vulkan-renderer/tools/cla_parser.hpp"
-#include "inexor/vulkan-renderer/world/cube.hpp"
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <spdlog/spdlog.h>
 #include <toml11/toml.hpp>
 
+#include <cstring>
+
 namespace inexor::vulkan_renderer {
 
 /// @brief Static callback for window resize events.
@@ -204,6 +204,20 @@ VkResult Application::render_frame() {
         exit(-1);
     }
 
+    // Wait until the image is no longer used by an earlier frame, so that its command buffer can be recorded again.
+    if (images_in_flight[image_index] != nullptr) {
+        images_in_flight[image_index]->block();
+    }
+    images_in_flight[image_index] = &in_flight_fences[current_frame];
+
+    // The staging buffer of this frame is not in use anymore.
+    stage_octree_mesh_updates(current_frame);
+
+    VkResult record_result = update_octree_visibility(image_index);
+    if (record_result != VK_SUCCESS) {
+        return record_result;
+    }
+
     const VkPipelineStageFlags wait_stage_mask[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
 
     submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -219,6 +233,11 @@ VkResult Application::render_frame() {
     in_flight_fences[current_frame].reset();
 
     result = vkQueueSubmit(vkdevice->get_graphics_queue(), 1, &submit_info, in_flight_fences[current_frame].get());
+
+    // The copies into the mesh buffer are part of the submitted command buffer, the next one must not repeat them.
+    vertex_buffer_copies.clear();
+    index_buffer_copies.clear();
+
     if (result != VK_SUCCESS) {
         return result;
     }
@@ -260,41 +279,161 @@ VkResult Application::load_octree_geometry() {
 
     std::vector<unsigned char> test = {0xC4, 0x52, 0x03, 0xC0, 0x00, 0x00};
 
-    world::Cube cube = world::Cube::parse(test);
-    cube.make_reactive();
+    octree = std::make_shared<world::Cube>(world::Cube::parse(test));
+    octree_quantization = world::PositionQuantization::for_chunk(octree->size(), octree->position());
+    // Grass on top, soil below and on the sides (indices into the palette of the vertex shader).
+    world::MeshOptions mesh_options;
+    mesh_options.material = [](world::Cube & /*leaf*/, std::size_t face) -> std::uint16_t {
+        constexpr std::size_t UPPER_SIDE = 3;
+        return face == UPPER_SIDE ? 6 : 3;
+    };
+    octree_mesh = std::make_unique<world::IncrementalMesh>(octree, world::LodOptions{}, mesh_options);
+
+    octree->journal()->subscribe([](const std::vector<world::Cube *> &cubes) {
+        spdlog::debug("THE WORLD (octree) HAS CHANGED! {} cubes changed.", cubes.size());
+    });
+
+    octree->octants.value()[6]->indentations.value()[4].set_z(4);
+    octree->octants.value()[6]->indentations.value()[4] += {1, 1, -3};
+
+    octree_mesh->update();
+    create_octree_mesh_buffer();
 
-    cube.on_change.connect([](world::Cube *c) { spdlog::debug("THE WORLD (octree) HAS CHANGED!"); });
+    return VK_SUCCESS;
+}
+
+void Application::create_octree_mesh_buffer() {
+    world::IndexedMesh mesh = octree_mesh->indexed({0, octree_mesh->polygons().size()});
+    std::vector<OctreeVertex> octree_vertices = generate_octree_vertices(mesh);
 
-    cube.octants.value()[6]->indentations.value()[4].set_z(4);
-    cube.octants.value()[6]->indentations.value()[4] += {1, 1, -3};
+    const std::string octree_mesh_name = "unnamed octree";
+
+    // The octree mesh is the only mesh buffer, it is destroyed before the new one is created.
+    mesh_buffers.clear();
 
-    std::vector<std::array<glm::vec3, 3>> polygons = cube.polygons();
+    // Create a mesh buffer for octree vertex geometry, with 16 bit indices if possible.
+    if (mesh.has_16_bit_indices()) {
+        std::vector<std::uint16_t> indices = mesh.indices_16_bit();
+        mesh_buffers.emplace_back(vkdevice->get_device(), vkdevice->get_transfer_queue(),
+                                  vkdevice->get_transfer_queue_family_index(), vma->get_allocator(), octree_mesh_name,
+                                  sizeof(OctreeVertex), octree_vertices.size(), octree_vertices.data(),
+                                  sizeof(std::uint16_t), indices.size(), indices.data());
+    } else {
+        mesh_buffers.emplace_back(vkdevice->get_device(), vkdevice->get_transfer_queue(),
+                                  vkdevice->get_transfer_queue_family_index(), vma->get_allocator(), octree_mesh_name,
+                                  sizeof(OctreeVertex), octree_vertices.size(), octree_vertices.data(),
+                                  sizeof(std::uint32_t), mesh.indices.size(), mesh.indices.data());
+    }
+}
+
+std::vector<OctreeVertex> Application::generate_octree_vertices(const world::IndexedMesh &mesh) {
     std::vector<OctreeVertex> octree_vertices;
-    octree_vertices.resize(polygons.size() * 3);
-    OctreeVertex *current_vertex = octree_vertices.data();
-
-    for (auto triangle : polygons) {
-        for (auto vertex : triangle) {
-            glm::vec3 color = {
-                static_cast<float>(rand()) / static_cast<float>(RAND_MAX),
-                static_cast<float>(rand()) / static_cast<float>(RAND_MAX),
-                static_cast<float>(rand()) / static_cast<float>(RAND_MAX),
-            };
-            *current_vertex = {vertex, color};
-            current_vertex++;
-        }
+    octree_vertices.reserve(mesh.vertices.size());
+
+    // The materials of the octree are the colors of the palette.
+    for (std::size_t i = 0; i < mesh.vertices.size(); i++) {
+        octree_vertices.push_back({octree_quantization.encode(mesh.vertices[i]), mesh.materials[i],
+                                   world::encode_normal(mesh.normals[i])});
     }
+    return octree_vertices;
+}
 
-    const std::string octree_mesh_name = "unnamed octree";
+VkResult Application::update_octree_geometry() {
+    // All edits of the last frame are passed to the subscribers of the octree at once.
+    octree->journal()->flush();
+    octree_mesh->update_level_of_detail(game_camera.position);
+    if (!octree_mesh->is_dirty()) {
+        return VK_SUCCESS;
+    }
 
-    // Create a mesh buffer for octree vertex geometry.
-    mesh_buffers.emplace_back(vkdevice->get_device(), vkdevice->get_transfer_queue(),
-                              vkdevice->get_transfer_queue_family_index(), vma->get_allocator(), octree_mesh_name,
-                              sizeof(OctreeVertex), octree_vertices.size(), octree_vertices.data());
+    const world::IncrementalMesh::Update update = octree_mesh->update();
+
+    if (update.rebuilt) {
+        // The size of the mesh may have changed, the mesh buffer and the command buffers are created again. The
+        // swapchain stays as it is, recreating it would reset the camera.
+        vkDeviceWaitIdle(vkdevice->get_device());
+        create_octree_mesh_buffer();
+        // The new mesh buffer contains the slots which have not been copied yet.
+        pending_octree_slots.clear();
+        visible_polygons = std::nullopt;
+        // The device is idle, so none of the swapchain images is in use.
+        images_in_flight.assign(swapchain->get_image_count(), nullptr);
+        return record_command_buffers();
+    }
+
+    // The mesh buffer is still read by the frames in flight, so the changed slots are copied into it by the command
+    // buffer of the next frame. A slot which changes again before that only keeps its latest version.
+    const std::size_t index_size =
+        mesh_buffers[0].get_index_type() == VK_INDEX_TYPE_UINT16 ? sizeof(std::uint16_t) : sizeof(std::uint32_t);
+    const std::size_t slot_index_bytes = world::IncrementalMesh::SLOT_SIZE * 3 * index_size;
+
+    for (const auto &range : update.ranges) {
+        const world::IndexedMesh mesh = octree_mesh->indexed(range);
+        const std::vector<OctreeVertex> octree_vertices = generate_octree_vertices(mesh);
+        std::vector<std::uint16_t> indices_16_bit;
+        const auto *indices = reinterpret_cast<const std::uint8_t *>(mesh.indices.data());
+        if (index_size == sizeof(std::uint16_t)) {
+            indices_16_bit = mesh.indices_16_bit();
+            indices = reinterpret_cast<const std::uint8_t *>(indices_16_bit.data());
+        }
+
+        // Each slot of the octree mesh has a fixed number of vertices and indices.
+        for (std::size_t i = 0; i < range.count / world::IncrementalMesh::SLOT_SIZE; i++) {
+            auto &slot = pending_octree_slots[range.first / world::IncrementalMesh::SLOT_SIZE + i];
+            const auto first_vertex = octree_vertices.begin() +
+                                      static_cast<std::ptrdiff_t>(i * world::IncrementalMesh::SLOT_VERTICES);
+            slot.vertices.assign(first_vertex, first_vertex + world::IncrementalMesh::SLOT_VERTICES);
+            slot.indices.assign(indices + i * slot_index_bytes, indices + (i + 1) * slot_index_bytes);
+        }
+    }
 
     return VK_SUCCESS;
 }
 
+void Application::stage_octree_mesh_updates(const std::size_t frame) {
+    if (pending_octree_slots.empty()) {
+        return;
+    }
+
+    const std::size_t slot_vertex_bytes = world::IncrementalMesh::SLOT_VERTICES * sizeof(OctreeVertex);
+    const std::size_t slot_index_bytes = pending_octree_slots.begin()->second.indices.size();
+    const std::size_t slot_count = pending_octree_slots.size();
+
+    // The vertices of all slots are staged first, followed by their indices, so that neighbouring slots are copied at
+    // once.
+    std::uint8_t *staging_data = map_mesh_staging_buffer(frame, slot_count * (slot_vertex_bytes + slot_index_bytes));
+    const VkDeviceSize first_index_byte = slot_count * slot_vertex_bytes;
+
+    std::size_t staged = 0;
+    std::size_t previous_slot = 0;
+    for (const auto &[slot, slot_update] : pending_octree_slots) {
+        const VkDeviceSize vertex_offset = staged * slot_vertex_bytes;
+        const VkDeviceSize index_offset = first_index_byte + staged * slot_index_bytes;
+        std::memcpy(staging_data + vertex_offset, slot_update.vertices.data(), slot_vertex_bytes);
+        std::memcpy(staging_data + index_offset, slot_update.indices.data(), slot_index_bytes);
+
+        if (staged > 0 && slot == previous_slot + 1) {
+            vertex_buffer_copies.back().size += slot_vertex_bytes;
+            index_buffer_copies.back().size += slot_index_bytes;
+        } else {
+            vertex_buffer_copies.push_back({vertex_offset, slot * slot_vertex_bytes, slot_vertex_bytes});
+            index_buffer_copies.push_back({index_offset, slot * slot_index_bytes, slot_index_bytes});
+        }
+        previous_slot = slot;
+        staged++;
+    }
+
+    pending_octree_slots.clear();
+}
+
+VkResult Application::update_octree_visibility(const std::size_t image_index) {
+    // The frustum is taken from the matrices the octree is drawn with, so it is in the coordinate system of the octree.
+    const world::Frustum frustum(octree_clip_matrix);
+    visible_polygons = octree_mesh->visible(frustum);
+
+    return record_command_buffer(image_index);
+}
+
 VkResult Application::load_models() {
     spdlog::debug("Loading models.");
 
@@ -573,6 +712,9 @@ VkResult Application::update_uniform_buffers(const std::size_t current_image) {
     ubo.view = game_camera.matrices.view;
     ubo.proj = game_camera.matrices.perspective;
     ubo.proj[1][1] *= -1;
+    ubo.dequantization = glm::vec4(octree_quantization.origin, octree_quantization.step);
+
+    octree_clip_matrix = ubo.proj * ubo.view * ubo.model;
 
     // TODO: Don't use vector of uniform buffers.
     uniform_buffers[0].update(&ubo, sizeof(ubo));
@@ -617,6 +759,7 @@ void Application::run() {
     while (!window->should_close()) {
         window->poll();
         render_frame();
+        update_octree_geometry();
 
         // TODO: Run this in a separated thread?
         // TODO: Merge into one update_game_data() method?
@@ -12,22 +12,18 @@ VkVertexInputBindingDescription OctreeVertex::get_vertex_binding_description() {
 }
 
 std::vector<VkVertexInputAttributeDescription> OctreeVertex::get_attribute_binding_description() {
-    std::vector<VkVertexInputAttributeDescription> vertex_input_attribute_description(3);
+    std::vector<VkVertexInputAttributeDescription> vertex_input_attribute_description(2);
 
+    // The quantized position and the palette index are read as one uvec4.
     vertex_input_attribute_description[0].location = 0;
     vertex_input_attribute_description[0].binding = 0;
-    vertex_input_attribute_description[0].format = VK_FORMAT_R32G32B32_SFLOAT;
-    vertex_input_attribute_description[0].offset = offsetof(OctreeVertex, pos);
+    vertex_input_attribute_description[0].format = VK_FORMAT_R16G16B16A16_UINT;
+    vertex_input_attribute_description[0].offset = offsetof(OctreeVertex, position);
 
     vertex_input_attribute_description[1].location = 1;
     vertex_input_attribute_description[1].binding = 0;
-    vertex_input_attribute_description[1].format = VK_FORMAT_R32G32B32_SFLOAT;
-    vertex_input_attribute_description[1].offset = offsetof(OctreeVertex, color);
-
-    vertex_input_attribute_description[2].location = 2;
-    vertex_input_attribute_description[2].binding = 0;
-    vertex_input_attribute_description[2].format = VK_FORMAT_R32G32_SFLOAT;
-    vertex_input_attribute_description[2].offset = offsetof(OctreeVertex, texture_coordinate);
+    vertex_input_attribute_description[1].format = VK_FORMAT_R16G16_SNORM;
+    vertex_input_attribute_description[1].offset = offsetof(OctreeVertex, normal);
 
     return vertex_input_attribute_description;
 }
@@ -6,6 +6,7 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <array>
 #include <fstream>
 
@@ -58,11 +59,23 @@ VkResult VulkanRenderer::create_command_buffers() {
 }
 
 VkResult VulkanRenderer::record_command_buffers() {
+    spdlog::debug("Recording command buffers.");
+
+    for (std::size_t i = 0; i < swapchain->get_image_count(); i++) {
+        spdlog::debug("Recording command buffer #{}.", i);
+
+        VkResult result = record_command_buffer(i);
+        if (VK_SUCCESS != result)
+            return result;
+    }
+
+    return VK_SUCCESS;
+}
+
+VkResult VulkanRenderer::record_command_buffer(const std::size_t image_index) {
     assert(window->get_width() > 0);
     assert(window->get_height() > 0);
 
-    spdlog::debug("Recording command buffers.");
-
     VkCommandBufferBeginInfo command_buffer_bi = {};
     command_buffer_bi.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
     command_buffer_bi.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
@@ -105,62 +118,131 @@ VkResult VulkanRenderer::record_command_buffers() {
     scissor.extent.width = window->get_width();
     scissor.extent.height = window->get_height();
 
-    for (std::size_t i = 0; i < swapchain->get_image_count(); i++) {
-        spdlog::debug("Recording command buffer #{}.", i);
+    VkCommandBuffer current_command_buffer = command_buffers[image_index].get();
 
-        VkCommandBuffer current_command_buffer = command_buffers[i].get();
+    // TODO: Start debug marker region.
 
-        // TODO: Start debug marker region.
+    VkResult result = vkBeginCommandBuffer(current_command_buffer, &command_buffer_bi);
+    if (VK_SUCCESS != result)
+        return result;
 
-        VkResult result = vkBeginCommandBuffer(current_command_buffer, &command_buffer_bi);
-        if (VK_SUCCESS != result)
-            return result;
+    if (!vertex_buffer_copies.empty() || !index_buffer_copies.empty()) {
+        // The copies wait for the earlier frames which still draw or copy the old parts of the mesh buffer, the draw
+        // calls of this frame wait for the copies.
+        VkMemoryBarrier previous_barrier = {};
+        previous_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        previous_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        previous_barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+        vkCmdPipelineBarrier(current_command_buffer,
+                             VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &previous_barrier, 0, nullptr, 0, nullptr);
 
-        // Update only the necessary parts of VkRenderPassBeginInfo.
-        render_pass_bi.framebuffer = framebuffer->get(i);
+        if (!vertex_buffer_copies.empty()) {
+            vkCmdCopyBuffer(current_command_buffer, mesh_staging_buffer, mesh_buffers[0].get_vertex_buffer(),
+                            static_cast<std::uint32_t>(vertex_buffer_copies.size()), vertex_buffer_copies.data());
+        }
+        if (!index_buffer_copies.empty()) {
+            vkCmdCopyBuffer(current_command_buffer, mesh_staging_buffer, *mesh_buffers[0].get_index_buffer(),
+                            static_cast<std::uint32_t>(index_buffer_copies.size()), index_buffer_copies.data());
+        }
+
+        VkMemoryBarrier copy_barrier = {};
+        copy_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        copy_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        copy_barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT;
+
+        vkCmdPipelineBarrier(current_command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                             0, 1, &copy_barrier, 0, nullptr, 0, nullptr);
+    }
 
-        vkCmdBeginRenderPass(current_command_buffer, &render_pass_bi, VK_SUBPASS_CONTENTS_INLINE);
+    // Update only the necessary parts of VkRenderPassBeginInfo.
+    render_pass_bi.framebuffer = framebuffer->get(image_index);
 
-        // ----------------------------------------------------------------------------------------------------------------
-        // Begin of render pass.
-        {
-            vkCmdSetViewport(current_command_buffer, 0, 1, &viewport);
+    vkCmdBeginRenderPass(current_command_buffer, &render_pass_bi, VK_SUBPASS_CONTENTS_INLINE);
 
-            vkCmdSetScissor(current_command_buffer, 0, 1, &scissor);
+    // ----------------------------------------------------------------------------------------------------------------
+    // Begin of render pass.
+    {
+        vkCmdSetViewport(current_command_buffer, 0, 1, &viewport);
 
-            // TODO: Render skybox!
+        vkCmdSetScissor(current_command_buffer, 0, 1, &scissor);
 
-            vkCmdBindPipeline(current_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphics_pipeline->get());
+        // TODO: Render skybox!
 
-            vkCmdBindDescriptorSets(current_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout->get(), 0,
-                                    1, descriptors[0].get_descriptor_sets_data(), 0, nullptr);
+        vkCmdBindPipeline(current_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphics_pipeline->get());
 
-            VkBuffer vertexBuffers[] = {mesh_buffers[0].get_vertex_buffer()};
-            VkDeviceSize offsets[] = {0};
-            vkCmdBindVertexBuffers(current_command_buffer, 0, 1, vertexBuffers, offsets);
+        vkCmdBindDescriptorSets(current_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout->get(), 0, 1,
+                                descriptors[0].get_descriptor_sets_data(), 0, nullptr);
 
-            vkCmdDraw(current_command_buffer, mesh_buffers[0].get_vertex_count(), 1, 0, 0);
+        VkBuffer vertexBuffers[] = {mesh_buffers[0].get_vertex_buffer()};
+        VkDeviceSize offsets[] = {0};
+        vkCmdBindVertexBuffers(current_command_buffer, 0, 1, vertexBuffers, offsets);
 
-            // TODO: This does not specify the order of rendering!
-            // gltf_model_manager->render_all_models(command_buffers[i], pipeline_layout, i);
+        if (mesh_buffers[0].has_index_buffer()) {
+            vkCmdBindIndexBuffer(current_command_buffer, *mesh_buffers[0].get_index_buffer(), 0,
+                                 mesh_buffers[0].get_index_type());
+        }
 
-            // TODO: Draw imgui user interface.
+        // Draw either everything or only the polygons which are visible, three vertices (or indices) per polygon.
+        std::vector<world::IncrementalMesh::Range> draw_ranges;
+        if (visible_polygons) {
+            draw_ranges = *visible_polygons;
+        } else if (mesh_buffers[0].has_index_buffer()) {
+            draw_ranges.push_back({0, mesh_buffers[0].get_index_cound() / 3});
+        } else {
+            draw_ranges.push_back({0, mesh_buffers[0].get_vertex_count() / 3});
         }
-        // End of render pass.
-        // ----------------------------------------------------------------------------------------------------------------
 
-        vkCmdEndRenderPass(current_command_buffer);
+        for (const auto &range : draw_ranges) {
+            const auto first = static_cast<std::uint32_t>(range.first * 3);
+            const auto count = static_cast<std::uint32_t>(range.count * 3);
+            if (mesh_buffers[0].has_index_buffer()) {
+                vkCmdDrawIndexed(current_command_buffer, count, 1, first, 0, 0);
+            } else {
+                vkCmdDraw(current_command_buffer, count, 1, first, 0);
+            }
+        }
 
-        result = vkEndCommandBuffer(current_command_buffer);
-        if (VK_SUCCESS != result)
-            return result;
+        // TODO: This does not specify the order of rendering!
+        // gltf_model_manager->render_all_models(command_buffers[image_index], pipeline_layout, image_index);
 
-        // TODO: End debug marker region
+        // TODO: Draw imgui user interface.
     }
+    // End of render pass.
+    // ----------------------------------------------------------------------------------------------------------------
+
+    vkCmdEndRenderPass(current_command_buffer);
+
+    result = vkEndCommandBuffer(current_command_buffer);
+    if (VK_SUCCESS != result)
+        return result;
+
+    // TODO: End debug marker region
 
     return VK_SUCCESS;
 }
 
+std::uint8_t *VulkanRenderer::map_mesh_staging_buffer(const std::size_t frame, const VkDeviceSize size) {
+    assert(frame < MAX_FRAMES_IN_FLIGHT);
+    assert(size > 0);
+
+    mesh_staging_buffers.resize(MAX_FRAMES_IN_FLIGHT);
+    auto &staging_buffer = mesh_staging_buffers[frame];
+
+    if (!staging_buffer || staging_buffer->get_buffer_size() < size) {
+        // The buffer grows at least by a factor of 2, so that a series of growing edits does not allocate every frame.
+        const VkDeviceSize buffer_size = staging_buffer ? std::max(size, 2 * staging_buffer->get_buffer_size()) : size;
+        staging_buffer.reset();
+        staging_buffer = std::make_unique<wrapper::GPUMemoryBuffer>(
+            vkdevice->get_device(), vma->get_allocator(), "Mesh staging buffer #" + std::to_string(frame), buffer_size,
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY);
+    }
+
+    mesh_staging_buffer = staging_buffer->get_buffer();
+    return static_cast<std::uint8_t *>(staging_buffer->get_allocation_info().pMappedData);
+}
+
 VkResult VulkanRenderer::create_synchronisation_objects() {
     assert(swapchain->get_image_count() > 0);
 
@@ -275,6 +357,9 @@ VkResult VulkanRenderer::recreate_swapchain() {
     game_camera.set_position({0.0f, 0.0f, 5.0f});
     game_camera.set_rotation({0.0f, 0.0f, 0.0f});
 
+    // The device is idle, so none of the swapchain images is in use.
+    images_in_flight.assign(swapchain->get_image_count(), nullptr);
+
     result = record_command_buffers();
     vulkan_error_check(result);
 
@@ -651,6 +736,7 @@ VkResult VulkanRenderer::shutdown_vulkan() {
     textures.clear();
     uniform_buffers.clear();
     mesh_buffers.clear();
+    mesh_staging_buffers.clear();
     descriptors.clear();
 
     image_available_semaphores.clear();
@@ -0,0 +1,156 @@
+#include "inexor/vulkan-renderer/tools/mapped_file.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <cassert>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace inexor::vulkan_renderer::tools {
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : file_data(std::exchange(other.file_data, nullptr)), file_size(std::exchange(other.file_size, 0))
+#ifdef _WIN32
+      ,
+      file_handle(std::exchange(other.file_handle, nullptr)),
+      mapping_handle(std::exchange(other.mapping_handle, nullptr))
+#endif
+{
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+        unmap();
+        file_data = std::exchange(other.file_data, nullptr);
+        file_size = std::exchange(other.file_size, 0);
+#ifdef _WIN32
+        file_handle = std::exchange(other.file_handle, nullptr);
+        mapping_handle = std::exchange(other.mapping_handle, nullptr);
+#endif
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    unmap();
+}
+
+std::size_t MappedFile::get_file_size() const {
+    return file_size;
+}
+
+const unsigned char *MappedFile::get_file_data() const {
+    return file_data;
+}
+
+void MappedFile::unmap() {
+#ifdef _WIN32
+    if (file_data != nullptr) {
+        UnmapViewOfFile(file_data);
+    }
+    if (mapping_handle != nullptr) {
+        CloseHandle(mapping_handle);
+    }
+    if (file_handle != nullptr) {
+        CloseHandle(file_handle);
+    }
+    file_handle = nullptr;
+    mapping_handle = nullptr;
+#else
+    if (file_data != nullptr) {
+        munmap(const_cast<unsigned char *>(file_data), file_size);
+    }
+#endif
+    file_data = nullptr;
+    file_size = 0;
+}
+
+bool MappedFile::map_file(const std::string &file_name) {
+    assert(file_name.size() > 0);
+
+    unmap();
+
+#ifdef _WIN32
+    file_handle = CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_handle == INVALID_HANDLE_VALUE) {
+        file_handle = nullptr;
+        spdlog::error("Could not open file {}!", file_name);
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file_handle, &size)) {
+        spdlog::error("Could not read the size of file {}!", file_name);
+        unmap();
+        return false;
+    }
+
+    // Empty files can not be mapped, but are valid files nonetheless.
+    if (size.QuadPart == 0) {
+        return true;
+    }
+
+    mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_handle == nullptr) {
+        spdlog::error("Could not create file mapping for file {}!", file_name);
+        unmap();
+        return false;
+    }
+
+    file_data = static_cast<const unsigned char *>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+    if (file_data == nullptr) {
+        spdlog::error("Could not map file {}!", file_name);
+        unmap();
+        return false;
+    }
+    file_size = static_cast<std::size_t>(size.QuadPart);
+#else
+    const int file_descriptor = open(file_name.c_str(), O_RDONLY);
+    if (file_descriptor == -1) {
+        spdlog::error("Could not open file {}!", file_name);
+        return false;
+    }
+
+    struct stat file_status {};
+    if (fstat(file_descriptor, &file_status) == -1) {
+        spdlog::error("Could not read the size of file {}!", file_name);
+        close(file_descriptor);
+        return false;
+    }
+
+    // Empty files can not be mapped, but are valid files nonetheless.
+    if (file_status.st_size == 0) {
+        close(file_descriptor);
+        return true;
+    }
+
+    void *mapping = mmap(nullptr, file_status.st_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+
+    // The mapping stays valid after the file descriptor has been closed.
+    close(file_descriptor);
+
+    if (mapping == MAP_FAILED) {
+        spdlog::error("Could not map file {}!", file_name);
+        return false;
+    }
+    file_data = static_cast<const unsigned char *>(mapping);
+    file_size = static_cast<std::size_t>(file_status.st_size);
+#endif
+
+    spdlog::debug("File {} has been mapped ({} bytes).", file_name, file_size);
+
+    return true;
+}
+
+} // namespace inexor::vulkan_renderer::tools
@@ -1,57 +1,86 @@
 #include "inexor/vulkan-renderer/world/bit_stream.hpp"
 
+#include <cassert>
+
 namespace inexor::vulkan_renderer::world {
-BitStream::BitStream(unsigned char *data, std::size_t size) {
+namespace {
+/// Load 8 bytes as big endian word, compilers turn this into a single (byte swapping) load.
+std::uint64_t load_big_endian(const unsigned char *data) {
+    std::uint64_t word = 0;
+    for (std::size_t i = 0; i < 8; i++) {
+        word = word << 8 | data[i];
+    }
+    return word;
+}
+} // namespace
+
+BitStream::BitStream(const unsigned char *data, std::size_t size) {
     this->data = data;
-    this->offset = 0;
     this->bytes_left = size;
 }
 
+BitStream::BitStream(const unsigned char *data, std::size_t size, std::size_t bit_offset)
+    : BitStream(data + bit_offset / 8, size - bit_offset / 8) {
+    assert(bit_offset <= size * 8);
+    if (bit_offset % 8 != 0) {
+        this->skip(bit_offset % 8);
+    }
+}
+
 BitStream::BitStream() {}
 
+void BitStream::refill() {
+    assert(this->bits_in_buffer <= 56);
+    if (this->bytes_left >= 8) {
+        // Load a whole word and advance by the number of complete bytes which fit into the buffer.
+        // The bits behind the last complete byte are loaded again by the next refill, which is fine as OR-ing the
+        // same bits twice does not change them.
+        this->buffer |= load_big_endian(this->data) >> this->bits_in_buffer;
+        const std::uint8_t bytes = (64 - this->bits_in_buffer) >> 3;
+        this->data += bytes;
+        this->bytes_left -= bytes;
+        this->bits_in_buffer += bytes * 8;
+        return;
+    }
+    // Close to the end of the stream, load byte by byte.
+    while (this->bits_in_buffer <= 56 && this->bytes_left > 0) {
+        this->buffer |= static_cast<std::uint64_t>(*this->data) << (56 - this->bits_in_buffer);
+        this->data++;
+        this->bytes_left--;
+        this->bits_in_buffer += 8;
+    }
+}
+
+std::size_t BitStream::bits_left() const {
+    return this->bits_in_buffer + this->bytes_left * 8;
+}
+
 std::optional<boost::dynamic_bitset<>> BitStream::get_bitset(std::uint8_t size) {
-    const std::optional<std::uint8_t> ubits = this->get(size);
+    const std::optional<std::uint64_t> ubits = this->get(size);
     if (ubits) {
         return boost::dynamic_bitset<>(size, *ubits);
     }
     return std::nullopt;
 }
 
-std::optional<std::uint8_t> BitStream::get(std::uint8_t size) {
-    // Inexor Octree does not use any data types larger than 8 bits.
-    assert(size && size < 9);
-    assert(this->bytes_left);
-
-    auto current = static_cast<std::uint8_t>(*this->data);
-    if (!this->offset) {
-        this->offset = size % 8;
-        if (size == 8) {
-            this->bytes_left -= 1;
-            this->data++;
+std::optional<std::array<glm::tvec3<std::uint8_t>, 8>> BitStream::get_indentations() {
+    std::array<glm::tvec3<std::uint8_t>, 8> levels;
+    for (std::size_t i = 0; i < 24; i++) {
+        // A level takes at most 4 bits, so 12 levels always fit into 48 bits.
+        if (i % 12 == 0 && this->bits_in_buffer < 48) {
+            this->refill();
         }
-        return (current & KEEP_FIRST_N_BITS[size]) >> (8 - size);
-    }
-
-    std::uint8_t overflow = this->offset + size <= 8 ? 0 : (size + this->offset) % 8;
-    current &= DISCARD_FIRST_N_BITS[this->offset];
-
-    if (!overflow) {
-        std::uint8_t bits = current >> (8 - this->offset - size);
-        if ((this->offset + size) == 8) {
-            this->offset = 0;
-            this->bytes_left -= 1;
-            this->data++;
-        } else {
-            this->offset += size;
+        const auto top = static_cast<std::uint8_t>(this->buffer >> 60);
+        const std::uint8_t indented = top >> 3;
+        const std::uint8_t size = 1 + 3 * indented;
+        if (size > this->bits_in_buffer) {
+            return std::nullopt;
         }
-        return bits;
+        // If it is indented it cannot be 0, thus the format saves the real value - 1.
+        levels[i / 3][static_cast<int>(i % 3)] = indented * ((top & 0b111) + 1);
+        this->buffer <<= size;
+        this->bits_in_buffer -= size;
     }
-
-    this->offset = 0;
-    this->bytes_left -= 1;
-    this->data++;
-
-    assert(this->bytes_left);
-    return current << overflow | this->get(overflow).value();
+    return levels;
 }
 } // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,61 @@
+#include "inexor/vulkan-renderer/world/bit_stream_writer.hpp"
+
+#include <algorithm>
+
+namespace inexor::vulkan_renderer::world {
+BitStreamWriter::BitStreamWriter() = default;
+
+BitStreamWriter::BitStreamWriter(std::size_t byte_capacity) {
+    this->data.resize(byte_capacity + 8);
+}
+
+std::size_t BitStreamWriter::bits_written() const {
+    return this->bytes_written * 8 + this->bits_in_buffer;
+}
+
+void BitStreamWriter::flush() {
+    // Always store the whole word, bytes behind the complete ones are overwritten by the next flush.
+    if (this->data.size() < this->bytes_written + 8) {
+        this->data.resize(std::max<std::size_t>(this->data.size() * 2, 64));
+    }
+    for (std::size_t i = 0; i < 8; i++) {
+        this->data[this->bytes_written + i] = static_cast<unsigned char>(this->buffer >> (56 - i * 8));
+    }
+    const std::uint8_t bytes = this->bits_in_buffer >> 3;
+    this->bytes_written += bytes;
+    this->buffer = bytes == 8 ? 0 : this->buffer << (bytes * 8);
+    this->bits_in_buffer -= bytes * 8;
+}
+
+void BitStreamWriter::put_indentations(const std::array<glm::tvec3<std::uint8_t>, 8> &levels) {
+    for (const auto &level : levels) {
+        // Collect the 3 axes of a corner into one write of at most 12 bits.
+        std::uint64_t bits = 0;
+        std::uint8_t size = 0;
+        for (int axis = 0; axis < 3; axis++) {
+            // 3 bits can hold the levels 1 to 8.
+            assert(level[axis] <= 8);
+            if (level[axis] == 0) {
+                bits <<= 1;
+                size += 1;
+            } else {
+                // The level can not be 0, thus the format saves the real value - 1.
+                bits = bits << 4 | 0b1000 | (level[axis] - 1);
+                size += 4;
+            }
+        }
+        this->put(bits, size);
+    }
+}
+
+std::vector<unsigned char> BitStreamWriter::finish() {
+    // Round up to complete the last byte, the unused bits of the buffer are zero.
+    this->bits_in_buffer = (this->bits_in_buffer + 7) & ~7;
+    this->flush();
+    this->data.resize(this->bytes_written);
+    this->bytes_written = 0;
+    std::vector<unsigned char> written = std::move(this->data);
+    this->data.clear();
+    return written;
+}
+} // namespace inexor::vulkan_renderer::world
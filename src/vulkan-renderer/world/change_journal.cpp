@@ -0,0 +1,54 @@
+#include "inexor/vulkan-renderer/world/change_journal.hpp"
+
+#include "inexor/vulkan-renderer/world/cube.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace inexor::vulkan_renderer::world {
+void ChangeJournal::record(Cube *cube) {
+    assert(cube != nullptr);
+    this->changes.push_back(cube);
+}
+
+void ChangeJournal::forget(const Cube *cube) {
+    const auto change = std::find(this->changes.begin(), this->changes.end(), cube);
+    if (change != this->changes.end()) {
+        this->changes.erase(change);
+    }
+}
+
+std::size_t ChangeJournal::subscribe(Subscriber subscriber) {
+    const std::size_t id = this->next_id++;
+    this->subscribers.emplace_back(id, std::move(subscriber));
+    return id;
+}
+
+void ChangeJournal::unsubscribe(std::size_t id) {
+    this->subscribers.erase(std::remove_if(this->subscribers.begin(), this->subscribers.end(),
+                                           [id](const auto &subscriber) { return subscriber.first == id; }),
+                            this->subscribers.end());
+}
+
+void ChangeJournal::flush() {
+    if (this->changes.empty()) {
+        return;
+    }
+    std::vector<Cube *> batch;
+    batch.swap(this->changes);
+    for (Cube *cube : batch) {
+        cube->journaled = false;
+    }
+    for (const auto &subscriber : this->subscribers) {
+        subscriber.second(batch);
+    }
+}
+
+const std::vector<Cube *> &ChangeJournal::pending() const {
+    return this->changes;
+}
+
+bool ChangeJournal::empty() const {
+    return this->changes.empty();
+}
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,219 @@
+#include "inexor/vulkan-renderer/world/chunk_streamer.hpp"
+
+#include "inexor/vulkan-renderer/world/bit_stream.hpp"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iterator>
+#include <utility>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// Count the cubes of an octree.
+/// @param cube The octree.
+/// @return The number of cubes.
+std::size_t count_cubes(Cube &cube) {
+    std::size_t count = 1;
+    if (cube.type() == CubeType::OCTANT) {
+        for (const auto &octant : *cube.octants) {
+            count += count_cubes(*octant);
+        }
+    }
+    return count;
+}
+
+/// Load, parse and mesh a chunk, runs on the thread pool.
+/// @param loader Gives the binary data of the octree of the chunk.
+/// @param options The options of the chunk streamer.
+/// @param coordinate The coordinate of the chunk.
+/// @return The chunk.
+std::shared_ptr<const Chunk> load_chunk(const ChunkLoader &loader, const StreamingOptions &options,
+                                        const glm::ivec3 &coordinate) {
+    auto chunk = std::make_shared<Chunk>();
+    chunk->coordinate = coordinate;
+
+    const std::vector<unsigned char> data = loader(coordinate);
+    BitStream stream(data.data(), data.size());
+    chunk->octree = std::make_shared<Cube>(
+        Cube::parse(stream, options.chunk_size, glm::vec3(coordinate) * options.chunk_size));
+
+    Mesher mesher(options.mesh_options);
+    chunk->mesh = mesher.vertices(*chunk->octree);
+    chunk->mesh.shrink_to_fit();
+
+    chunk->memory_usage =
+        count_cubes(*chunk->octree) * sizeof(Cube) + chunk->mesh.size() * sizeof(std::array<MeshVertex, 3>);
+    return chunk;
+}
+
+/// Get the distance of a point to a line segment.
+/// @param point The point.
+/// @param start The start of the segment.
+/// @param end The end of the segment.
+/// @return The distance.
+float distance_to_segment(const glm::vec3 &point, const glm::vec3 &start, const glm::vec3 &end) {
+    const glm::vec3 direction = end - start;
+    const float length = glm::dot(direction, direction);
+    if (length == 0.0f) {
+        return glm::distance(point, start);
+    }
+    const float t = glm::clamp(glm::dot(point - start, direction) / length, 0.0f, 1.0f);
+    return glm::distance(point, start + direction * t);
+}
+} // namespace
+
+std::size_t ChunkStreamer::CoordinateHash::operator()(const glm::ivec3 &coordinate) const {
+    // The primes of "Optimized Spatial Hashing for Collision Detection of Deformable Objects".
+    return static_cast<std::size_t>(coordinate.x) * 73856093u ^ static_cast<std::size_t>(coordinate.y) * 19349663u ^
+           static_cast<std::size_t>(coordinate.z) * 83492791u;
+}
+
+ChunkStreamer::ChunkStreamer(ThreadPool &thread_pool, ChunkLoader loader, StreamingOptions options)
+    : thread_pool(thread_pool), loader(std::move(loader)), options(std::move(options)) {}
+
+ChunkStreamer::~ChunkStreamer() {
+    // The tasks do not reference the chunk streamer, but they should not outlive it on the thread pool.
+    for (auto &[coordinate, task] : this->pending) {
+        task.wait();
+    }
+}
+
+std::vector<glm::ivec3> ChunkStreamer::requested_chunks(const glm::vec3 &camera_position,
+                                                        const glm::vec3 &camera_velocity) const {
+    const glm::vec3 end = camera_position + camera_velocity * this->options.prefetch_time;
+    const float radius = this->options.load_radius;
+    const float size = this->options.chunk_size;
+    const glm::ivec3 lowest(glm::floor((glm::min(camera_position, end) - radius) / size));
+    const glm::ivec3 highest(glm::floor((glm::max(camera_position, end) + radius) / size));
+
+    std::vector<std::pair<float, glm::ivec3>> requested;
+    for (int x = lowest.x; x <= highest.x; x++) {
+        for (int y = lowest.y; y <= highest.y; y++) {
+            for (int z = lowest.z; z <= highest.z; z++) {
+                const glm::ivec3 coordinate(x, y, z);
+                const glm::vec3 center = (glm::vec3(coordinate) + 0.5f) * size;
+                if (distance_to_segment(center, camera_position, end) <= radius) {
+                    requested.emplace_back(glm::distance(center, camera_position), coordinate);
+                }
+            }
+        }
+    }
+    std::sort(requested.begin(), requested.end(),
+              [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+
+    std::vector<glm::ivec3> coordinates;
+    coordinates.reserve(requested.size());
+    for (const auto &[distance, coordinate] : requested) {
+        coordinates.push_back(coordinate);
+    }
+    return coordinates;
+}
+
+void ChunkStreamer::evict(std::vector<glm::ivec3> &evicted) {
+    if (this->used_memory <= this->options.memory_budget) {
+        return;
+    }
+    // Chunks which are requested by the current update are never evicted.
+    std::vector<std::pair<std::uint64_t, glm::ivec3>> candidates;
+    for (const auto &[coordinate, entry] : this->chunks) {
+        if (entry.last_used < this->updates) {
+            candidates.emplace_back(entry.last_used, coordinate);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+    for (const auto &[last_used, coordinate] : candidates) {
+        if (this->used_memory <= this->options.memory_budget) {
+            break;
+        }
+        auto entry = this->chunks.find(coordinate);
+        this->used_memory -= entry->second.chunk->memory_usage;
+        this->chunks.erase(entry);
+        evicted.push_back(coordinate);
+    }
+}
+
+ChunkStreamer::Update ChunkStreamer::update(const glm::vec3 &camera_position, const glm::vec3 &camera_velocity) {
+    this->updates++;
+    Update update;
+
+    // Collect the chunks which have been loaded, they are more recent than every chunk which is not requested anymore.
+    for (auto task = this->pending.begin(); task != this->pending.end();) {
+        if (task->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            task++;
+            continue;
+        }
+        const glm::ivec3 coordinate = task->first;
+        auto future = std::move(task->second);
+        task = this->pending.erase(task);
+        std::shared_ptr<const Chunk> chunk;
+        try {
+            chunk = future.get();
+        } catch (const std::exception &exception) {
+            this->failed.emplace(coordinate, this->updates);
+            update.failed.push_back({coordinate, exception.what()});
+            continue;
+        }
+        this->used_memory += chunk->memory_usage;
+        this->chunks.emplace(chunk->coordinate, Entry{chunk, this->updates - 1});
+        update.loaded.push_back(std::move(chunk));
+    }
+
+    for (const glm::ivec3 &coordinate : this->requested_chunks(camera_position, camera_velocity)) {
+        if (auto entry = this->chunks.find(coordinate); entry != this->chunks.end()) {
+            entry->second.last_used = this->updates;
+            continue;
+        }
+        if (auto failure = this->failed.find(coordinate); failure != this->failed.end()) {
+            failure->second = this->updates;
+            continue;
+        }
+        if (this->pending.size() < this->options.max_pending && this->pending.count(coordinate) == 0) {
+            // The task captures copies, so that it does not depend on the lifetime of the chunk streamer.
+            this->pending.emplace(coordinate, this->thread_pool.execute([loader = this->loader,
+                                                                         options = this->options, coordinate]() {
+                return load_chunk(loader, options, coordinate);
+            }));
+        }
+    }
+
+    // Failed chunks which are not requested anymore are forgotten, so that they are loaded again once requested.
+    for (auto failure = this->failed.begin(); failure != this->failed.end();) {
+        failure = failure->second < this->updates ? this->failed.erase(failure) : std::next(failure);
+    }
+
+    std::vector<glm::ivec3> evicted;
+    this->evict(evicted);
+    // A chunk which is loaded and evicted by the same update is not reported at all.
+    for (const glm::ivec3 &coordinate : evicted) {
+        auto loaded = std::find_if(update.loaded.begin(), update.loaded.end(),
+                                   [&](const auto &chunk) { return chunk->coordinate == coordinate; });
+        if (loaded != update.loaded.end()) {
+            update.loaded.erase(loaded);
+        } else {
+            update.evicted.push_back(coordinate);
+        }
+    }
+    return update;
+}
+
+std::shared_ptr<const Chunk> ChunkStreamer::chunk(const glm::ivec3 &coordinate) const {
+    const auto entry = this->chunks.find(coordinate);
+    return entry != this->chunks.end() ? entry->second.chunk : nullptr;
+}
+
+std::size_t ChunkStreamer::loaded_count() const {
+    return this->chunks.size();
+}
+
+std::size_t ChunkStreamer::pending_count() const {
+    return this->pending.size();
+}
+
+std::size_t ChunkStreamer::memory_usage() const {
+    return this->used_memory;
+}
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,410 @@
+#include "inexor/vulkan-renderer/world/collision.hpp"
+
+#include "inexor/vulkan-renderer/thread_pool.hpp"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <future>
+#include <limits>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+using Polygon = std::array<glm::vec3, 3>;
+
+/// Get the squared distance of a point to an axis aligned box.
+float box_distance2(const glm::vec3 &point, const glm::vec3 &min, const glm::vec3 &max) {
+    const glm::vec3 offset = point - glm::clamp(point, min, max);
+    return glm::dot(offset, offset);
+}
+
+/// Get the point of a triangle which is closest to a point (Ericson, Real-Time Collision Detection, 5.1.5).
+glm::vec3 closest_point(const glm::vec3 &point, const Polygon &polygon) {
+    const glm::vec3 &a = polygon[0];
+    const glm::vec3 &b = polygon[1];
+    const glm::vec3 &c = polygon[2];
+    const glm::vec3 ab = b - a;
+    const glm::vec3 ac = c - a;
+    const glm::vec3 ap = point - a;
+    const float d1 = glm::dot(ab, ap);
+    const float d2 = glm::dot(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) {
+        return a;
+    }
+    const glm::vec3 bp = point - b;
+    const float d3 = glm::dot(ab, bp);
+    const float d4 = glm::dot(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3) {
+        return b;
+    }
+    const float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+        return a + ab * (d1 / (d1 - d3));
+    }
+    const glm::vec3 cp = point - c;
+    const float d5 = glm::dot(ab, cp);
+    const float d6 = glm::dot(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6) {
+        return c;
+    }
+    const float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+        return a + ac * (d2 / (d2 - d6));
+    }
+    const float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f) {
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+    // The point projects into the triangle, degenerated triangles end up in one of the cases above.
+    const float denominator = 1.0f / (va + vb + vc);
+    return a + ab * (vb * denominator) + ac * (vc * denominator);
+}
+
+/// Get the squared distance between two line segments (Ericson, Real-Time Collision Detection, 5.1.9).
+float segment_distance2(const glm::vec3 &start1, const glm::vec3 &end1, const glm::vec3 &start2,
+                        const glm::vec3 &end2) {
+    const glm::vec3 d1 = end1 - start1;
+    const glm::vec3 d2 = end2 - start2;
+    const glm::vec3 r = start1 - start2;
+    const float a = glm::dot(d1, d1);
+    const float e = glm::dot(d2, d2);
+    const float f = glm::dot(d2, r);
+    float s = 0.0f;
+    float t = 0.0f;
+    if (a == 0.0f && e == 0.0f) {
+        return glm::dot(r, r);
+    }
+    if (a == 0.0f) {
+        t = std::clamp(f / e, 0.0f, 1.0f);
+    } else {
+        const float c = glm::dot(d1, r);
+        if (e == 0.0f) {
+            s = std::clamp(-c / a, 0.0f, 1.0f);
+        } else {
+            const float b = glm::dot(d1, d2);
+            const float denominator = a * e - b * b;
+            s = denominator != 0.0f ? std::clamp((b * f - c * e) / denominator, 0.0f, 1.0f) : 0.0f;
+            t = (b * s + f) / e;
+            if (t < 0.0f) {
+                t = 0.0f;
+                s = std::clamp(-c / a, 0.0f, 1.0f);
+            } else if (t > 1.0f) {
+                t = 1.0f;
+                s = std::clamp((b - c) / a, 0.0f, 1.0f);
+            }
+        }
+    }
+    const glm::vec3 offset = (start1 + d1 * s) - (start2 + d2 * t);
+    return glm::dot(offset, offset);
+}
+
+/// Check whether a line segment intersects a triangle (Möller-Trumbore).
+bool segment_intersects(const glm::vec3 &start, const glm::vec3 &end, const Polygon &polygon) {
+    const glm::vec3 direction = end - start;
+    const glm::vec3 edge1 = polygon[1] - polygon[0];
+    const glm::vec3 edge2 = polygon[2] - polygon[0];
+    const glm::vec3 p = glm::cross(direction, edge2);
+    const float determinant = glm::dot(edge1, p);
+    if (determinant == 0.0f) {
+        return false;
+    }
+    const float inverse = 1.0f / determinant;
+    const glm::vec3 s = start - polygon[0];
+    const float u = glm::dot(s, p) * inverse;
+    if (u < 0.0f || u > 1.0f) {
+        return false;
+    }
+    const glm::vec3 q = glm::cross(s, edge1);
+    const float v = glm::dot(direction, q) * inverse;
+    if (v < 0.0f || u + v > 1.0f) {
+        return false;
+    }
+    const float t = glm::dot(edge2, q) * inverse;
+    return t >= 0.0f && t <= 1.0f;
+}
+
+/// Get the squared distance between a line segment and a triangle.
+float segment_distance2(const glm::vec3 &start, const glm::vec3 &end, const Polygon &polygon) {
+    if (segment_intersects(start, end, polygon)) {
+        return 0.0f;
+    }
+    // Without an intersection the closest points lie on an end of the segment or on an edge of the triangle.
+    const glm::vec3 start_offset = start - closest_point(start, polygon);
+    const glm::vec3 end_offset = end - closest_point(end, polygon);
+    float distance2 = std::min(glm::dot(start_offset, start_offset), glm::dot(end_offset, end_offset));
+    for (std::size_t i = 0; i < 3; i++) {
+        distance2 = std::min(distance2, segment_distance2(start, end, polygon[i], polygon[(i + 1) % 3]));
+    }
+    return distance2;
+}
+
+/// Get the squared distance between a line segment and an axis aligned box.
+float segment_box_distance2(const glm::vec3 &start, const glm::vec3 &end, const glm::vec3 &min,
+                            const glm::vec3 &max) {
+    // The squared distance is quadratic between the points where the segment crosses the planes of the box sides.
+    const glm::vec3 direction = end - start;
+    std::array<float, 8> crossings{0.0f, 1.0f};
+    std::size_t count = 2;
+    for (int axis = 0; axis < 3; axis++) {
+        if (direction[axis] == 0.0f) {
+            continue;
+        }
+        for (const float side : {min[axis], max[axis]}) {
+            const float t = (side - start[axis]) / direction[axis];
+            if (t > 0.0f && t < 1.0f) {
+                crossings[count++] = t;
+            }
+        }
+    }
+    std::sort(crossings.begin(), crossings.begin() + static_cast<std::ptrdiff_t>(count));
+    float distance2 = std::numeric_limits<float>::infinity();
+    for (std::size_t i = 0; i + 1 < count; i++) {
+        const float first = crossings[i];
+        const float last = crossings[i + 1];
+        const float middle = (first + last) / 2;
+        // Coefficients of a * t^2 + b * t + c between both crossings.
+        float a = 0.0f;
+        float b = 0.0f;
+        float c = 0.0f;
+        for (int axis = 0; axis < 3; axis++) {
+            const float position = start[axis] + direction[axis] * middle;
+            if (position >= min[axis] && position <= max[axis]) {
+                continue;
+            }
+            const float offset = start[axis] - (position < min[axis] ? min[axis] : max[axis]);
+            a += direction[axis] * direction[axis];
+            b += 2.0f * direction[axis] * offset;
+            c += offset * offset;
+        }
+        const float t = a > 0.0f ? std::clamp(-b / (2.0f * a), first, last) : first;
+        distance2 = std::min(distance2, std::max((a * t + b) * t + c, 0.0f));
+    }
+    return distance2;
+}
+
+/// Check whether a triangle overlaps an axis aligned box with the separating axis test (Akenine-Möller).
+bool polygon_overlaps_box(const Polygon &polygon, const glm::vec3 &min, const glm::vec3 &max) {
+    const glm::vec3 center = (min + max) * 0.5f;
+    const glm::vec3 half = (max - min) * 0.5f;
+    const Polygon vertices{polygon[0] - center, polygon[1] - center, polygon[2] - center};
+    const auto separates = [&](const glm::vec3 &axis) {
+        const float p0 = glm::dot(axis, vertices[0]);
+        const float p1 = glm::dot(axis, vertices[1]);
+        const float p2 = glm::dot(axis, vertices[2]);
+        const float radius = glm::dot(half, glm::abs(axis));
+        return std::min({p0, p1, p2}) > radius || std::max({p0, p1, p2}) < -radius;
+    };
+    // The sides of the box, the side of the triangle and the cross products of their edges.
+    for (int axis = 0; axis < 3; axis++) {
+        glm::vec3 normal(0.0f);
+        normal[axis] = 1.0f;
+        if (separates(normal)) {
+            return false;
+        }
+    }
+    const std::array<glm::vec3, 3> edges{vertices[1] - vertices[0], vertices[2] - vertices[1],
+                                         vertices[0] - vertices[2]};
+    if (separates(glm::cross(edges[0], edges[1]))) {
+        return false;
+    }
+    for (const auto &edge : edges) {
+        for (int axis = 0; axis < 3; axis++) {
+            glm::vec3 normal(0.0f);
+            normal[axis] = 1.0f;
+            if (separates(glm::cross(normal, edge))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/// Check whether a point lies within the closed surface of a leaf, using the sum of the solid angles of its polygons
+/// (winding number), which is independent of their orientation and convexity.
+bool contains(const std::array<Polygon, 12> &polygons, const glm::vec3 &point) {
+    float solid_angle = 0.0f;
+    for (const auto &polygon : polygons) {
+        // Van Oosterom and Strackee.
+        const glm::vec3 a = polygon[0] - point;
+        const glm::vec3 b = polygon[1] - point;
+        const glm::vec3 c = polygon[2] - point;
+        const float la = glm::length(a);
+        const float lb = glm::length(b);
+        const float lc = glm::length(c);
+        const float numerator = glm::dot(a, glm::cross(b, c));
+        const float denominator = la * lb * lc + glm::dot(a, b) * lc + glm::dot(a, c) * lb + glm::dot(b, c) * la;
+        solid_angle += 2.0f * std::atan2(numerator, denominator);
+    }
+    // The solid angle is 4 pi inside the surface and 0 outside.
+    return std::abs(solid_angle) > 2.0f * glm::pi<float>();
+}
+
+bool overlaps_box(const Sphere &sphere, const glm::vec3 &min, const glm::vec3 &max) {
+    return box_distance2(sphere.center, min, max) <= sphere.radius * sphere.radius;
+}
+
+bool overlaps_box(const Box &box, const glm::vec3 &min, const glm::vec3 &max) {
+    for (int axis = 0; axis < 3; axis++) {
+        if (box.min[axis] > max[axis] || box.max[axis] < min[axis]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool overlaps_box(const Capsule &capsule, const glm::vec3 &min, const glm::vec3 &max) {
+    // Reject by the bounds of the capsule first, which is much cheaper than the distance.
+    const glm::vec3 radius(capsule.radius);
+    if (!overlaps_box(Box{glm::min(capsule.start, capsule.end) - radius, glm::max(capsule.start, capsule.end) + radius},
+                      min, max)) {
+        return false;
+    }
+    return segment_box_distance2(capsule.start, capsule.end, min, max) <= capsule.radius * capsule.radius;
+}
+
+bool overlaps_polygon(const Sphere &sphere, const Polygon &polygon) {
+    const glm::vec3 offset = sphere.center - closest_point(sphere.center, polygon);
+    return glm::dot(offset, offset) <= sphere.radius * sphere.radius;
+}
+
+bool overlaps_polygon(const Box &box, const Polygon &polygon) {
+    return polygon_overlaps_box(polygon, box.min, box.max);
+}
+
+bool overlaps_polygon(const Capsule &capsule, const Polygon &polygon) {
+    return segment_distance2(capsule.start, capsule.end, polygon) <= capsule.radius * capsule.radius;
+}
+
+/// Get any point of a shape, the shape lies within a closed surface it does not overlap if the point does.
+glm::vec3 inner_point(const Sphere &sphere) {
+    return sphere.center;
+}
+
+glm::vec3 inner_point(const Box &box) {
+    return box.min;
+}
+
+glm::vec3 inner_point(const Capsule &capsule) {
+    return capsule.start;
+}
+
+/// Find the leaves of a cube which overlap a shape, the bounds of the cube must overlap the shape.
+/// @param cube The cube.
+/// @param shape The shape.
+/// @param leaves The buffer to append the leaves to, nullptr to stop at the first leaf.
+/// @return Whether any leaf overlaps the shape.
+template <typename Shape>
+bool collide(Cube &cube, const Shape &shape, std::vector<Cube *> *leaves) {
+    switch (cube.type()) {
+    case CubeType::EMPTY:
+        return false;
+    case CubeType::FULL:
+        // The bounds are the geometry of a full leaf.
+        break;
+    case CubeType::INDENTED: {
+        std::array<glm::tvec3<std::uint8_t>, 8> levels;
+        for (std::size_t i = 0; i < levels.size(); i++) {
+            levels[i] = (*cube.indentations)[i].vec();
+        }
+        const auto polygons = Cube::leaf_polygons(CubeType::INDENTED, cube.size(), cube.position(), levels);
+        if (std::none_of(polygons.begin(), polygons.end(),
+                         [&](const Polygon &polygon) { return overlaps_polygon(shape, polygon); }) &&
+            !contains(polygons, inner_point(shape))) {
+            return false;
+        }
+        break;
+    }
+    case CubeType::OCTANT: {
+        bool hit = false;
+        const float half = cube.size() / 2;
+        for (const auto &octant : *cube.octants) {
+            const glm::vec3 position = octant->position();
+            if (overlaps_box(shape, position, position + half) && collide(*octant, shape, leaves)) {
+                if (leaves == nullptr) {
+                    return true;
+                }
+                hit = true;
+            }
+        }
+        return hit;
+    }
+    }
+    if (leaves != nullptr) {
+        leaves->push_back(&cube);
+    }
+    return true;
+}
+
+/// Find the leaves of an octree which overlap a shape, see collide.
+template <typename Shape>
+bool collide_octree(Cube &cube, const Shape &shape, std::vector<Cube *> *leaves) {
+    const glm::vec3 position = cube.position();
+    return overlaps_box(shape, position, position + cube.size()) && collide(cube, shape, leaves);
+}
+
+/// Check shapes for collisions with an octree in parallel.
+template <typename Shape>
+std::vector<char> collide_parallel(Cube &cube, const std::vector<Shape> &shapes, ThreadPool &thread_pool,
+                                   std::size_t batch_size) {
+    assert(batch_size > 0);
+    // char instead of bool, so that the tasks can write their results concurrently.
+    std::vector<char> hits(shapes.size());
+    std::vector<std::future<void>> tasks;
+    for (std::size_t first = 0; first < shapes.size(); first += batch_size) {
+        const std::size_t last = std::min(first + batch_size, shapes.size());
+        tasks.push_back(thread_pool.execute([&cube, &shapes, &hits, first, last]() {
+            for (std::size_t i = first; i < last; i++) {
+                hits[i] = collide_octree(cube, shapes[i], nullptr);
+            }
+        }));
+    }
+    for (auto &task : tasks) {
+        task.get();
+    }
+    return hits;
+}
+} // namespace
+
+bool collides(Cube &cube, const Sphere &sphere) {
+    return collide_octree(cube, sphere, nullptr);
+}
+
+bool collides(Cube &cube, const Box &box) {
+    return collide_octree(cube, box, nullptr);
+}
+
+bool collides(Cube &cube, const Capsule &capsule) {
+    return collide_octree(cube, capsule, nullptr);
+}
+
+void overlaps(Cube &cube, const Sphere &sphere, std::vector<Cube *> &leaves) {
+    collide_octree(cube, sphere, &leaves);
+}
+
+void overlaps(Cube &cube, const Box &box, std::vector<Cube *> &leaves) {
+    collide_octree(cube, box, &leaves);
+}
+
+void overlaps(Cube &cube, const Capsule &capsule, std::vector<Cube *> &leaves) {
+    collide_octree(cube, capsule, &leaves);
+}
+
+std::vector<char> collides(Cube &cube, const std::vector<Sphere> &spheres, ThreadPool &thread_pool,
+                           std::size_t batch_size) {
+    return collide_parallel(cube, spheres, thread_pool, batch_size);
+}
+
+std::vector<char> collides(Cube &cube, const std::vector<Box> &boxes, ThreadPool &thread_pool,
+                           std::size_t batch_size) {
+    return collide_parallel(cube, boxes, thread_pool, batch_size);
+}
+
+std::vector<char> collides(Cube &cube, const std::vector<Capsule> &capsules, ThreadPool &thread_pool,
+                           std::size_t batch_size) {
+    return collide_parallel(cube, capsules, thread_pool, batch_size);
+}
+} // namespace inexor::vulkan_renderer::world
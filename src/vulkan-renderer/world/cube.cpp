@@ -1,63 +1,152 @@
 #include "inexor/vulkan-renderer/world/cube.hpp"
 
+#include "inexor/vulkan-renderer/thread_pool.hpp"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <future>
+#include <numeric>
+#include <stdexcept>
 #include <utility>
 
 namespace inexor::vulkan_renderer::world {
-void Indentation::set(std::optional<std::uint8_t> x, std::optional<std::uint8_t> y, std::optional<std::uint8_t> z) {
-    assert(x <= MAX_INDENTATION && y <= MAX_INDENTATION && z <= MAX_INDENTATION);
-    if (x) {
-        this->x_level = *x;
+namespace {
+/// Create the nodes of an octree down to the depth of the index, schedule the subtrees below on the thread pool.
+/// @param data The data to parse the octree from.
+/// @param thread_pool The thread pool to parse the subtrees on.
+/// @param index The offsets of the subtrees in the data.
+/// @param cursor The position of the node in the offsets of the index, advanced to the next node.
+/// @param depth The depth of the node.
+/// @param size The maximum size of the cube.
+/// @param position The position of the cube in the coordinate system.
+/// @param tasks The scheduled tasks, all of them have to finish before the cube may be used.
+/// @return The cube, which is filled by a task if the node is at the depth of the index.
+std::shared_ptr<Cube> parse_indexed(const std::vector<unsigned char> &data, ThreadPool &thread_pool,
+                                    const SubtreeIndex &index, std::size_t &cursor, std::uint32_t depth, float size,
+                                    const glm::vec3 &position, std::vector<std::future<void>> &tasks) {
+    // The offsets may have been stored next to the data, so they are not trusted.
+    if (cursor >= index.offsets().size()) {
+        throw std::runtime_error("Error: The subtree index has less offsets than the octree has nodes!");
+    }
+    const std::size_t offset = index.offsets()[cursor++];
+    if (offset > data.size() * 8) {
+        throw std::runtime_error("Error: An offset of the subtree index lies behind the end of the octree data!");
+    }
+    BitStream stream(data.data(), data.size(), offset);
+    const auto bits = stream.get(2);
+    if (!bits) {
+        throw std::runtime_error("Error: Octree data ended before the type of a cube was read!");
+    }
+    const auto type = static_cast<CubeType>(*bits);
+    if (type == CubeType::EMPTY || type == CubeType::FULL) {
+        return std::make_shared<Cube>(type, size, position);
     }
-    if (y) {
-        this->y_level = *y;
+    if (type == CubeType::OCTANT && depth < index.depth()) {
+        const float half = size / 2;
+        std::array<std::shared_ptr<Cube>, 8> octants;
+        for (std::uint32_t i = 0; i < 8; i++) {
+            const glm::vec3 octant_position = {position.x + ((i & 4) ? half : 0.0f),
+                                               position.y + ((i & 2) ? half : 0.0f),
+                                               position.z + ((i & 1) ? half : 0.0f)};
+            octants[i] = parse_indexed(data, thread_pool, index, cursor, depth + 1, half, octant_position, tasks);
+        }
+        return std::make_shared<Cube>(octants, size, position);
     }
-    if (z) {
-        this->z_level = *z;
+
+    // Each placeholder is written by exactly one task.
+    auto cube = std::make_shared<Cube>(CubeType::EMPTY, size, position);
+    tasks.push_back(thread_pool.execute([&data, cube, offset, size, position]() {
+        BitStream subtree(data.data(), data.size(), offset);
+        *cube = Cube::parse(subtree, size, position);
+    }));
+    return cube;
+}
+
+/// Collect the subtrees of an octree at a depth in the order of Cube::polygons, leaves above the depth are subtrees of
+/// their own.
+/// @param cube The cube.
+/// @param depth The depth of the cube.
+/// @param split_depth The depth of the subtrees.
+/// @param subtrees The subtrees.
+void collect_subtrees(Cube &cube, std::uint32_t depth, std::uint32_t split_depth, std::vector<Cube *> &subtrees) {
+    if (cube.type() == CubeType::OCTANT && depth < split_depth) {
+        for (const auto &octant : *cube.octants) {
+            collect_subtrees(*octant, depth + 1, split_depth, subtrees);
+        }
+        return;
     }
+    subtrees.push_back(&cube);
+}
+} // namespace
+
+void Indentation::set(std::optional<std::uint8_t> x, std::optional<std::uint8_t> y, std::optional<std::uint8_t> z) {
+    assert(x <= MAX_INDENTATION && y <= MAX_INDENTATION && z <= MAX_INDENTATION);
+    this->set_levels(x.value_or(this->x()), y.value_or(this->y()), z.value_or(this->z()));
     this->change();
 }
 
 void Indentation::set_x(std::uint8_t x) {
     assert(x <= MAX_INDENTATION);
-    this->x_level = x;
+    this->set_levels(x, this->y(), this->z());
     this->change();
 }
 
 void Indentation::set_y(std::uint8_t y) {
     assert(y <= MAX_INDENTATION);
-    this->y_level = y;
+    this->set_levels(this->x(), y, this->z());
     this->change();
 }
 
 void Indentation::set_z(std::uint8_t z) {
     assert(z <= MAX_INDENTATION);
-    this->z_level = z;
+    this->set_levels(this->x(), this->y(), z);
     this->change();
 }
 
 std::uint8_t Indentation::x() const {
-    return this->x_level;
+    return static_cast<std::uint8_t>(this->levels & LEVEL_MASK);
 }
 
 std::uint8_t Indentation::y() const {
-    return this->y_level;
+    return static_cast<std::uint8_t>(this->levels >> LEVEL_BITS & LEVEL_MASK);
 }
 
 std::uint8_t Indentation::z() const {
-    return this->z_level;
+    return static_cast<std::uint8_t>(this->levels >> (2 * LEVEL_BITS) & LEVEL_MASK);
+}
+
+void Indentation::set_levels(std::uint8_t x, std::uint8_t y, std::uint8_t z) {
+    this->levels = static_cast<std::uint16_t>(x | y << LEVEL_BITS | z << (2 * LEVEL_BITS));
 }
 
 Indentation Indentation::parse(BitStream &stream) {
-    // Parse each indentation level one by one.
-    return Indentation(Indentation::parse_one(stream), Indentation::parse_one(stream), Indentation::parse_one(stream));
+    const glm::tvec3<std::uint8_t> levels = Indentation::parse_levels(stream);
+    return Indentation(levels.x, levels.y, levels.z);
+}
+
+glm::tvec3<std::uint8_t> Indentation::parse_levels(BitStream &stream) {
+    // Parse each indentation level one by one, the evaluation order of function arguments is unspecified.
+    const std::uint8_t x = Indentation::parse_one(stream);
+    const std::uint8_t y = Indentation::parse_one(stream);
+    const std::uint8_t z = Indentation::parse_one(stream);
+    return {x, y, z};
 }
 
 std::uint8_t Indentation::parse_one(BitStream &stream) {
-    bool indented = stream.get(1).value();
-    if (indented) {
+    const auto indented = stream.get(1);
+    if (!indented) {
+        throw std::runtime_error("Error: Octree data ended before the indentations were read!");
+    }
+    if (*indented != 0) {
         // If it is indented it cannot be 0.
         // Thus the format saves the real value - 1.
-        return stream.get(3).value() + 1;
+        const auto level = stream.get(3);
+        if (!level) {
+            throw std::runtime_error("Error: Octree data ended before the indentations were read!");
+        }
+        return static_cast<std::uint8_t>(*level + 1);
     }
     return 0;
 }
@@ -66,45 +155,41 @@ Indentation::Indentation() = default;
 
 Indentation::Indentation(std::uint8_t x, std::uint8_t y, std::uint8_t z) {
     assert(x <= MAX_INDENTATION && y <= MAX_INDENTATION && z <= MAX_INDENTATION);
-    this->x_level = x;
-    this->y_level = y;
-    this->z_level = z;
+    this->set_levels(x, y, z);
 }
 
-Indentation::Indentation(const Indentation &indentation)
-    : Indentation(indentation.x_level, indentation.y_level, indentation.z_level) {}
+Indentation::Indentation(const Indentation &indentation) : levels(indentation.levels) {}
 
-Indentation::Indentation(Indentation &&indentation) noexcept
-    : Indentation(indentation.x_level, indentation.y_level, indentation.z_level) {}
+Indentation::Indentation(Indentation &&indentation) noexcept : levels(indentation.levels) {}
 
 glm::tvec3<std::uint8_t> Indentation::vec() const {
-    return {this->x_level, this->y_level, this->z_level};
+    return {this->x(), this->y(), this->z()};
 }
 
 Indentation &Indentation::operator=(const Indentation &rhs) {
     if (this->copy_values(rhs)) {
-        this->on_change(this);
+        this->change();
     }
     return *this;
 }
 
 bool Indentation::equal_values(const glm::tvec3<uint8_t> &other) const {
-    return this->x_level != other.x && this->y_level != other.y && this->z_level != other.z;
+    return this->x() == other.x && this->y() == other.y && this->z() == other.z;
 }
 
 bool Indentation::equal_values(const Indentation &other) const {
-    return this->x_level == other.x_level && this->y_level == other.y_level && this->z_level == other.z_level;
+    return this->levels == other.levels;
 }
 
 void Indentation::change() {
-    this->on_change(this);
+    if (this->owner != nullptr) {
+        this->owner->change();
+    }
 }
 
 bool Indentation::copy_values(const Indentation &indentation) {
     if (this != &indentation && !this->equal_values(indentation)) {
-        this->x_level = indentation.x_level;
-        this->y_level = indentation.y_level;
-        this->z_level = indentation.z_level;
+        this->levels = indentation.levels;
         return true;
     }
     return false;
@@ -115,27 +200,26 @@ Indentation &Indentation::operator=(const glm::tvec3<uint8_t> &rhs) {
     assert(rhs.y >= 0 && rhs.y <= MAX_INDENTATION);
     assert(rhs.z >= 0 && rhs.z <= MAX_INDENTATION);
     if (!this->equal_values(rhs)) {
-        this->x_level = rhs.x;
-        this->y_level = rhs.y;
-        this->z_level = rhs.z;
-        this->on_change(this);
+        this->set_levels(rhs.x, rhs.y, rhs.z);
+        this->change();
     }
     return *this;
 }
 
 Indentation &Indentation::operator=(Indentation &&lhs) noexcept {
     if (this->copy_values(lhs)) {
-        this->on_change(this);
+        this->change();
     }
     return *this;
 }
 
 Indentation &Indentation::operator+=(const glm::tvec3<int8_t> &other) {
     if (other.x != 0 || other.y != 0 || other.z != 0) {
-        this->x_level = std::clamp(this->x_level + other.x, 0, static_cast<int>(MAX_INDENTATION));
-        this->y_level = std::clamp(this->y_level + other.y, 0, static_cast<int>(MAX_INDENTATION));
-        this->z_level = std::clamp(this->z_level + other.z, 0, static_cast<int>(MAX_INDENTATION));
-        this->on_change(this);
+        const auto clamp = [](int level) {
+            return static_cast<std::uint8_t>(std::clamp(level, 0, static_cast<int>(MAX_INDENTATION)));
+        };
+        this->set_levels(clamp(this->x() + other.x), clamp(this->y() + other.y), clamp(this->z() + other.z));
+        this->change();
     }
     return *this;
 }
@@ -178,68 +262,167 @@ Cube::Cube(const Cube &cube)
 Cube::Cube(Cube &&cube) noexcept
     : Cube(cube.cube_type, cube.cube_size, cube.cube_position, cube.indentations, cube.octants) {}
 
+Cube::~Cube() {
+    if (this->journaled) {
+        this->change_journal->forget(this);
+    }
+    // Octants may outlive this cube when they are shared.
+    if (this->octants) {
+        for (auto &octant : *this->octants) {
+            if (octant && octant->parent == this) {
+                octant->parent = nullptr;
+            }
+        }
+    }
+}
+
 Cube &Cube::operator=(Cube &&lhs) noexcept {
     if (this->copy_values(lhs)) {
-        this->on_change(this);
+        this->change();
     }
     return *this;
 }
 
 Cube &Cube::operator=(const Cube &rhs) {
     if (this->copy_values(rhs)) {
-        this->on_change(this);
+        this->change();
     }
     return *this;
 }
 
+std::shared_ptr<Cube> Cube::clone() const {
+    auto copy = std::make_shared<Cube>(*this);
+    if (copy->octants) {
+        for (auto &octant : *copy->octants) {
+            octant = octant->clone();
+        }
+    }
+    return copy;
+}
+
 bool Cube::copy_values(const Cube &cube) {
     if (this != &cube) {
+        auto octants = cube.octants;
+        if (this->change_journal && octants) {
+            // A reactive octree does not share subtrees with the copied cube: a shared subtree would only notify the
+            // cube it was attached to last about its changes, and edits of it would change the copied cube as well.
+            for (auto &octant : *octants) {
+                octant = octant->clone();
+            }
+        }
+        if (this->octants) {
+            for (auto &octant : *this->octants) {
+                if (octant && octant->parent == this) {
+                    octant->parent = nullptr;
+                }
+            }
+        }
         this->cube_position = cube.cube_position;
         this->cube_size = cube.cube_size;
         this->cube_type = cube.cube_type;
-        this->octants = cube.octants;
         this->indentations = cube.indentations;
+        // The copied cube may be a descendant of this cube, which is destroyed together with the previous octants.
+        this->octants = std::move(octants);
+        if (this->change_journal) {
+            // New indentations and octants record their changes in the journal of this octree as well.
+            this->attach(this->change_journal, false);
+        }
         return true;
     }
     return false;
 }
 
 void Cube::make_reactive(bool force) {
-    if (!force && this->is_reactive) {
+    if (!this->change_journal) {
+        this->attach(std::make_shared<ChangeJournal>(), force);
         return;
     }
+    this->attach(this->change_journal, force);
+}
+
+void Cube::attach(const std::shared_ptr<ChangeJournal> &journal, bool force) {
+    this->change_journal = journal;
+    this->aggregated = false;
     if (this->indentations) {
         for (auto &indentation : *this->indentations) {
-            indentation.on_change.connect([this](Indentation *i) { this->change(i); });
+            indentation.owner = this;
         }
     }
     if (this->octants) {
         for (auto &octant : *this->octants) {
-            octant->make_reactive(force);
-            octant->on_change.connect([this](Cube *o) { this->change(); });
+            // A subtree which is shared by several cubes notifies the one it was attached to last, which is why the
+            // cubes sharing it do not cache aggregates (see Cube::aggregate).
+            octant->parent = this;
+            // Every cube is attached together with its subtree, so attached subtrees are complete.
+            if (force || octant->change_journal != journal) {
+                octant->attach(journal, force);
+            }
         }
     }
 }
 
+const std::shared_ptr<ChangeJournal> &Cube::journal() const {
+    return this->change_journal;
+}
+
 Cube Cube::parse(std::vector<unsigned char> &data) {
     BitStream stream = BitStream(data.data(), data.size());
     return Cube::parse(stream);
 }
 
+Cube Cube::parse(const std::vector<unsigned char> &data, ThreadPool &thread_pool, const SubtreeIndex &index) {
+    std::vector<std::future<void>> tasks;
+    std::size_t cursor = 0;
+    std::shared_ptr<Cube> root;
+    try {
+        root = parse_indexed(data, thread_pool, index, cursor, 0, DEFAULT_CUBE_SIZE, DEFAULT_CUBE_POSITION, tasks);
+    } catch (...) {
+        // The tasks which have been scheduled already reference the data.
+        for (auto &task : tasks) {
+            task.wait();
+        }
+        throw;
+    }
+    // Wait for all tasks before rethrowing parse errors, as the tasks reference the data.
+    for (auto &task : tasks) {
+        task.wait();
+    }
+    for (auto &task : tasks) {
+        task.get();
+    }
+    return *root;
+}
+
+Cube Cube::parse(const std::vector<unsigned char> &data, ThreadPool &thread_pool, std::uint32_t split_depth) {
+    const auto index = SubtreeIndex::build(data.data(), data.size(), split_depth);
+    if (!index) {
+        throw std::runtime_error("Error: Octree data ended before all octants were read!");
+    }
+    return Cube::parse(data, thread_pool, *index);
+}
+
 Cube Cube::parse(BitStream &stream) {
     return Cube::parse(stream, DEFAULT_CUBE_SIZE, DEFAULT_CUBE_POSITION);
 }
 
 Cube Cube::parse(BitStream &stream, float size, const glm::vec3 &position) {
-    CubeType type = static_cast<CubeType>(stream.get(2).value());
+    const auto bits = stream.get(2);
+    if (!bits) {
+        throw std::runtime_error("Error: Octree data ended before the type of a cube was read!");
+    }
+    const auto type = static_cast<CubeType>(*bits);
     if (type == CubeType::EMPTY || type == CubeType::FULL) {
         return Cube(type, size, position);
     }
     if (type == CubeType::INDENTED) {
         // Parse indentations
+        const auto levels = stream.get_indentations();
+        if (!levels) {
+            throw std::runtime_error("Error: Octree data ended before the indentations were read!");
+        }
         std::array<Indentation, 8> indentations;
         for (std::uint8_t i = 0; i < 8; i++) {
-            indentations[i] = Indentation::parse(stream);
+            indentations[i] = Indentation((*levels)[i].x, (*levels)[i].y, (*levels)[i].z);
         }
         return Cube(indentations, size, position);
     }
@@ -264,51 +447,214 @@ Cube Cube::parse(BitStream &stream, float size, const glm::vec3 &position) {
     return Cube(octants, size, position);
 }
 
+std::vector<unsigned char> Cube::serialize() const {
+    BitStreamWriter writer;
+    this->serialize(writer);
+    return writer.finish();
+}
+
+void Cube::serialize(BitStreamWriter &writer) const {
+    writer.put(static_cast<std::uint8_t>(this->cube_type), 2);
+    if (this->cube_type == CubeType::INDENTED) {
+        std::array<glm::tvec3<std::uint8_t>, 8> levels;
+        for (std::size_t i = 0; i < levels.size(); i++) {
+            levels[i] = (*this->indentations)[i].vec();
+        }
+        writer.put_indentations(levels);
+        return;
+    }
+    if (this->cube_type == CubeType::OCTANT) {
+        for (const auto &octant : *this->octants) {
+            octant->serialize(writer);
+        }
+    }
+}
+
 CubeType Cube::type() {
     return this->cube_type;
 }
 
-std::vector<std::array<glm::vec3, 3>> Cube::polygons() {
-    std::vector<std::array<glm::vec3, 3>> polygons;
-
-    std::uint64_t i = 0;
+float Cube::size() const {
+    return this->cube_size;
+}
 
-    polygons.resize(this->leaves() * 12);
+glm::vec3 Cube::position() const {
+    return this->cube_position;
+}
 
-    auto *polygons_pointer = polygons.data();
-    this->all_polygons(polygons_pointer);
+std::vector<std::array<glm::vec3, 3>> Cube::polygons() {
+    std::vector<std::array<glm::vec3, 3>> polygons;
+    polygons.reserve(this->leaves() * 12);
+    this->polygons(polygons);
     return polygons;
 }
 
-void Cube::all_polygons(std::array<glm::vec3, 3> *&polygons) {
+void Cube::polygons(std::vector<std::array<glm::vec3, 3>> &polygons) {
     if (this->cube_type == CubeType::EMPTY) {
         return;
     }
     if (this->cube_type == CubeType::OCTANT) {
         for (const auto &octant : *this->octants) {
-            octant->all_polygons(polygons);
+            octant->polygons(polygons);
         }
         return;
     }
 
     // _type == (FULL or INDENTED)
-    if (!this->valid_cache) {
-        if (this->cube_type == CubeType::FULL) {
-            this->polygons_cache = this->full_polygons();
-        } else {
-            this->polygons_cache = this->indented_polygons();
+    const auto cube_polygons = this->cube_type == CubeType::FULL
+                                   ? Cube::leaf_polygons(this->cube_type, this->cube_size, this->cube_position, {})
+                                   : Cube::leaf_polygons(this->cube_type, this->cube_size, this->cube_position,
+                                                         this->indentation_levels());
+    polygons.insert(polygons.end(), cube_polygons.begin(), cube_polygons.end());
+}
+
+std::vector<std::array<glm::vec3, 3>> Cube::polygons(ThreadPool &thread_pool, std::uint32_t split_depth) {
+    std::vector<Cube *> subtrees;
+    collect_subtrees(*this, 0, split_depth, subtrees);
+
+    // The range of subtree i starts at offsets[i] leaves, after the prefix sum of the leaf counts.
+    std::vector<std::uint64_t> offsets(subtrees.size() + 1, 0);
+    std::vector<std::future<void>> tasks;
+    tasks.reserve(subtrees.size());
+    for (std::size_t i = 0; i < subtrees.size(); i++) {
+        tasks.push_back(thread_pool.execute([&subtrees, &offsets, i]() { offsets[i + 1] = subtrees[i]->leaves(); }));
+    }
+    for (auto &task : tasks) {
+        task.get();
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    std::vector<std::array<glm::vec3, 3>> polygons(offsets.back() * 12);
+    tasks.clear();
+    for (std::size_t i = 0; i < subtrees.size(); i++) {
+        if (offsets[i] == offsets[i + 1]) {
+            continue;
         }
-        this->valid_cache = true;
+        tasks.push_back(thread_pool.execute([&subtrees, &offsets, &polygons, i]() {
+            std::array<glm::vec3, 3> *range = polygons.data() + offsets[i] * 12;
+            const std::array<glm::vec3, 3> *end = polygons.data() + offsets[i + 1] * 12;
+            subtrees[i]->write_polygons(range, end);
+            if (range != end) {
+                throw std::runtime_error("Error: The subtree has less leaves than it was counted with!");
+            }
+        }));
+    }
+    // Wait for all tasks before rethrowing errors, as the tasks reference the polygons.
+    for (auto &task : tasks) {
+        task.wait();
     }
+    for (auto &task : tasks) {
+        task.get();
+    }
+    return polygons;
+}
 
-    // TODO: Let polygons return std::array of pointers to cache instead of copying the value.
-    for (const auto polygon : this->polygons_cache) {
-        *polygons = polygon;
-        polygons++;
+void Cube::write_polygons(std::array<glm::vec3, 3> *&polygons, const std::array<glm::vec3, 3> *end) {
+    if (this->cube_type == CubeType::EMPTY) {
+        return;
+    }
+    if (this->cube_type == CubeType::OCTANT) {
+        for (const auto &octant : *this->octants) {
+            octant->write_polygons(polygons, end);
+        }
+        return;
     }
+    if (end - polygons < 12) {
+        throw std::runtime_error("Error: The subtree has more leaves than it was counted with!");
+    }
+    const auto cube_polygons = this->cube_type == CubeType::FULL
+                                   ? Cube::leaf_polygons(this->cube_type, this->cube_size, this->cube_position, {})
+                                   : Cube::leaf_polygons(this->cube_type, this->cube_size, this->cube_position,
+                                                         this->indentation_levels());
+    polygons = std::copy(cube_polygons.begin(), cube_polygons.end(), polygons);
 }
 
 std::uint64_t Cube::leaves() {
+    // Only a reactive octree caches the aggregates, so the bounds are worth computing along with the leaves.
+    if (this->change_journal) {
+        return this->aggregate().leaves;
+    }
+    return this->count_leaves();
+}
+
+std::uint64_t Cube::triangles() {
+    return this->leaves() * 12;
+}
+
+std::optional<std::array<glm::vec3, 2>> Cube::bounds() {
+    const Aggregates aggregates = this->aggregate();
+    if (aggregates.leaves == 0) {
+        return std::nullopt;
+    }
+    return std::array<glm::vec3, 2>{aggregates.min, aggregates.max};
+}
+
+Cube *Cube::find(const glm::vec3 &point) {
+    Cube *current = this;
+    while (current->cube_type == CubeType::OCTANT) {
+        const glm::vec3 center = current->cube_position + current->cube_size / 2;
+        const std::size_t octant =
+            (point.x >= center.x ? 4 : 0) | (point.y >= center.y ? 2 : 0) | (point.z >= center.z ? 1 : 0);
+        current = (*current->octants)[octant].get();
+    }
+    return current;
+}
+
+Cube::Aggregates Cube::aggregate() {
+    if (this->aggregated) {
+        return this->aggregates;
+    }
+    Aggregates result;
+    bool cacheable = true;
+    switch (this->cube_type) {
+    case CubeType::EMPTY:
+        break;
+    case CubeType::FULL:
+        result = {1, this->cube_position, this->cube_position + glm::vec3(this->cube_size)};
+        break;
+    case CubeType::INDENTED: {
+        const auto vertices = Cube::leaf_vertices(this->cube_type, this->cube_size, this->cube_position,
+                                                  this->indentation_levels());
+        result = {1, vertices[0], vertices[0]};
+        for (const auto &vertex : vertices) {
+            result.min = glm::min(result.min, vertex);
+            result.max = glm::max(result.max, vertex);
+        }
+        break;
+    }
+    case CubeType::OCTANT:
+        for (const auto &octant : *this->octants) {
+            // A subtree which is shared by several cubes (e.g. after assigning a cube to another one) only tells the
+            // cube it was attached to last about its changes, so the cubes which share it do not cache aggregates.
+            if (octant.use_count() > 1) {
+                cacheable = false;
+            } else if (this->change_journal) {
+                // The only owner of the subtree has to be notified, even if another one was attached to it last.
+                octant->parent = this;
+            }
+            const Aggregates child = octant->aggregate();
+            cacheable = cacheable && octant->aggregated;
+            if (child.leaves == 0) {
+                continue;
+            }
+            result.min = result.leaves == 0 ? child.min : glm::min(result.min, child.min);
+            result.max = result.leaves == 0 ? child.max : glm::max(result.max, child.max);
+            result.leaves += child.leaves;
+        }
+        break;
+    }
+    // Only reactive octrees notice their changes, in other octrees the cache could become outdated silently.
+    if (this->change_journal && cacheable) {
+        this->aggregates = result;
+        this->aggregated = true;
+    }
+    return result;
+}
+
+std::uint64_t Cube::count_leaves() const {
+    if (this->aggregated) {
+        return this->aggregates.leaves;
+    }
     switch (this->cube_type) {
     case CubeType::EMPTY:
         return 0;
@@ -316,17 +662,24 @@ std::uint64_t Cube::leaves() {
     case CubeType::INDENTED:
         return 1;
     case CubeType::OCTANT:
-        std::uint64_t i = 0;
-        for (const auto &octant : *this->octants) {
-            i += octant->leaves();
-        }
-        return i;
+        break;
+    }
+    std::uint64_t leaves = 0;
+    for (const auto &octant : *this->octants) {
+        leaves += octant->count_leaves();
+    }
+    return leaves;
+}
+
+void Cube::invalidate_aggregates() {
+    this->aggregated = false;
+    // Ancestors of an outdated cube are outdated already.
+    for (Cube *cube = this->parent; cube != nullptr && cube->aggregated; cube = cube->parent) {
+        cube->aggregated = false;
     }
-    assert(false); // This point should never be reached, as we handled all types already.
-    return 0;
 }
 
-std::array<std::array<glm::vec3, 3>, 12> Cube::full_polygons(std::array<glm::vec3, 8> &v) {
+std::array<std::array<glm::vec3, 3>, 12> Cube::full_polygons(const std::array<glm::vec3, 8> &v) {
     return {{
         {{v[0], v[2], v[1]}}, // x = 0
         {{v[1], v[2], v[3]}}, // x = 0
@@ -348,20 +701,9 @@ std::array<std::array<glm::vec3, 3>, 12> Cube::full_polygons(std::array<glm::vec
     }};
 }
 
-std::array<std::array<glm::vec3, 3>, 12> Cube::full_polygons() {
-    assert(this->cube_type == CubeType::FULL);
-
-    std::array<glm::vec3, 8> v = this->vertices();
-    return this->full_polygons(v);
-}
-
-std::array<std::array<glm::vec3, 3>, 12> Cube::indented_polygons() {
-    assert(this->cube_type == CubeType::INDENTED);
-
-    std::array<glm::vec3, 8> v = this->vertices();
-
-    std::array<std::array<glm::vec3, 3>, 12> vertices = this->full_polygons(v);
-    std::array<glm::tvec3<std::uint8_t>, 8> in = this->indentation_levels();
+std::array<std::array<glm::vec3, 3>, 12>
+Cube::indented_polygons(const std::array<glm::vec3, 8> &v, const std::array<glm::tvec3<std::uint8_t>, 8> &in) {
+    std::array<std::array<glm::vec3, 3>, 12> vertices = Cube::full_polygons(v);
 
     // Check for each side if the side is convex, rotate the hypotenuse so it becomes convex!
     // x = 0
@@ -402,14 +744,15 @@ std::array<std::array<glm::vec3, 3>, 12> Cube::indented_polygons() {
     return vertices;
 }
 
-std::array<glm::vec3, 8> Cube::vertices() {
-    assert(this->cube_type == CubeType::FULL || this->cube_type == CubeType::INDENTED);
-    glm::vec3 &p = this->cube_position;
+std::array<glm::vec3, 8> Cube::leaf_vertices(CubeType type, float size, const glm::vec3 &position,
+                                             const std::array<glm::tvec3<std::uint8_t>, 8> &levels) {
+    assert(type == CubeType::FULL || type == CubeType::INDENTED);
+    const glm::vec3 &p = position;
 
     // Most distant corner of a "full" cube (from p)
-    glm::vec3 f = {p.x + this->cube_size, p.y + this->cube_size, p.z + this->cube_size};
+    glm::vec3 f = {p.x + size, p.y + size, p.z + size};
 
-    if (this->cube_type == CubeType::FULL) {
+    if (type == CubeType::FULL) {
         return std::array<glm::vec3, 8>{{{p.x, p.y, p.z},
                                          {p.x, p.y, f.z},
                                          {p.x, f.y, p.z},
@@ -419,10 +762,9 @@ std::array<glm::vec3, 8> Cube::vertices() {
                                          {f.x, f.y, p.z},
                                          {f.x, f.y, f.z}}};
     }
-    assert(this->cube_type == CubeType::INDENTED);
-    const float step = this->cube_size / MAX_INDENTATION;
-
-    std::array<glm::tvec3<std::uint8_t>, 8> in = this->indentation_levels();
+    assert(type == CubeType::INDENTED);
+    const float step = size / MAX_INDENTATION;
+    const std::array<glm::tvec3<std::uint8_t>, 8> &in = levels;
 
     // Calculate the vertex-positions with respect to the indentation level.
     return std::array<glm::vec3, 8>{{{p.x + step * in[0].x, p.y + step * in[0].y, p.z + step * in[0].z},
@@ -435,17 +777,22 @@ std::array<glm::vec3, 8> Cube::vertices() {
                                      {f.x - step * in[7].x, f.y - step * in[7].y, f.z - step * in[7].z}}};
 }
 
-void Cube::invalidate_cache() {
-    this->valid_cache = false;
+std::array<std::array<glm::vec3, 3>, 12>
+Cube::leaf_polygons(CubeType type, float size, const glm::vec3 &position,
+                    const std::array<glm::tvec3<std::uint8_t>, 8> &levels) {
+    if (type == CubeType::FULL) {
+        return Cube::full_polygons(Cube::leaf_vertices(type, size, position, levels));
+    }
+    assert(type == CubeType::INDENTED);
+    return Cube::indented_polygons(Cube::leaf_vertices(type, size, position, levels), levels);
 }
 
 void Cube::change() {
-    this->invalidate_cache();
-    this->on_change(this);
-}
-
-void Cube::change(Indentation *indentation) {
-    this->change();
+    this->invalidate_aggregates();
+    if (this->change_journal && !this->journaled) {
+        this->journaled = true;
+        this->change_journal->record(this);
+    }
 }
 
 std::array<glm::tvec3<std::uint8_t>, 8> Cube::indentation_levels() {
@@ -0,0 +1,36 @@
+#include "inexor/vulkan-renderer/world/frustum.hpp"
+
+#include <cmath>
+
+namespace inexor::vulkan_renderer::world {
+Frustum::Frustum(const glm::mat4 &matrix) {
+    // The planes are combinations of the rows of the matrix (Gribb and Hartmann), glm matrices are column major.
+    const auto row = [&matrix](int i) { return glm::vec4(matrix[0][i], matrix[1][i], matrix[2][i], matrix[3][i]); };
+    const glm::vec4 x = row(0);
+    const glm::vec4 y = row(1);
+    const glm::vec4 z = row(2);
+    const glm::vec4 w = row(3);
+    this->planes = {w + x, w - x, w + y, w - y, z, w - z};
+    for (auto &plane : this->planes) {
+        plane /= std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+    }
+}
+
+Frustum::Intersection Frustum::intersect(const glm::vec3 &min, const glm::vec3 &max) const {
+    Intersection intersection = Intersection::INSIDE;
+    for (const auto &plane : this->planes) {
+        // The corners of the box which are the furthest in front of and behind the plane.
+        const glm::vec3 front = {plane.x >= 0 ? max.x : min.x, plane.y >= 0 ? max.y : min.y,
+                                 plane.z >= 0 ? max.z : min.z};
+        const glm::vec3 back = {plane.x >= 0 ? min.x : max.x, plane.y >= 0 ? min.y : max.y,
+                                plane.z >= 0 ? min.z : max.z};
+        if (plane.x * front.x + plane.y * front.y + plane.z * front.z + plane.w < 0) {
+            return Intersection::OUTSIDE;
+        }
+        if (plane.x * back.x + plane.y * back.y + plane.z * back.z + plane.w < 0) {
+            intersection = Intersection::INTERSECTING;
+        }
+    }
+    return intersection;
+}
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,451 @@
+#include "inexor/vulkan-renderer/world/incremental_mesh.hpp"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// Get the polygons of a leaf, degenerated polygons if it is empty.
+/// @param cube The leaf.
+/// @return polygons of the leaf.
+std::array<std::array<glm::vec3, 3>, 12> leaf_polygons(Cube &cube) {
+    const CubeType type = cube.type();
+    if (type == CubeType::EMPTY) {
+        return {};
+    }
+    std::array<glm::tvec3<std::uint8_t>, 8> levels{};
+    if (type == CubeType::INDENTED) {
+        for (std::size_t i = 0; i < levels.size(); i++) {
+            levels[i] = (*cube.indentations)[i].vec();
+        }
+    }
+    return Cube::leaf_polygons(type, cube.size(), cube.position(), levels);
+}
+
+/// Get whether an octant touches a side of its parent.
+constexpr bool touches(std::size_t octant, std::size_t face) {
+    return ((octant & (4u >> face / 2)) != 0) == (face % 2 == 1);
+}
+} // namespace
+
+IncrementalMesh::IncrementalMesh(std::shared_ptr<Cube> root, const std::optional<LodOptions> &lod_options,
+                                 MeshOptions options)
+    : root(std::move(root)), options(std::move(options)) {
+    if (lod_options) {
+        this->level_of_detail.emplace(*lod_options);
+    }
+    assert(this->root);
+    this->root->make_reactive();
+    this->journal = this->root->journal();
+    this->subscription = this->journal->subscribe([this](const std::vector<Cube *> &cubes) { this->change(cubes); });
+}
+
+IncrementalMesh::~IncrementalMesh() {
+    this->journal->unsubscribe(this->subscription);
+}
+
+void IncrementalMesh::change(const std::vector<Cube *> &cubes) {
+    for (Cube *cube : cubes) {
+        if (this->rebuild_required) {
+            return;
+        }
+        if (this->slots.count(cube) == 0) {
+            // Only leaves own a slot, any other change affects the structure of the octree.
+            this->rebuild_required = true;
+            this->dirty.clear();
+            return;
+        }
+        this->dirty.insert(cube);
+    }
+}
+
+void IncrementalMesh::insert(Cube &cube) {
+    const std::size_t node = this->nodes.size();
+    const std::size_t first = this->mesh.size();
+    this->nodes.push_back({cube.position(), cube.position() + cube.size(), {first, 0}, node + 1, &cube});
+    switch (cube.type()) {
+    case CubeType::EMPTY:
+        break;
+    case CubeType::FULL:
+    case CubeType::INDENTED:
+        this->insert_slot(cube, this->slot_polygons(cube));
+        break;
+    case CubeType::OCTANT:
+        for (const auto &octant : *cube.octants) {
+            this->insert(*octant);
+        }
+        if (this->level_of_detail && this->level_of_detail->is_collapsed(&cube)) {
+            this->collapse(cube);
+        }
+        break;
+    }
+    if (this->mesh.size() == first) {
+        // Nodes without polygons are not needed for culling.
+        this->nodes.resize(node);
+        return;
+    }
+    this->nodes[node].polygons.count = this->mesh.size() - first;
+    this->nodes[node].end = this->nodes.size();
+    if (this->level_of_detail && cube.type() == CubeType::OCTANT) {
+        // The approximation of a collapsed subtree may cover all of its cube.
+        return;
+    }
+    if (node + 1 < this->nodes.size()) {
+        // The bounds of the polygons are within the bounds of the octants which own polygons.
+        this->nodes[node].min = this->nodes[node + 1].min;
+        this->nodes[node].max = this->nodes[node + 1].max;
+        for (std::size_t child = node + 1; child < this->nodes.size(); child = this->nodes[child].end) {
+            this->nodes[node].min = glm::min(this->nodes[node].min, this->nodes[child].min);
+            this->nodes[node].max = glm::max(this->nodes[node].max, this->nodes[child].max);
+        }
+    }
+}
+
+std::array<std::uint16_t, Mesher::FACES> IncrementalMesh::face_materials(Cube &cube) const {
+    std::array<std::uint16_t, Mesher::FACES> materials{};
+    if (this->options.material) {
+        for (std::size_t face = 0; face < Mesher::FACES; face++) {
+            materials[face] = this->options.material(cube, face);
+        }
+    }
+    return materials;
+}
+
+Cube *IncrementalMesh::neighbour(const Cube &cube, std::size_t face) const {
+    // The center of the neighbouring cube of the same size.
+    glm::vec3 center = cube.position() + cube.size() / 2;
+    center[static_cast<int>(face / 2)] += face % 2 == 1 ? cube.size() : -cube.size();
+    const glm::vec3 min = this->root->position();
+    const glm::vec3 max = min + this->root->size();
+    for (int i = 0; i < 3; i++) {
+        if (center[i] < min[i] || center[i] >= max[i]) {
+            return nullptr;
+        }
+    }
+    Cube *current = this->root.get();
+    while (current->type() == CubeType::OCTANT && current->size() > cube.size()) {
+        if (this->level_of_detail && this->level_of_detail->is_collapsed(current)) {
+            return nullptr;
+        }
+        const glm::vec3 middle = current->position() + current->size() / 2;
+        const std::size_t octant =
+            (center.x >= middle.x ? 4 : 0) | (center.y >= middle.y ? 2 : 0) | (center.z >= middle.z ? 1 : 0);
+        current = (*current->octants)[octant].get();
+    }
+    return current;
+}
+
+bool IncrementalMesh::is_covered(Cube *cube, std::size_t face) const {
+    if (cube == nullptr || (this->level_of_detail && this->level_of_detail->is_collapsed(cube))) {
+        return false;
+    }
+    if (cube->type() != CubeType::OCTANT) {
+        return Mesher::is_covered(cube, face);
+    }
+    for (std::size_t octant = 0; octant < 8; octant++) {
+        if (touches(octant, face) && !this->is_covered((*cube->octants)[octant].get(), face)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::array<std::array<glm::vec3, 3>, 12> IncrementalMesh::slot_polygons(Cube &leaf) const {
+    auto polygons = leaf_polygons(leaf);
+    if (!this->options.cull_hidden_faces || leaf.type() == CubeType::EMPTY) {
+        return polygons;
+    }
+    for (std::size_t face = 0; face < Mesher::FACES; face++) {
+        // The neighbouring cube touches this face with its opposite face.
+        if (Mesher::is_on_side(leaf, face) && this->is_covered(this->neighbour(leaf, face), face ^ 1)) {
+            polygons[2 * face] = {};
+            polygons[2 * face + 1] = {};
+        }
+    }
+    return polygons;
+}
+
+void IncrementalMesh::patch(Cube &leaf) {
+    const std::size_t first = this->slots.at(&leaf);
+    const auto polygons = this->slot_polygons(leaf);
+    std::copy(polygons.begin(), polygons.end(), this->mesh.begin() + static_cast<std::ptrdiff_t>(first));
+    this->materials[first / SLOT_SIZE] = this->face_materials(leaf);
+    this->changed.push_back(first);
+}
+
+void IncrementalMesh::patch_neighbours(Cube &cube) {
+    if (!this->options.cull_hidden_faces) {
+        return;
+    }
+    std::vector<Cube *> leaves;
+    for (std::size_t face = 0; face < Mesher::FACES; face++) {
+        if (Cube *neighbour = this->neighbour(cube, face)) {
+            this->collect_touching(*neighbour, face ^ 1, leaves);
+        }
+    }
+    for (Cube *leaf : leaves) {
+        this->patch(*leaf);
+    }
+}
+
+void IncrementalMesh::collect_touching(Cube &cube, std::size_t face, std::vector<Cube *> &leaves) const {
+    if (cube.type() == CubeType::OCTANT) {
+        for (std::size_t octant = 0; octant < 8; octant++) {
+            if (touches(octant, face)) {
+                this->collect_touching(*(*cube.octants)[octant], face, leaves);
+            }
+        }
+    } else if (this->slots.count(&cube) != 0 && this->hidden.count(&cube) == 0) {
+        leaves.push_back(&cube);
+    }
+}
+
+void IncrementalMesh::insert_slot(Cube &cube, const std::array<std::array<glm::vec3, 3>, 12> &polygons) {
+    this->slots.emplace(&cube, this->mesh.size());
+    this->mesh.insert(this->mesh.end(), polygons.begin(), polygons.end());
+    this->materials.push_back(this->face_materials(cube));
+}
+
+void IncrementalMesh::collect_slots(Cube &cube, std::vector<Cube *> &leaves) const {
+    if (cube.type() == CubeType::OCTANT) {
+        for (const auto &octant : *cube.octants) {
+            this->collect_slots(*octant, leaves);
+        }
+    } else if (this->slots.count(&cube) != 0) {
+        leaves.push_back(&cube);
+    }
+}
+
+void IncrementalMesh::collapse(Cube &cube) {
+    std::vector<Cube *> leaves;
+    this->collect_slots(cube, leaves);
+    if (leaves.empty()) {
+        this->collapsed[&cube] = {0, 0};
+        return;
+    }
+    for (Cube *leaf : leaves) {
+        const std::size_t first = this->slots.at(leaf);
+        std::fill_n(this->mesh.begin() + static_cast<std::ptrdiff_t>(first), SLOT_SIZE, std::array<glm::vec3, 3>{});
+        this->hidden[leaf] = &cube;
+        this->changed.push_back(first);
+    }
+    // The slots of the leaves of a subtree are contiguous, the first one holds the approximation.
+    const std::size_t first = this->slots.at(leaves.front());
+    const LodApproximation approximation = this->level_of_detail->approximate(cube);
+    if (approximation.type == CubeType::EMPTY) {
+        this->collapsed[&cube] = {first, 0};
+        return;
+    }
+    const auto polygons =
+        Cube::leaf_polygons(approximation.type, cube.size(), cube.position(), approximation.levels);
+    std::copy(polygons.begin(), polygons.end(), this->mesh.begin() + static_cast<std::ptrdiff_t>(first));
+    this->materials[first / SLOT_SIZE] = this->face_materials(cube);
+    this->collapsed[&cube] = {first, SLOT_SIZE};
+}
+
+void IncrementalMesh::reslot(Cube &cube) {
+    if (cube.type() == CubeType::OCTANT) {
+        if (this->level_of_detail->is_collapsed(&cube)) {
+            this->collapse(cube);
+            return;
+        }
+        this->collapsed.erase(&cube);
+        for (const auto &octant : *cube.octants) {
+            this->reslot(*octant);
+        }
+        return;
+    }
+    if (this->slots.count(&cube) == 0) {
+        return;
+    }
+    this->hidden.erase(&cube);
+    this->patch(cube);
+}
+
+void IncrementalMesh::rebuild() {
+    this->slots.clear();
+    this->nodes.clear();
+    this->mesh.clear();
+    this->materials.clear();
+    this->collapsed.clear();
+    this->hidden.clear();
+    this->mesh.reserve(this->root->leaves() * SLOT_SIZE);
+    this->insert(*this->root);
+    this->changed.clear();
+    this->rebuild_required = false;
+}
+
+bool IncrementalMesh::update_level_of_detail(const glm::vec3 &camera_position) {
+    if (!this->level_of_detail) {
+        return false;
+    }
+    // Structural changes have to be noticed first, the slots of the collapsed subtrees could be outdated otherwise.
+    this->journal->flush();
+    if (!this->level_of_detail->update(*this->root, camera_position)) {
+        return false;
+    }
+    if (this->rebuild_required) {
+        return true;
+    }
+    // Expanded subtrees are rewritten first, they may contain subtrees which are collapsed now.
+    std::vector<Cube *> expanded;
+    for (const auto &[cube, range] : this->collapsed) {
+        if (!this->level_of_detail->is_collapsed(cube)) {
+            expanded.push_back(cube);
+        }
+    }
+    for (Cube *cube : expanded) {
+        this->reslot(*cube);
+    }
+    std::vector<Cube *> selected = expanded;
+    for (const Cube *cube : this->level_of_detail->collapsed_subtrees()) {
+        // The selection consists of cubes of the octree of this mesh, which can be changed.
+        auto *subtree = const_cast<Cube *>(cube);
+        if (this->collapsed.count(subtree) == 0) {
+            this->collapse(*subtree);
+            selected.push_back(subtree);
+        }
+    }
+    // Faces next to the subtrees which have been collapsed or expanded are culled against different leaves now.
+    for (Cube *cube : selected) {
+        this->patch_neighbours(*cube);
+    }
+    return true;
+}
+
+IncrementalMesh::Update IncrementalMesh::update() {
+    this->journal->flush();
+    Update update;
+    if (!this->rebuild_required) {
+        // A leaf which has been split into octants or a replaced collapsed subtree changes the structure.
+        this->rebuild_required = std::any_of(this->dirty.begin(), this->dirty.end(),
+                                             [](Cube *cube) { return cube->type() == CubeType::OCTANT; });
+    }
+    if (this->rebuild_required) {
+        this->dirty.clear();
+        this->changed.clear();
+        this->rebuild();
+        update.rebuilt = true;
+        update.ranges.push_back({0, this->mesh.size()});
+        return update;
+    }
+
+    for (Cube *cube : this->dirty) {
+        if (const auto subtree = this->hidden.find(cube); subtree != this->hidden.end()) {
+            // The approximation of the collapsed subtree is regenerated instead, no face is culled against it.
+            this->collapse(*subtree->second);
+            continue;
+        }
+        this->patch(*cube);
+        this->patch_neighbours(*cube);
+    }
+    this->dirty.clear();
+
+    // Merge neighbouring slots, so that they can be uploaded at once.
+    std::vector<std::size_t> firsts;
+    firsts.swap(this->changed);
+    std::sort(firsts.begin(), firsts.end());
+    firsts.erase(std::unique(firsts.begin(), firsts.end()), firsts.end());
+    for (const std::size_t first : firsts) {
+        if (!update.ranges.empty() && update.ranges.back().first + update.ranges.back().count == first) {
+            update.ranges.back().count += SLOT_SIZE;
+        } else {
+            update.ranges.push_back({first, SLOT_SIZE});
+        }
+    }
+    return update;
+}
+
+const std::vector<std::array<glm::vec3, 3>> &IncrementalMesh::polygons() const {
+    return this->mesh;
+}
+
+IndexedMesh IncrementalMesh::indexed(const Range &range) const {
+    assert(range.first % SLOT_SIZE == 0 && range.count % SLOT_SIZE == 0);
+    assert(range.first + range.count <= this->mesh.size());
+    IndexedMesh indexed;
+    const std::size_t vertex_count = range.count / SLOT_SIZE * SLOT_VERTICES;
+    indexed.vertices.reserve(vertex_count);
+    indexed.normals.reserve(vertex_count);
+    indexed.materials.reserve(vertex_count);
+    indexed.indices.reserve(range.count * 3);
+    for (std::size_t first = range.first; first < range.first + range.count; first += SLOT_SIZE) {
+        const auto &slot_materials = this->materials[first / SLOT_SIZE];
+        for (std::size_t face = 0; face < Mesher::FACES; face++) {
+            const std::size_t face_vertices = indexed.vertices.size();
+            const auto base = static_cast<std::uint32_t>(first / SLOT_SIZE * SLOT_VERTICES + face * FACE_VERTICES);
+            const auto &first_polygon = this->mesh[first + 2 * face];
+            const auto &second_polygon = this->mesh[first + 2 * face + 1];
+            for (const auto *polygon : {&first_polygon, &second_polygon}) {
+                for (const auto &vertex : *polygon) {
+                    std::size_t corner = face_vertices;
+                    while (corner < indexed.vertices.size() && indexed.vertices[corner] != vertex) {
+                        corner++;
+                    }
+                    if (corner == indexed.vertices.size()) {
+                        // The polygons of a face use at most the 4 corners of its side.
+                        assert(corner - face_vertices < FACE_VERTICES);
+                        indexed.vertices.push_back(vertex);
+                    }
+                    indexed.indices.push_back(base + static_cast<std::uint32_t>(corner - face_vertices));
+                }
+            }
+            indexed.vertices.resize(face_vertices + FACE_VERTICES, indexed.vertices[face_vertices]);
+            indexed.normals.resize(face_vertices + FACE_VERTICES,
+                                   Mesher::face_normal(first_polygon, second_polygon, face));
+            indexed.materials.resize(face_vertices + FACE_VERTICES, slot_materials[face]);
+        }
+    }
+    return indexed;
+}
+
+std::vector<IncrementalMesh::Range> IncrementalMesh::visible(const Frustum &frustum) const {
+    std::vector<Range> ranges;
+    const auto append = [&ranges](const Range &range) {
+        if (!ranges.empty() && ranges.back().first + ranges.back().count == range.first) {
+            ranges.back().count += range.count;
+        } else {
+            ranges.push_back(range);
+        }
+    };
+    // The nodes before this index are within a node which is inside of the frustum.
+    std::size_t inside_end = 0;
+    std::size_t i = 0;
+    while (i < this->nodes.size()) {
+        const Node &node = this->nodes[i];
+        const auto intersection =
+            i < inside_end ? Frustum::Intersection::INSIDE : frustum.intersect(node.min, node.max);
+        if (intersection == Frustum::Intersection::OUTSIDE) {
+            i = node.end;
+            continue;
+        }
+        if (const auto subtree = this->collapsed.find(node.cube); subtree != this->collapsed.end()) {
+            // Only the slot with the approximation of a collapsed subtree is drawn.
+            if (subtree->second.count != 0) {
+                append(subtree->second);
+            }
+            i = node.end;
+            continue;
+        }
+        if (node.end == i + 1 || (intersection == Frustum::Intersection::INSIDE && this->collapsed.empty())) {
+            // A slot which can not be culled any further or a subtree which is drawn completely.
+            append(node.polygons);
+            i = node.end;
+            continue;
+        }
+        if (intersection == Frustum::Intersection::INSIDE) {
+            // The subtree may contain collapsed subtrees, whose degenerated slots are skipped.
+            inside_end = std::max(inside_end, node.end);
+        }
+        i++;
+    }
+    return ranges;
+}
+
+bool IncrementalMesh::is_dirty() const {
+    return this->rebuild_required || !this->dirty.empty() || !this->changed.empty() || !this->journal->empty();
+}
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,62 @@
+#include "inexor/vulkan-renderer/world/indexed_mesh.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <unordered_map>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// The bits of a position, used as key to find equal vertices.
+struct VertexKey {
+    std::array<std::uint32_t, 3> bits;
+
+    explicit VertexKey(const glm::vec3 &vertex) {
+        // Adding 0 turns -0 into +0, so that both are the same vertex.
+        const std::array<float, 3> position = {vertex.x + 0.0f, vertex.y + 0.0f, vertex.z + 0.0f};
+        std::memcpy(this->bits.data(), position.data(), sizeof(position));
+    }
+
+    bool operator==(const VertexKey &other) const {
+        return this->bits == other.bits;
+    }
+};
+
+struct VertexKeyHash {
+    std::size_t operator()(const VertexKey &key) const {
+        std::uint64_t hash = key.bits[0];
+        hash = hash * 0x9E3779B97F4A7C15 ^ key.bits[1];
+        hash = hash * 0x9E3779B97F4A7C15 ^ key.bits[2];
+        return static_cast<std::size_t>(hash ^ hash >> 32);
+    }
+};
+} // namespace
+
+IndexedMesh IndexedMesh::from_polygons(const std::vector<std::array<glm::vec3, 3>> &polygons) {
+    IndexedMesh mesh;
+    mesh.indices.reserve(polygons.size() * 3);
+    std::unordered_map<VertexKey, std::uint32_t, VertexKeyHash> vertex_indices;
+    vertex_indices.reserve(polygons.size());
+    for (const auto &polygon : polygons) {
+        for (const auto &vertex : polygon) {
+            const auto [entry, inserted] =
+                vertex_indices.emplace(VertexKey(vertex), static_cast<std::uint32_t>(mesh.vertices.size()));
+            if (inserted) {
+                mesh.vertices.push_back(vertex);
+            }
+            mesh.indices.push_back(entry->second);
+        }
+    }
+    return mesh;
+}
+
+bool IndexedMesh::has_16_bit_indices() const {
+    return std::all_of(this->indices.begin(), this->indices.end(),
+                       [](std::uint32_t index) { return index <= std::numeric_limits<std::uint16_t>::max(); });
+}
+
+std::vector<std::uint16_t> IndexedMesh::indices_16_bit() const {
+    assert(this->has_16_bit_indices());
+    return std::vector<std::uint16_t>(this->indices.begin(), this->indices.end());
+}
+} // namespace inexor::vulkan_renderer::world
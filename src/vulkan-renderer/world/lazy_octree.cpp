@@ -0,0 +1,242 @@
+#include "inexor/vulkan-renderer/world/lazy_octree.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace inexor::vulkan_renderer::world {
+LazyOctree::LazyOctree(const unsigned char *data, std::size_t byte_size, float size, const glm::vec3 &position)
+    : data(data), data_size(byte_size), root_size(size), root_position(position) {
+    BitStream stream(this->data, this->data_size);
+    const auto type = stream.get(2);
+    if (!type) {
+        throw std::runtime_error("Error: Octree data is too short for the type of the root!");
+    }
+    this->nodes.push_back({0, 0, static_cast<CubeType>(*type)});
+}
+
+LazyOctree::LazyOctree(const unsigned char *data, std::size_t byte_size, const SubtreeIndex &index, float size,
+                       const glm::vec3 &position)
+    : LazyOctree(data, byte_size, size, position) {
+    if (index.offsets().size() > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::runtime_error("Error: Too many offsets in subtree index!");
+    }
+    this->index_offsets = index.offsets();
+    this->index_ends.resize(this->index_offsets.size());
+    if (this->link_index(0, 0, index.depth()) != this->index_offsets.size()) {
+        throw std::runtime_error("Error: The subtree index has more offsets than the octree has nodes!");
+    }
+}
+
+std::optional<LazyOctree> LazyOctree::open(const std::string &file_name, float size, const glm::vec3 &position) {
+    tools::MappedFile file;
+    // An empty file is mapped successfully, but it does not even contain the type of the root.
+    if (!file.map_file(file_name) || file.get_file_size() == 0) {
+        return std::nullopt;
+    }
+    LazyOctree octree(file.get_file_data(), file.get_file_size(), size, position);
+    // The mapping does not move in memory when the MappedFile is moved.
+    octree.file = std::move(file);
+    return octree;
+}
+
+CubeType LazyOctree::type(std::uint32_t node) const {
+    return this->nodes.at(node).type;
+}
+
+bool LazyOctree::is_materialized(std::uint32_t node) const {
+    return this->nodes.at(node).children != 0;
+}
+
+std::uint32_t LazyOctree::children(std::uint32_t node) {
+    this->materialize(node);
+    return this->nodes[node].children;
+}
+
+void LazyOctree::materialize(std::uint32_t node) {
+    assert(this->nodes.at(node).type == CubeType::OCTANT);
+    if (this->nodes[node].children != 0) {
+        return;
+    }
+    if (this->nodes.size() + 8 > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::runtime_error("Error: Too many nodes in lazy octree!");
+    }
+
+    // The children of an indexed node above the depth of the index are the entries which follow it.
+    const std::size_t bit_offset = this->nodes[node].bit_offset;
+    const auto entry = std::lower_bound(this->index_offsets.begin(), this->index_offsets.end(), bit_offset);
+    if (entry != this->index_offsets.end() && *entry == bit_offset) {
+        auto child = static_cast<std::uint32_t>(entry - this->index_offsets.begin()) + 1;
+        if (child < this->index_ends[child - 1]) {
+            const auto first = static_cast<std::uint32_t>(this->nodes.size());
+            for (std::uint32_t i = 0; i < 8; i++) {
+                // The types of all entries have been read by link_index.
+                const auto type = BitStream(this->data, this->data_size, this->index_offsets[child]).peek(2);
+                this->nodes.push_back({this->index_offsets[child], 0, static_cast<CubeType>(*type)});
+                child = this->index_ends[child];
+            }
+            this->nodes[node].children = first;
+            return;
+        }
+    }
+
+    // The first child follows the type of its parent, every other child follows the subtree of its previous sibling.
+    const std::size_t stream_bits = this->data_size * 8;
+    BitStream stream(this->data, this->data_size, bit_offset + 2);
+    const auto first = static_cast<std::uint32_t>(this->nodes.size());
+    for (std::uint32_t i = 0; i < 8; i++) {
+        const std::size_t child_offset = stream_bits - stream.bits_left();
+        const auto type = stream.peek(2);
+        if (!type) {
+            throw std::runtime_error("Error: Octree data ended before all octants were read!");
+        }
+        this->nodes.push_back({child_offset, 0, static_cast<CubeType>(*type)});
+        if (i < 7 && !SubtreeIndex::skip(stream)) {
+            throw std::runtime_error("Error: Octree data ended before all octants were read!");
+        }
+    }
+    this->nodes[node].children = first;
+}
+
+std::uint32_t LazyOctree::link_index(std::uint32_t entry, std::uint32_t depth, std::uint32_t index_depth) {
+    if (entry >= this->index_offsets.size()) {
+        throw std::runtime_error("Error: The subtree index has less offsets than the octree has nodes!");
+    }
+    // The root starts the data and every other node follows the previous one, materialize searches the offsets.
+    const std::size_t offset = this->index_offsets[entry];
+    if (entry == 0 ? offset != 0 : offset <= this->index_offsets[entry - 1]) {
+        throw std::runtime_error("Error: The offsets of the subtree index are not in the order of the octree data!");
+    }
+    if (offset > this->data_size * 8) {
+        throw std::runtime_error("Error: An offset of the subtree index lies behind the end of the octree data!");
+    }
+    const auto type = BitStream(this->data, this->data_size, offset).peek(2);
+    if (!type) {
+        throw std::runtime_error("Error: Octree data ended before the type of a cube was read!");
+    }
+    std::uint32_t end = entry + 1;
+    if (static_cast<CubeType>(*type) == CubeType::OCTANT && depth < index_depth) {
+        for (std::uint32_t i = 0; i < 8; i++) {
+            end = this->link_index(end, depth + 1, index_depth);
+        }
+    }
+    this->index_ends[entry] = end;
+    return end;
+}
+
+std::array<glm::tvec3<std::uint8_t>, 8> LazyOctree::indentation_levels(std::uint32_t node) const {
+    assert(this->nodes.at(node).type == CubeType::INDENTED);
+    BitStream stream(this->data, this->data_size, this->nodes[node].bit_offset + 2);
+    const auto levels = stream.get_indentations();
+    if (!levels) {
+        throw std::runtime_error("Error: Octree data ended before the indentations were read!");
+    }
+    return *levels;
+}
+
+std::optional<std::uint32_t> LazyOctree::find(const glm::vec3 &point) {
+    const glm::vec3 &p = this->root_position;
+    float size = this->root_size;
+    if (point.x < p.x || point.y < p.y || point.z < p.z || point.x > p.x + size || point.y > p.y + size ||
+        point.z > p.z + size) {
+        return std::nullopt;
+    }
+
+    std::uint32_t node = LazyOctree::root();
+    glm::vec3 position = this->root_position;
+    while (this->nodes[node].type == CubeType::OCTANT) {
+        size /= 2;
+        // Bit 2 selects the x-axis half, bit 1 the y-axis half and bit 0 the z-axis half (see Cube::octants).
+        std::uint32_t octant = 0;
+        if (point.x >= position.x + size) {
+            octant |= 4;
+            position.x += size;
+        }
+        if (point.y >= position.y + size) {
+            octant |= 2;
+            position.y += size;
+        }
+        if (point.z >= position.z + size) {
+            octant |= 1;
+            position.z += size;
+        }
+        node = this->children(node) + octant;
+    }
+    return node;
+}
+
+std::uint64_t LazyOctree::leaves() {
+    std::uint64_t leaves = 0;
+    std::vector<std::uint32_t> stack = {LazyOctree::root()};
+    while (!stack.empty()) {
+        const std::uint32_t node = stack.back();
+        stack.pop_back();
+        switch (this->nodes[node].type) {
+        case CubeType::EMPTY:
+            break;
+        case CubeType::FULL:
+        case CubeType::INDENTED:
+            leaves++;
+            break;
+        case CubeType::OCTANT:
+            const std::uint32_t first = this->children(node);
+            for (std::uint32_t child = first; child < first + 8; child++) {
+                stack.push_back(child);
+            }
+            break;
+        }
+    }
+    return leaves;
+}
+
+std::vector<std::array<glm::vec3, 3>> LazyOctree::polygons() {
+    const glm::vec3 max = {this->root_position.x + this->root_size, this->root_position.y + this->root_size,
+                           this->root_position.z + this->root_size};
+    return this->polygons(this->root_position, max);
+}
+
+std::vector<std::array<glm::vec3, 3>> LazyOctree::polygons(const glm::vec3 &min, const glm::vec3 &max) {
+    std::vector<std::array<glm::vec3, 3>> polygons;
+    this->collect_polygons(LazyOctree::root(), this->root_size, this->root_position, min, max, polygons);
+    return polygons;
+}
+
+void LazyOctree::collect_polygons(std::uint32_t node, float size, const glm::vec3 &position, const glm::vec3 &min,
+                                  const glm::vec3 &max, std::vector<std::array<glm::vec3, 3>> &polygons) {
+    if (position.x > max.x || position.y > max.y || position.z > max.z || position.x + size < min.x ||
+        position.y + size < min.y || position.z + size < min.z) {
+        return;
+    }
+    const CubeType type = this->nodes[node].type;
+    if (type == CubeType::EMPTY) {
+        return;
+    }
+    if (type == CubeType::OCTANT) {
+        const std::uint32_t first = this->children(node);
+        const float half = size / 2;
+        for (std::uint32_t i = 0; i < 8; i++) {
+            const glm::vec3 octant_position = {position.x + ((i & 4) ? half : 0.0f),
+                                               position.y + ((i & 2) ? half : 0.0f),
+                                               position.z + ((i & 1) ? half : 0.0f)};
+            this->collect_polygons(first + i, half, octant_position, min, max, polygons);
+        }
+        return;
+    }
+
+    const auto cube_polygons = type == CubeType::FULL
+                                   ? Cube::leaf_polygons(type, size, position, {})
+                                   : Cube::leaf_polygons(type, size, position, this->indentation_levels(node));
+    polygons.insert(polygons.end(), cube_polygons.begin(), cube_polygons.end());
+}
+
+std::size_t LazyOctree::node_count() const {
+    return this->nodes.size();
+}
+
+std::size_t LazyOctree::memory_usage() const {
+    return sizeof(LazyOctree) + this->nodes.capacity() * sizeof(Node) +
+           this->index_offsets.capacity() * sizeof(std::size_t) + this->index_ends.capacity() * sizeof(std::uint32_t);
+}
+} // namespace inexor::vulkan_renderer::world
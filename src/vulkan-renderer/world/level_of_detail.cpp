@@ -0,0 +1,144 @@
+#include "inexor/vulkan-renderer/world/level_of_detail.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// Get the distance of a point to the bounds of a cube, 0 if the point is within the cube.
+float distance(Cube &cube, const glm::vec3 &point) {
+    const glm::vec3 min = cube.position();
+    const float size = cube.size();
+    const float x = std::max({min.x - point.x, 0.0f, point.x - (min.x + size)});
+    const float y = std::max({min.y - point.y, 0.0f, point.y - (min.y + size)});
+    const float z = std::max({min.z - point.z, 0.0f, point.z - (min.z + size)});
+    return std::sqrt(x * x + y * y + z * z);
+}
+
+/// Get the indentation levels of a leaf.
+std::array<glm::tvec3<std::uint8_t>, 8> leaf_levels(Cube &leaf) {
+    std::array<glm::tvec3<std::uint8_t>, 8> levels{};
+    if (leaf.type() == CubeType::INDENTED) {
+        for (std::size_t i = 0; i < levels.size(); i++) {
+            levels[i] = (*leaf.indentations)[i].vec();
+        }
+    }
+    return levels;
+}
+} // namespace
+
+LevelOfDetail::LevelOfDetail(const LodOptions &options) : options(options) {}
+
+bool LevelOfDetail::update(Cube &root, const glm::vec3 &camera_position) {
+    std::unordered_set<const Cube *> selection;
+    this->select(root, camera_position, selection);
+    if (selection == this->collapsed) {
+        return false;
+    }
+    this->collapsed = std::move(selection);
+    return true;
+}
+
+void LevelOfDetail::select(Cube &cube, const glm::vec3 &camera_position,
+                           std::unordered_set<const Cube *> &selection) const {
+    if (cube.type() != CubeType::OCTANT) {
+        return;
+    }
+    // Collapsed subtrees have to come closer and detailed subtrees have to get further away to switch.
+    const float switch_distance = cube.size() * this->options.detail_factor;
+    const float margin = this->is_collapsed(&cube) ? -this->options.hysteresis : this->options.hysteresis;
+    if (distance(cube, camera_position) > switch_distance * (1.0f + margin)) {
+        selection.insert(&cube);
+        return;
+    }
+    for (const auto &octant : *cube.octants) {
+        this->select(*octant, camera_position, selection);
+    }
+}
+
+bool LevelOfDetail::is_collapsed(const Cube *cube) const {
+    return this->collapsed.count(cube) != 0;
+}
+
+const std::unordered_set<const Cube *> &LevelOfDetail::collapsed_subtrees() const {
+    return this->collapsed;
+}
+
+std::size_t LevelOfDetail::collapsed_count() const {
+    return this->collapsed.size();
+}
+
+std::vector<std::array<glm::vec3, 3>> LevelOfDetail::polygons(Cube &root) const {
+    std::vector<std::array<glm::vec3, 3>> polygons;
+    this->insert(root, polygons);
+    return polygons;
+}
+
+void LevelOfDetail::insert(Cube &cube, std::vector<std::array<glm::vec3, 3>> &polygons) const {
+    if (cube.type() == CubeType::OCTANT && !this->is_collapsed(&cube)) {
+        for (const auto &octant : *cube.octants) {
+            this->insert(*octant, polygons);
+        }
+        return;
+    }
+    const LodApproximation approximation = this->approximate(cube);
+    if (approximation.type == CubeType::EMPTY) {
+        return;
+    }
+    const auto cube_polygons =
+        Cube::leaf_polygons(approximation.type, cube.size(), cube.position(), approximation.levels);
+    polygons.insert(polygons.end(), cube_polygons.begin(), cube_polygons.end());
+}
+
+LodApproximation LevelOfDetail::approximate(Cube &cube) const {
+    const CubeType type = cube.type();
+    if (type != CubeType::OCTANT) {
+        return {type, leaf_levels(cube)};
+    }
+
+    std::array<float, 8> fractions{};
+    float total = 0.0f;
+    for (std::size_t i = 0; i < fractions.size(); i++) {
+        fractions[i] = LevelOfDetail::solid_fraction(*(*cube.octants)[i]);
+        total += fractions[i] / 8.0f;
+    }
+    if (total < this->options.solid_threshold) {
+        return {};
+    }
+
+    // Each corner is moved towards the center of the cube by the empty fraction of the octant at that corner.
+    LodApproximation approximation{CubeType::FULL, {}};
+    for (std::size_t i = 0; i < fractions.size(); i++) {
+        const auto level = static_cast<std::uint8_t>(std::lround((1.0f - fractions[i]) * MAX_INDENTATION / 2));
+        approximation.levels[i] = {level, level, level};
+        if (level != 0) {
+            approximation.type = CubeType::INDENTED;
+        }
+    }
+    return approximation;
+}
+
+float LevelOfDetail::solid_fraction(Cube &cube) {
+    switch (cube.type()) {
+    case CubeType::EMPTY:
+        return 0.0f;
+    case CubeType::FULL:
+        return 1.0f;
+    case CubeType::INDENTED: {
+        float indentation = 0.0f;
+        for (const auto &corner : *cube.indentations) {
+            indentation += static_cast<float>(corner.x() + corner.y() + corner.z());
+        }
+        return 1.0f - indentation / (8.0f * 3.0f * MAX_INDENTATION);
+    }
+    case CubeType::OCTANT:
+        float fraction = 0.0f;
+        for (const auto &octant : *cube.octants) {
+            fraction += LevelOfDetail::solid_fraction(*octant) / 8.0f;
+        }
+        return fraction;
+    }
+    return 0.0f;
+}
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,193 @@
+#include "inexor/vulkan-renderer/world/linear_octree.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// Spread the lower 21 bits of a value, so that there are two zero bits between every two bits.
+std::uint64_t spread(std::uint32_t value) {
+    std::uint64_t bits = value & 0x1FFFFFu;
+    bits = (bits | bits << 32) & 0x1F00000000FFFFu;
+    bits = (bits | bits << 16) & 0x1F0000FF0000FFu;
+    bits = (bits | bits << 8) & 0x100F00F00F00F00Fu;
+    bits = (bits | bits << 4) & 0x10C30C30C30C30C3u;
+    bits = (bits | bits << 2) & 0x1249249249249249u;
+    return bits;
+}
+
+/// Compact every third bit of a value (the inverse of spread).
+std::uint32_t compact(std::uint64_t bits) {
+    bits &= 0x1249249249249249u;
+    bits = (bits ^ (bits >> 2)) & 0x10C30C30C30C30C3u;
+    bits = (bits ^ (bits >> 4)) & 0x100F00F00F00F00Fu;
+    bits = (bits ^ (bits >> 8)) & 0x1F0000FF0000FFu;
+    bits = (bits ^ (bits >> 16)) & 0x1F00000000FFFFu;
+    bits = (bits ^ (bits >> 32)) & 0x1FFFFFu;
+    return static_cast<std::uint32_t>(bits);
+}
+} // namespace
+
+LinearOctree::LinearOctree(std::shared_ptr<Cube> root) : root(std::move(root)) {
+    assert(this->root);
+    this->insert(*this->root, 1);
+    this->root->make_reactive();
+    this->journal = this->root->journal();
+    this->subscription = this->journal->subscribe([this](const std::vector<Cube *> &cubes) { this->change(cubes); });
+}
+
+LinearOctree::~LinearOctree() {
+    this->journal->unsubscribe(this->subscription);
+}
+
+void LinearOctree::change(const std::vector<Cube *> &cubes) {
+    for (Cube *cube : cubes) {
+        // A cube which has been removed from the octree since (e.g. together with its parent) is not indexed anymore.
+        const auto key = this->keys.find(cube);
+        if (key == this->keys.end()) {
+            continue;
+        }
+        // The octants may have been replaced, the whole subtree is indexed again.
+        const Key changed = key->second;
+        this->remove(changed);
+        this->insert(*cube, changed);
+    }
+}
+
+void LinearOctree::insert(Cube &cube, Key key) {
+    const std::uint32_t cube_depth = LinearOctree::depth(key);
+    if (cube_depth > MAX_DEPTH) {
+        throw std::runtime_error("Error: The octree is too deep for a linear octree!");
+    }
+    this->max_depth = std::max(this->max_depth, cube_depth);
+    const CubeType type = cube.type();
+    this->nodes[key] = {&cube, type};
+    this->keys[&cube] = key;
+    if (type == CubeType::OCTANT) {
+        for (std::size_t i = 0; i < 8; i++) {
+            this->insert(*(*cube.octants)[i], LinearOctree::child(key, i));
+        }
+    }
+}
+
+void LinearOctree::remove(Key key) {
+    const auto node = this->nodes.find(key);
+    if (node == this->nodes.end()) {
+        return;
+    }
+    if (node->second.type == CubeType::OCTANT) {
+        for (std::size_t i = 0; i < 8; i++) {
+            this->remove(LinearOctree::child(key, i));
+        }
+    }
+    this->keys.erase(node->second.cube);
+    this->nodes.erase(node);
+}
+
+LinearOctree::Key LinearOctree::child(Key key, std::size_t octant) {
+    assert(octant < 8);
+    return key << 3 | octant;
+}
+
+LinearOctree::Key LinearOctree::parent(Key key) {
+    assert(key > 1);
+    return key >> 3;
+}
+
+std::uint32_t LinearOctree::depth(Key key) {
+    assert(key != 0);
+    std::uint32_t depth = 0;
+    while (key > 7) {
+        key >>= 3;
+        depth++;
+    }
+    return depth;
+}
+
+LinearOctree::Key LinearOctree::encode(std::uint32_t depth, const std::array<std::uint32_t, 3> &coordinates) {
+    assert(depth <= MAX_DEPTH);
+    return Key{1} << (3 * depth) | spread(coordinates[0]) << 2 | spread(coordinates[1]) << 1 | spread(coordinates[2]);
+}
+
+std::array<std::uint32_t, 3> LinearOctree::decode(Key key) {
+    const Key path = key ^ (Key{1} << (3 * LinearOctree::depth(key)));
+    return {compact(path >> 2), compact(path >> 1), compact(path)};
+}
+
+LinearOctree::Key LinearOctree::deepest(Key key) const {
+    // A cube is indexed if and only if all cubes on its path are, so the depth of the leaf can be searched binary.
+    const std::uint32_t key_depth = LinearOctree::depth(key);
+    std::uint32_t low = 0;
+    std::uint32_t high = key_depth;
+    while (low < high) {
+        const std::uint32_t middle = (low + high + 1) / 2;
+        if (this->nodes.count(key >> (3 * (key_depth - middle))) != 0) {
+            low = middle;
+        } else {
+            high = middle - 1;
+        }
+    }
+    return key >> (3 * (key_depth - low));
+}
+
+Cube *LinearOctree::find(Key key) const {
+    const auto node = this->nodes.find(key);
+    return node == this->nodes.end() ? nullptr : node->second.cube;
+}
+
+std::optional<LinearOctree::Key> LinearOctree::key(const Cube *cube) const {
+    const auto key = this->keys.find(cube);
+    if (key == this->keys.end()) {
+        return std::nullopt;
+    }
+    return key->second;
+}
+
+std::optional<LinearOctree::Key> LinearOctree::locate(const glm::vec3 &point) const {
+    const glm::vec3 position = this->root->position();
+    const float size = this->root->size();
+    const glm::vec3 relative = (point - position) / size;
+    if (relative.x < 0.0f || relative.y < 0.0f || relative.z < 0.0f || relative.x > 1.0f || relative.y > 1.0f ||
+        relative.z > 1.0f) {
+        return std::nullopt;
+    }
+
+    // Points on the upper bounds of the octree belong to the last cell.
+    const std::uint32_t cells = 1u << this->max_depth;
+    const auto cell = [cells](float value) {
+        return std::min(static_cast<std::uint32_t>(value * static_cast<float>(cells)), cells - 1);
+    };
+    return this->deepest(LinearOctree::encode(this->max_depth, {cell(relative.x), cell(relative.y), cell(relative.z)}));
+}
+
+Cube *LinearOctree::find(const glm::vec3 &point) const {
+    const auto key = this->locate(point);
+    return key ? this->find(*key) : nullptr;
+}
+
+std::optional<LinearOctree::Key> LinearOctree::neighbour(Key key, std::size_t face) const {
+    assert(face < 6);
+    const std::uint32_t key_depth = LinearOctree::depth(key);
+    std::array<std::uint32_t, 3> coordinates = LinearOctree::decode(key);
+    std::uint32_t &coordinate = coordinates[face / 2];
+    if (face % 2 == 0) {
+        if (coordinate == 0) {
+            return std::nullopt;
+        }
+        coordinate--;
+    } else {
+        if (coordinate + 1 == 1u << key_depth) {
+            return std::nullopt;
+        }
+        coordinate++;
+    }
+    return this->deepest(LinearOctree::encode(key_depth, coordinates));
+}
+
+std::size_t LinearOctree::size() const {
+    return this->nodes.size();
+}
+} // namespace inexor::vulkan_renderer::world
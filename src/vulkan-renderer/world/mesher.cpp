@@ -0,0 +1,279 @@
+#include "inexor/vulkan-renderer/world/mesher.hpp"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <unordered_map>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// Get the axis of a face (0 = x, 1 = y, 2 = z).
+constexpr std::size_t axis(std::size_t face) {
+    return face / 2;
+}
+
+/// Get the bit which selects the higher half of the axis of a face in the index of a corner or octant.
+constexpr std::size_t axis_bit(std::size_t face) {
+    return 4u >> axis(face);
+}
+
+/// Get whether a face is on the higher side of its axis.
+constexpr bool is_high(std::size_t face) {
+    return face % 2 == 1;
+}
+
+/// Get whether a corner or octant touches a face.
+constexpr bool touches(std::size_t corner, std::size_t face) {
+    return ((corner & axis_bit(face)) != 0) == is_high(face);
+}
+
+/// Append the two polygons of a face.
+void append_face(std::vector<std::array<glm::vec3, 3>> &polygons, const std::array<glm::vec3, 3> &first,
+                 const std::array<glm::vec3, 3> &second, std::size_t /*face*/, std::uint16_t /*material*/) {
+    polygons.push_back(first);
+    polygons.push_back(second);
+}
+
+/// Append the two polygons of a face with the attributes of the face.
+void append_face(std::vector<std::array<MeshVertex, 3>> &polygons, const std::array<glm::vec3, 3> &first,
+                 const std::array<glm::vec3, 3> &second, std::size_t face, std::uint16_t material) {
+    const glm::vec3 normal = Mesher::face_normal(first, second, face);
+    for (const auto *polygon : {&first, &second}) {
+        std::array<MeshVertex, 3> vertices;
+        for (std::size_t i = 0; i < vertices.size(); i++) {
+            const glm::vec3 &position = (*polygon)[i];
+            vertices[i] = {position, normal, Mesher::texture_coordinate(position, normal), material};
+        }
+        polygons.push_back(vertices);
+    }
+}
+} // namespace
+
+Mesher::Mesher(const MeshOptions &options) : options(options) {}
+
+template <typename Polygon>
+void Mesher::mesh(Cube &cube, std::vector<Polygon> &polygons) {
+    this->mesh_statistics = {};
+    this->origin = cube.position();
+    polygons.reserve(cube.leaves() * 12);
+    this->insert(cube, {}, polygons);
+    if (this->options.merge_faces) {
+        this->merge(polygons);
+    }
+}
+
+std::vector<std::array<glm::vec3, 3>> Mesher::polygons(Cube &cube) {
+    std::vector<std::array<glm::vec3, 3>> polygons;
+    this->mesh(cube, polygons);
+    return polygons;
+}
+
+std::vector<std::array<MeshVertex, 3>> Mesher::vertices(Cube &cube) {
+    std::vector<std::array<MeshVertex, 3>> polygons;
+    this->mesh(cube, polygons);
+    return polygons;
+}
+
+glm::vec3 Mesher::face_normal(const std::array<glm::vec3, 3> &first, const std::array<glm::vec3, 3> &second,
+                              std::size_t face) {
+    // The polygons are wound clockwise seen from the outside, the sum of both is weighted by their area.
+    const glm::vec3 normal = glm::cross(first[2] - first[0], first[1] - first[0]) +
+                             glm::cross(second[2] - second[0], second[1] - second[0]);
+    const float length = glm::length(normal);
+    if (length > 0.0f) {
+        return normal / length;
+    }
+    glm::vec3 axis_normal(0.0f);
+    axis_normal[static_cast<int>(axis(face))] = is_high(face) ? 1.0f : -1.0f;
+    return axis_normal;
+}
+
+glm::vec2 Mesher::texture_coordinate(const glm::vec3 &position, const glm::vec3 &normal) {
+    const glm::vec3 main_axis = glm::abs(normal);
+    if (main_axis.x >= main_axis.y && main_axis.x >= main_axis.z) {
+        return {position.z, position.y};
+    }
+    if (main_axis.y >= main_axis.z) {
+        return {position.x, position.z};
+    }
+    return {position.x, position.y};
+}
+
+const MeshStatistics &Mesher::statistics() const {
+    return this->mesh_statistics;
+}
+
+template <typename Polygon>
+void Mesher::insert(Cube &cube, const std::array<Cube *, 6> &neighbours, std::vector<Polygon> &polygons) {
+    const CubeType type = cube.type();
+    if (type == CubeType::EMPTY) {
+        return;
+    }
+    if (type == CubeType::OCTANT) {
+        for (std::size_t i = 0; i < 8; i++) {
+            std::array<Cube *, 6> octant_neighbours{};
+            for (std::size_t face = 0; face < FACES; face++) {
+                const std::size_t mirrored = i ^ axis_bit(face);
+                if (!touches(i, face)) {
+                    // The neighbour is a sibling.
+                    octant_neighbours[face] = (*cube.octants)[mirrored].get();
+                } else if (neighbours[face] != nullptr && neighbours[face]->type() == CubeType::OCTANT) {
+                    octant_neighbours[face] = (*neighbours[face]->octants)[mirrored].get();
+                } else {
+                    // A larger leaf, empty cube or the outside of the octree.
+                    octant_neighbours[face] = neighbours[face];
+                }
+            }
+            this->insert(*(*cube.octants)[i], octant_neighbours, polygons);
+        }
+        return;
+    }
+
+    this->mesh_statistics.leaves++;
+    std::array<glm::tvec3<std::uint8_t>, 8> levels{};
+    if (type == CubeType::INDENTED) {
+        for (std::size_t i = 0; i < levels.size(); i++) {
+            levels[i] = (*cube.indentations)[i].vec();
+        }
+    }
+    const auto cube_polygons = Cube::leaf_polygons(type, cube.size(), cube.position(), levels);
+    for (std::size_t face = 0; face < FACES; face++) {
+        // The neighbouring cube touches this face with its opposite face.
+        if (this->options.cull_hidden_faces && Mesher::is_on_side(cube, face) &&
+            Mesher::is_covered(neighbours[face], face ^ 1)) {
+            this->mesh_statistics.hidden_triangles += 2;
+            continue;
+        }
+        const std::uint16_t material = this->options.material ? this->options.material(cube, face) : 0;
+        if (this->options.merge_faces && Mesher::is_covered(&cube, face)) {
+            const std::size_t u = (axis(face) + 1) % 3;
+            const std::size_t v = (axis(face) + 2) % 3;
+            const glm::vec3 position = cube.position() - this->origin;
+            const float size = cube.size();
+            const float plane = cube.position()[static_cast<int>(axis(face))] + (is_high(face) ? size : 0.0f);
+            this->mergeable_faces[{face, plane, size, material}].emplace_back(
+                static_cast<std::int32_t>(std::lround(position[static_cast<int>(u)] / size)),
+                static_cast<std::int32_t>(std::lround(position[static_cast<int>(v)] / size)));
+            continue;
+        }
+        append_face(polygons, cube_polygons[2 * face], cube_polygons[2 * face + 1], face, material);
+        this->mesh_statistics.triangles += 2;
+    }
+}
+
+template <typename Polygon>
+void Mesher::merge(std::vector<Polygon> &polygons) {
+    for (auto &[group, cells] : this->mergeable_faces) {
+        const auto [face, plane, size, material] = group;
+        // Whether a cell of the grid has been merged already, by its coordinates on the grid.
+        std::unordered_map<std::uint64_t, bool> merged;
+        const auto key = [](std::int32_t u, std::int32_t v) {
+            return static_cast<std::uint64_t>(static_cast<std::uint32_t>(u)) << 32 | static_cast<std::uint32_t>(v);
+        };
+        const auto is_free = [&](std::int32_t u, std::int32_t v) {
+            const auto cell = merged.find(key(u, v));
+            return cell != merged.end() && !cell->second;
+        };
+        for (const auto &[u, v] : cells) {
+            merged.emplace(key(u, v), false);
+        }
+
+        // Visit the cells row by row.
+        std::sort(cells.begin(), cells.end(), [](const auto &lhs, const auto &rhs) {
+            return std::tie(lhs.second, lhs.first) < std::tie(rhs.second, rhs.first);
+        });
+        for (const auto &[u, v] : cells) {
+            if (!is_free(u, v)) {
+                continue;
+            }
+            std::int32_t width = 1;
+            while (is_free(u + width, v)) {
+                width++;
+            }
+            std::int32_t height = 1;
+            while (true) {
+                bool row_free = true;
+                for (std::int32_t i = 0; i < width && row_free; i++) {
+                    row_free = is_free(u + i, v + height);
+                }
+                if (!row_free) {
+                    break;
+                }
+                height++;
+            }
+            for (std::int32_t j = 0; j < height; j++) {
+                for (std::int32_t i = 0; i < width; i++) {
+                    merged[key(u + i, v + j)] = true;
+                }
+            }
+
+            // Build a flat box in the plane, its polygons keep the winding order of the face.
+            const auto a = static_cast<int>(axis(face));
+            const int axis_u = (a + 1) % 3;
+            const int axis_v = (a + 2) % 3;
+            glm::vec3 min;
+            glm::vec3 max;
+            min[a] = plane;
+            max[a] = plane;
+            min[axis_u] = this->origin[axis_u] + static_cast<float>(u) * size;
+            max[axis_u] = this->origin[axis_u] + static_cast<float>(u + width) * size;
+            min[axis_v] = this->origin[axis_v] + static_cast<float>(v) * size;
+            max[axis_v] = this->origin[axis_v] + static_cast<float>(v + height) * size;
+            std::array<glm::vec3, 8> corners;
+            for (std::size_t i = 0; i < corners.size(); i++) {
+                corners[i] = {(i & 4) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 1) ? max.z : min.z};
+            }
+            const auto box_polygons = Cube::full_polygons(corners);
+            append_face(polygons, box_polygons[2 * face], box_polygons[2 * face + 1], face, material);
+            this->mesh_statistics.triangles += 2;
+            this->mesh_statistics.merged_triangles += static_cast<std::uint64_t>(width) * height * 2 - 2;
+        }
+    }
+    this->mergeable_faces.clear();
+}
+
+bool Mesher::is_on_side(Cube &leaf, std::size_t face) {
+    if (leaf.type() == CubeType::FULL) {
+        return true;
+    }
+    assert(leaf.type() == CubeType::INDENTED);
+    const auto &indentations = *leaf.indentations;
+    for (std::size_t corner = 0; corner < 8; corner++) {
+        if (touches(corner, face) && indentations[corner].vec()[static_cast<int>(axis(face))] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Mesher::is_covered(Cube *cube, std::size_t face) {
+    if (cube == nullptr) {
+        return false;
+    }
+    switch (cube->type()) {
+    case CubeType::EMPTY:
+        return false;
+    case CubeType::FULL:
+        return true;
+    case CubeType::INDENTED:
+        // The side is only a complete square if none of its corners is indented.
+        for (std::size_t corner = 0; corner < 8; corner++) {
+            if (touches(corner, face) && (*cube->indentations)[corner].vec() != glm::tvec3<std::uint8_t>(0)) {
+                return false;
+            }
+        }
+        return true;
+    case CubeType::OCTANT:
+        for (std::size_t octant = 0; octant < 8; octant++) {
+            if (touches(octant, face) && !Mesher::is_covered((*cube->octants)[octant].get(), face)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    assert(false); // This point should never be reached, as we handled all types already.
+    return false;
+}
+} // namespace inexor::vulkan_renderer::world
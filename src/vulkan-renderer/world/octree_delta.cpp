@@ -0,0 +1,234 @@
+#include "inexor/vulkan-renderer/world/octree_delta.hpp"
+
+#include "inexor/vulkan-renderer/world/bit_stream.hpp"
+#include "inexor/vulkan-renderer/world/bit_stream_writer.hpp"
+#include "inexor/vulkan-renderer/world/change_journal.hpp"
+
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// Number of bits of the number of deltas.
+constexpr std::uint8_t COUNT_BITS = 32;
+
+/// Number of bits of the depth of a path.
+constexpr std::uint8_t DEPTH_BITS = 5;
+
+/// Number of bits of an octant on a path.
+constexpr std::uint8_t OCTANT_BITS = 3;
+
+/// Get the indentation levels of an indented cube.
+/// @param cube The indented cube.
+/// @return The indentation levels of each corner.
+std::array<glm::tvec3<std::uint8_t>, 8> indentation_levels(const Cube &cube) {
+    std::array<glm::tvec3<std::uint8_t>, 8> levels;
+    for (std::size_t i = 0; i < 8; i++) {
+        levels[i] = cube.indentations.value()[i].vec();
+    }
+    return levels;
+}
+
+/// Get whether two leaves are the same.
+/// @param first The first cube.
+/// @param second The second cube.
+/// @return Whether both cubes are leaves of the same type with the same indentations.
+bool equal_leaves(Cube &first, Cube &second) {
+    if (first.type() != second.type() || first.type() == CubeType::OCTANT) {
+        return false;
+    }
+    return first.type() != CubeType::INDENTED || indentation_levels(first) == indentation_levels(second);
+}
+
+/// Append the deltas which create a subtree.
+/// @param cube The root of the subtree.
+/// @param path The path to the subtree, restored afterwards.
+/// @param deltas The deltas to append to.
+void record(Cube &cube, std::vector<std::size_t> &path, std::vector<OctreeDelta> &deltas) {
+    OctreeDelta &delta = deltas.emplace_back();
+    delta.path = path;
+    delta.type = cube.type();
+    if (delta.type == CubeType::INDENTED) {
+        delta.levels = indentation_levels(cube);
+    }
+    if (delta.type != CubeType::OCTANT) {
+        return;
+    }
+    // The octants are created with the more common leaf type, so that only the other octants need deltas.
+    const auto full = std::count_if(cube.octants->begin(), cube.octants->end(),
+                                    [](const auto &octant) { return octant->type() == CubeType::FULL; });
+    const auto empty = std::count_if(cube.octants->begin(), cube.octants->end(),
+                                     [](const auto &octant) { return octant->type() == CubeType::EMPTY; });
+    const CubeType octant_type = full > empty ? CubeType::FULL : CubeType::EMPTY;
+    delta.octant_type = octant_type;
+    for (std::size_t i = 0; i < 8; i++) {
+        Cube &octant = *(*cube.octants)[i];
+        if (octant.type() != octant_type) {
+            path.push_back(i);
+            record(octant, path, deltas);
+            path.pop_back();
+        }
+    }
+}
+
+/// Append the deltas which change a subtree into another one.
+/// @param before The subtree before the changes.
+/// @param after The subtree after the changes.
+/// @param path The path to the subtree, restored afterwards.
+/// @param deltas The deltas to append to.
+void diff(const std::shared_ptr<Cube> &before, const std::shared_ptr<Cube> &after, std::vector<std::size_t> &path,
+          std::vector<OctreeDelta> &deltas) {
+    if (before == after || equal_leaves(*before, *after)) {
+        return;
+    }
+    if (before->type() == CubeType::OCTANT && after->type() == CubeType::OCTANT) {
+        for (std::size_t i = 0; i < 8; i++) {
+            path.push_back(i);
+            diff((*before->octants)[i], (*after->octants)[i], path, deltas);
+            path.pop_back();
+        }
+        return;
+    }
+    record(*after, path, deltas);
+}
+} // namespace
+
+Cube OctreeDelta::cube(float size, const glm::vec3 &position) const {
+    if (this->type == CubeType::INDENTED) {
+        std::array<Indentation, 8> indentations;
+        for (std::size_t i = 0; i < 8; i++) {
+            indentations[i] = Indentation(this->levels[i].x, this->levels[i].y, this->levels[i].z);
+        }
+        return Cube(indentations, size, position);
+    }
+    if (this->type == CubeType::OCTANT) {
+        const float half = size / 2;
+        std::array<std::shared_ptr<Cube>, 8> octants;
+        for (std::size_t i = 0; i < 8; i++) {
+            const glm::vec3 octant_position = {position.x + ((i & 4) ? half : 0.0f),
+                                               position.y + ((i & 2) ? half : 0.0f),
+                                               position.z + ((i & 1) ? half : 0.0f)};
+            octants[i] = std::make_shared<Cube>(this->octant_type, half, octant_position);
+        }
+        return Cube(octants, size, position);
+    }
+    return Cube(this->type, size, position);
+}
+
+std::vector<unsigned char> encode_deltas(const std::vector<OctreeDelta> &deltas) {
+    BitStreamWriter writer;
+    writer.put(deltas.size(), COUNT_BITS);
+    for (const auto &delta : deltas) {
+        if (delta.path.size() > MAX_DELTA_DEPTH) {
+            throw std::runtime_error("Error: The path of the delta is too deep!");
+        }
+        writer.put(delta.path.size(), DEPTH_BITS);
+        for (const std::size_t octant : delta.path) {
+            if (octant >= 8) {
+                throw std::runtime_error("Error: The path of the delta contains an invalid octant!");
+            }
+            writer.put(octant, OCTANT_BITS);
+        }
+        writer.put(static_cast<std::uint64_t>(delta.type), 2);
+        if (delta.type == CubeType::INDENTED) {
+            writer.put_indentations(delta.levels);
+        } else if (delta.type == CubeType::OCTANT) {
+            writer.put(delta.octant_type == CubeType::FULL ? 1 : 0, 1);
+        }
+    }
+    return writer.finish();
+}
+
+std::vector<OctreeDelta> decode_deltas(const std::vector<unsigned char> &data) {
+    BitStream stream(data.data(), data.size());
+    const auto count = stream.get(COUNT_BITS);
+    if (!count) {
+        throw std::runtime_error("Error: The delta data is truncated!");
+    }
+    std::vector<OctreeDelta> deltas;
+    // Every delta takes at least 7 bits, which limits the reserved memory for corrupted data.
+    deltas.reserve(std::min<std::size_t>(*count, stream.bits_left() / 7));
+    for (std::uint64_t i = 0; i < *count; i++) {
+        OctreeDelta &delta = deltas.emplace_back();
+        const auto depth = stream.get(DEPTH_BITS);
+        if (!depth) {
+            throw std::runtime_error("Error: The delta data is truncated!");
+        }
+        delta.path.resize(*depth);
+        for (auto &octant : delta.path) {
+            const auto bits = stream.get(OCTANT_BITS);
+            if (!bits) {
+                throw std::runtime_error("Error: The delta data is truncated!");
+            }
+            octant = *bits;
+        }
+        const auto type = stream.get(2);
+        if (!type) {
+            throw std::runtime_error("Error: The delta data is truncated!");
+        }
+        delta.type = static_cast<CubeType>(*type);
+        if (delta.type == CubeType::INDENTED) {
+            const auto levels = stream.get_indentations();
+            if (!levels) {
+                throw std::runtime_error("Error: The delta data is truncated!");
+            }
+            delta.levels = *levels;
+        } else if (delta.type == CubeType::OCTANT) {
+            const auto octant_type = stream.get(1);
+            if (!octant_type) {
+                throw std::runtime_error("Error: The delta data is truncated!");
+            }
+            delta.octant_type = *octant_type ? CubeType::FULL : CubeType::EMPTY;
+        }
+    }
+    return deltas;
+}
+
+void apply_deltas(Cube &root, const std::vector<OctreeDelta> &deltas) {
+    for (const auto &delta : deltas) {
+        Cube *cube = &root;
+        for (const std::size_t octant : delta.path) {
+            if (cube->type() != CubeType::OCTANT || octant >= 8) {
+                throw std::runtime_error("Error: The path of the delta does not lead to a cube of the octree!");
+            }
+            cube = (*cube->octants)[octant].get();
+        }
+        *cube = delta.cube(cube->size(), cube->position());
+    }
+    if (root.journal()) {
+        root.journal()->flush();
+    }
+}
+
+std::vector<OctreeDelta> compact_deltas(const std::vector<OctreeDelta> &deltas) {
+    // The paths of the later deltas, which replace every delta on the same path or on a path within their subtree.
+    std::set<std::vector<std::size_t>> replaced;
+    std::vector<OctreeDelta> compacted;
+    for (auto delta = deltas.rbegin(); delta != deltas.rend(); delta++) {
+        std::vector<std::size_t> prefix;
+        prefix.reserve(delta->path.size());
+        bool obsolete = replaced.count(prefix) != 0;
+        for (std::size_t depth = 0; depth < delta->path.size() && !obsolete; depth++) {
+            prefix.push_back(delta->path[depth]);
+            obsolete = replaced.count(prefix) != 0;
+        }
+        if (!obsolete) {
+            replaced.insert(delta->path);
+            compacted.push_back(*delta);
+        }
+    }
+    std::reverse(compacted.begin(), compacted.end());
+    return compacted;
+}
+
+std::vector<OctreeDelta> diff_octrees(const std::shared_ptr<Cube> &before, const std::shared_ptr<Cube> &after) {
+    if (before->size() != after->size() || before->position() != after->position()) {
+        throw std::runtime_error("Error: The octrees do not have the same size and position!");
+    }
+    std::vector<OctreeDelta> deltas;
+    std::vector<std::size_t> path;
+    diff(before, after, path, deltas);
+    return deltas;
+}
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,82 @@
+#include "inexor/vulkan-renderer/world/octree_generator.hpp"
+
+#include "inexor/vulkan-renderer/world/bit_stream_writer.hpp"
+
+#include <array>
+#include <random>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// Generates the cubes of a random octree.
+class Generator {
+private:
+    const GeneratorSettings &settings;
+    BitStreamWriter &writer;
+    std::mt19937 random;
+
+    /// Get a random number in [0, 1).
+    /// std::uniform_real_distribution is implementation defined, the output of std::mt19937 is not.
+    float uniform() {
+        return static_cast<float>(this->random() >> 8) * (1.0f / 16777216.0f);
+    }
+
+    /// Get a random filled or empty type with the fill ratio.
+    bool filled() {
+        return this->uniform() < this->settings.fill_ratio;
+    }
+
+    void write_leaf(bool filled) {
+        if (!filled) {
+            this->writer.put(static_cast<std::uint8_t>(CubeType::EMPTY), 2);
+            return;
+        }
+        if (this->uniform() >= this->settings.indentation_probability) {
+            this->writer.put(static_cast<std::uint8_t>(CubeType::FULL), 2);
+            return;
+        }
+        this->writer.put(static_cast<std::uint8_t>(CubeType::INDENTED), 2);
+        std::array<glm::tvec3<std::uint8_t>, 8> levels;
+        for (auto &level : levels) {
+            level = {static_cast<std::uint8_t>(this->random() % (MAX_INDENTATION + 1)),
+                     static_cast<std::uint8_t>(this->random() % (MAX_INDENTATION + 1)),
+                     static_cast<std::uint8_t>(this->random() % (MAX_INDENTATION + 1))};
+        }
+        this->writer.put_indentations(levels);
+    }
+
+public:
+    Generator(const GeneratorSettings &settings, BitStreamWriter &writer)
+        : settings(settings), writer(writer), random(settings.seed) {}
+
+    /// Write a cube.
+    /// @param depth The number of levels to subdivide at most.
+    /// @param filled Whether the cube is filled if it is a leaf.
+    void write(std::uint32_t depth, bool filled) {
+        if (depth == 0 || this->uniform() < this->settings.coherence) {
+            this->write_leaf(filled);
+            return;
+        }
+        this->writer.put(static_cast<std::uint8_t>(CubeType::OCTANT), 2);
+        for (std::uint32_t i = 0; i < 8; i++) {
+            const bool inherited = this->uniform() < this->settings.coherence;
+            this->write(depth - 1, inherited ? filled : this->filled());
+        }
+    }
+
+    void write() {
+        this->write(this->settings.depth, this->filled());
+    }
+};
+} // namespace
+
+std::vector<unsigned char> generate_octree_data(const GeneratorSettings &settings) {
+    BitStreamWriter writer;
+    Generator(settings, writer).write();
+    return writer.finish();
+}
+
+Cube generate_octree(const GeneratorSettings &settings) {
+    auto data = generate_octree_data(settings);
+    return Cube::parse(data);
+}
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,84 @@
+#include "inexor/vulkan-renderer/world/octree_history.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// Copy the cubes on the path to a cube and replace the cube.
+/// @param cube The cube on the path.
+/// @param path The octants on the path from the root to the cube.
+/// @param depth The depth of the cube on the path.
+/// @param replacement The new cube.
+/// @return The copy of the cube on the path, which shares all octants which are not on the path.
+std::shared_ptr<Cube> copy_path(const std::shared_ptr<Cube> &cube, const std::vector<std::size_t> &path,
+                                std::size_t depth, std::shared_ptr<Cube> replacement) {
+    if (depth == path.size()) {
+        if (cube->size() != replacement->size() || cube->position() != replacement->position()) {
+            throw std::runtime_error("Error: The new cube does not have the size and position of the replaced one!");
+        }
+        return replacement;
+    }
+    if (cube->type() != CubeType::OCTANT || path[depth] >= 8) {
+        throw std::runtime_error("Error: The path does not lead to a cube of the octree!");
+    }
+    auto copy = std::make_shared<Cube>(*cube);
+    auto &octant = copy->octants.value()[path[depth]];
+    octant = copy_path(octant, path, depth + 1, std::move(replacement));
+    return copy;
+}
+} // namespace
+
+OctreeHistory::OctreeHistory(Cube &root, std::size_t max_undo) : current(root.clone()), max_undo(max_undo) {}
+
+void OctreeHistory::publish(std::shared_ptr<Cube> version) {
+    std::scoped_lock lock(this->current_mutex);
+    this->current = std::move(version);
+}
+
+std::shared_ptr<Cube> OctreeHistory::snapshot() const {
+    std::scoped_lock lock(this->current_mutex);
+    return this->current;
+}
+
+void OctreeHistory::assign(const std::vector<std::size_t> &path, Cube &cube) {
+    // Only the edit thread changes the current version, so it can be read without the lock here.
+    std::shared_ptr<Cube> version = copy_path(this->current, path, 0, cube.clone());
+    this->undo_versions.push_back(this->current);
+    if (this->undo_versions.size() > this->max_undo) {
+        this->undo_versions.pop_front();
+    }
+    this->redo_versions.clear();
+    this->publish(std::move(version));
+}
+
+bool OctreeHistory::undo() {
+    if (this->undo_versions.empty()) {
+        return false;
+    }
+    this->redo_versions.push_back(this->current);
+    std::shared_ptr<Cube> version = std::move(this->undo_versions.back());
+    this->undo_versions.pop_back();
+    this->publish(std::move(version));
+    return true;
+}
+
+bool OctreeHistory::redo() {
+    if (this->redo_versions.empty()) {
+        return false;
+    }
+    this->undo_versions.push_back(this->current);
+    std::shared_ptr<Cube> version = std::move(this->redo_versions.back());
+    this->redo_versions.pop_back();
+    this->publish(std::move(version));
+    return true;
+}
+
+std::size_t OctreeHistory::undo_count() const {
+    return this->undo_versions.size();
+}
+
+std::size_t OctreeHistory::redo_count() const {
+    return this->redo_versions.size();
+}
+} // namespace inexor::vulkan_renderer::world
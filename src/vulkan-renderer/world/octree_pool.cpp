@@ -0,0 +1,502 @@
+#include "inexor/vulkan-renderer/world/octree_pool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// Pack the indentation levels of a cube.
+OctreePool::PackedIndentations pack(const std::array<glm::tvec3<std::uint8_t>, 8> &levels) {
+    OctreePool::PackedIndentations packed{};
+    for (std::uint32_t i = 0; i < levels.size(); i++) {
+        for (std::uint32_t axis = 0; axis < 3; axis++) {
+            packed[axis] |= static_cast<std::uint32_t>(levels[i][axis]) << (4 * i);
+        }
+    }
+    return packed;
+}
+
+/// Unpack the indentation levels of a cube.
+std::array<glm::tvec3<std::uint8_t>, 8> unpack(const OctreePool::PackedIndentations &packed) {
+    std::array<glm::tvec3<std::uint8_t>, 8> levels;
+    for (std::uint32_t i = 0; i < levels.size(); i++) {
+        for (std::uint32_t axis = 0; axis < 3; axis++) {
+            levels[i][axis] = static_cast<std::uint8_t>(packed[axis] >> (4 * i) & 0xFu);
+        }
+    }
+    return levels;
+}
+
+/// Get the indentation levels of a Cube of CubeType::INDENTED.
+std::array<glm::tvec3<std::uint8_t>, 8> cube_levels(Cube &cube) {
+    std::array<glm::tvec3<std::uint8_t>, 8> levels;
+    for (std::size_t i = 0; i < levels.size(); i++) {
+        levels[i] = (*cube.indentations)[i].vec();
+    }
+    return levels;
+}
+
+/// Read the type of a cube from a stream.
+CubeType parse_type(BitStream &stream) {
+    const auto type = stream.get(2);
+    if (!type) {
+        throw std::runtime_error("Error: Octree data ended before the type of a cube was read!");
+    }
+    return static_cast<CubeType>(*type);
+}
+
+/// Read the indentation levels of a cube from a stream.
+std::array<glm::tvec3<std::uint8_t>, 8> parse_indentations(BitStream &stream) {
+    const auto levels = stream.get_indentations();
+    if (!levels) {
+        throw std::runtime_error("Error: Octree data ended before the indentations were read!");
+    }
+    return *levels;
+}
+
+/// Combine a value into a hash.
+std::size_t combine(std::size_t hash, std::uint32_t value) {
+    return static_cast<std::size_t>((hash ^ value) * 0x9E3779B97F4A7C15);
+}
+
+/// Hash the content of a run of octants.
+template <typename T, typename Hash>
+std::size_t hash_run(const std::array<T, 8> &run, std::size_t count, Hash hash) {
+    std::size_t result = count;
+    for (std::size_t i = 0; i < count; i++) {
+        result = combine(result, static_cast<std::uint32_t>(hash(run[i])));
+    }
+    return result;
+}
+
+/// Store a run of octants in a pool, or find an identical run which is stored already.
+/// @param pool The pool.
+/// @param run The octants.
+/// @param count The number of octants.
+/// @param runs The runs in the pool by their hash, with their first index and length, nullptr to append the run.
+/// @param hash The hash of one octant.
+/// @return The index of the first octant of the run, 0 for an empty run.
+template <typename T, typename Hash>
+std::uint32_t store_run(std::vector<T> &pool, const std::array<T, 8> &run, std::size_t count,
+                        std::unordered_multimap<std::size_t, std::pair<std::uint32_t, std::size_t>> *runs,
+                        Hash hash) {
+    // Empty runs are not stored, the index is the same for all of them so that identical nodes compare equal.
+    if (count == 0) {
+        return 0;
+    }
+    std::size_t run_hash = 0;
+    if (runs != nullptr) {
+        run_hash = hash_run(run, count, hash);
+        const auto [first, last] = runs->equal_range(run_hash);
+        for (auto candidate = first; candidate != last; ++candidate) {
+            const auto [start, length] = candidate->second;
+            if (length == count && std::equal(run.begin(), run.begin() + count, pool.begin() + start)) {
+                return start;
+            }
+        }
+    }
+    const auto start = static_cast<std::uint32_t>(pool.size());
+    pool.insert(pool.end(), run.begin(), run.begin() + count);
+    if (runs != nullptr) {
+        runs->emplace(run_hash, std::make_pair(start, count));
+    }
+    return start;
+}
+
+/// Hash packed indentation levels.
+std::size_t hash_indentations(const OctreePool::PackedIndentations &indentations) {
+    return combine(combine(combine(0, indentations[0]), indentations[1]), indentations[2]);
+}
+} // namespace
+
+bool OctreePool::Node::operator==(const Node &other) const {
+    return this->octants == other.octants && this->indentations == other.indentations && this->types == other.types;
+}
+
+std::size_t OctreePool::NodeHash::operator()(const Node &node) const {
+    return combine(combine(combine(0, node.octants), node.indentations), node.types);
+}
+
+struct OctreePool::RunIndex {
+    /// Runs of the node pool by their hash, with their first index and length.
+    std::unordered_multimap<std::size_t, std::pair<std::uint32_t, std::size_t>> nodes;
+
+    /// Runs of the indentation pool by their hash, with their first index and length.
+    std::unordered_multimap<std::size_t, std::pair<std::uint32_t, std::size_t>> indentations;
+};
+
+CubeView::CubeView(const OctreePool *pool, CubeType type, std::uint32_t node, float size, const glm::vec3 &position)
+    : pool(pool), cube_type(type), node(node), cube_size(size), cube_position(position) {
+    assert(pool);
+}
+
+std::uint32_t CubeView::index() const {
+    return this->node;
+}
+
+CubeType CubeView::type() const {
+    return this->cube_type;
+}
+
+float CubeView::size() const {
+    return this->cube_size;
+}
+
+glm::vec3 CubeView::position() const {
+    return this->cube_position;
+}
+
+CubeView CubeView::octant(std::size_t octant) const {
+    assert(this->cube_type == CubeType::OCTANT);
+    assert(octant < 8);
+    const float half = this->cube_size / 2;
+    // Bit 2 selects the x-axis half, bit 1 the y-axis half and bit 0 the z-axis half (see Cube::octants).
+    const glm::vec3 offset = {(octant & 4) ? half : 0.0f, (octant & 2) ? half : 0.0f, (octant & 1) ? half : 0.0f};
+    const CubeType type = this->pool->type(this->node, octant);
+    const std::uint32_t index =
+        type == CubeType::OCTANT || type == CubeType::INDENTED ? this->pool->child(this->node, octant) : 0;
+    return CubeView(this->pool, type, index, half, this->cube_position + offset);
+}
+
+std::array<CubeView, 8> CubeView::octants() const {
+    return {this->octant(0), this->octant(1), this->octant(2), this->octant(3),
+            this->octant(4), this->octant(5), this->octant(6), this->octant(7)};
+}
+
+std::array<glm::tvec3<std::uint8_t>, 8> CubeView::indentation_levels() const {
+    assert(this->cube_type == CubeType::INDENTED);
+    return this->pool->indentation_levels(this->node);
+}
+
+std::uint64_t CubeView::leaves() const {
+    switch (this->cube_type) {
+    case CubeType::EMPTY:
+        return 0;
+    case CubeType::FULL:
+    case CubeType::INDENTED:
+        return 1;
+    case CubeType::OCTANT:
+        std::uint64_t i = 0;
+        for (const auto &octant : this->octants()) {
+            i += octant.leaves();
+        }
+        return i;
+    }
+    assert(false); // This point should never be reached, as we handled all types already.
+    return 0;
+}
+
+std::vector<std::array<glm::vec3, 3>> CubeView::polygons() const {
+    std::vector<std::array<glm::vec3, 3>> polygons;
+    polygons.reserve(this->leaves() * 12);
+    this->polygons(polygons);
+    return polygons;
+}
+
+void CubeView::polygons(std::vector<std::array<glm::vec3, 3>> &polygons) const {
+    if (this->cube_type == CubeType::EMPTY) {
+        return;
+    }
+    if (this->cube_type == CubeType::OCTANT) {
+        for (const auto &octant : this->octants()) {
+            octant.polygons(polygons);
+        }
+        return;
+    }
+
+    const auto cube_polygons = this->cube_type == CubeType::FULL
+                                   ? Cube::leaf_polygons(this->cube_type, this->cube_size, this->cube_position, {})
+                                   : Cube::leaf_polygons(this->cube_type, this->cube_size, this->cube_position,
+                                                         this->indentation_levels());
+    polygons.insert(polygons.end(), cube_polygons.begin(), cube_polygons.end());
+}
+
+OctreePool::OctreePool(float size, const glm::vec3 &position) : root_size(size), root_position(position) {}
+
+OctreePool::OctreePool(Cube &cube, bool share) : OctreePool(cube.size(), cube.position()) {
+    this->root_type = cube.type();
+    if (this->root_type == CubeType::OCTANT) {
+        RunIndex index;
+        const Node node = this->copy_node(cube, share ? &index : nullptr);
+        this->root_index = static_cast<std::uint32_t>(this->nodes.size());
+        this->nodes.push_back(node);
+    } else if (this->root_type == CubeType::INDENTED) {
+        this->indentation_pool.push_back(pack(cube_levels(cube)));
+    }
+}
+
+OctreePool OctreePool::parse(std::vector<unsigned char> &data, bool share) {
+    BitStream stream = BitStream(data.data(), data.size());
+    return OctreePool::parse(stream, DEFAULT_CUBE_SIZE, DEFAULT_CUBE_POSITION, share);
+}
+
+OctreePool OctreePool::parse(BitStream &stream, float size, const glm::vec3 &position, bool share) {
+    OctreePool pool(size, position);
+    pool.root_type = parse_type(stream);
+    if (pool.root_type == CubeType::OCTANT) {
+        RunIndex index;
+        const Node node = pool.parse_node(stream, share ? &index : nullptr);
+        pool.root_index = static_cast<std::uint32_t>(pool.nodes.size());
+        pool.nodes.push_back(node);
+    } else if (pool.root_type == CubeType::INDENTED) {
+        pool.indentation_pool.push_back(pack(parse_indentations(stream)));
+    }
+    return pool;
+}
+
+OctreePool::Node OctreePool::append(const std::array<Node, 8> &octant_nodes, std::size_t octant_count,
+                                    const std::array<PackedIndentations, 8> &octant_indentations,
+                                    std::size_t indented_count, std::uint16_t types, RunIndex *index) {
+    // Identical subtrees have identical nodes once the runs of their octants are shared, so sharing the runs bottom up
+    // shares whole subtrees.
+    const std::uint32_t octants = store_run(this->nodes, octant_nodes, octant_count,
+                                            index != nullptr ? &index->nodes : nullptr, NodeHash());
+    const std::uint32_t indentations =
+        store_run(this->indentation_pool, octant_indentations, indented_count,
+                  index != nullptr ? &index->indentations : nullptr, hash_indentations);
+    return Node{octants, indentations, types};
+}
+
+OctreePool::Node OctreePool::parse_node(BitStream &stream, RunIndex *index) {
+    this->octree_nodes++;
+    // The octants of one node are collected first, as the subtrees of the octants before them are appended in between.
+    std::array<Node, 8> octant_nodes;
+    std::array<PackedIndentations, 8> octant_indentations;
+    std::size_t octant_count = 0;
+    std::size_t indented_count = 0;
+    std::uint16_t types = 0;
+    for (std::uint32_t i = 0; i < 8; i++) {
+        const CubeType type = parse_type(stream);
+        types |= static_cast<std::uint16_t>(static_cast<std::uint32_t>(type) << (2 * i));
+        if (type == CubeType::OCTANT) {
+            octant_nodes[octant_count++] = this->parse_node(stream, index);
+        } else if (type == CubeType::INDENTED) {
+            octant_indentations[indented_count++] = pack(parse_indentations(stream));
+        }
+    }
+    return this->append(octant_nodes, octant_count, octant_indentations, indented_count, types, index);
+}
+
+OctreePool::Node OctreePool::copy_node(Cube &cube, RunIndex *index) {
+    this->octree_nodes++;
+    std::array<Node, 8> octant_nodes;
+    std::array<PackedIndentations, 8> octant_indentations;
+    std::size_t octant_count = 0;
+    std::size_t indented_count = 0;
+    std::uint16_t types = 0;
+    for (std::uint32_t i = 0; i < 8; i++) {
+        Cube &octant = *(*cube.octants)[i];
+        const CubeType type = octant.type();
+        types |= static_cast<std::uint16_t>(static_cast<std::uint32_t>(type) << (2 * i));
+        if (type == CubeType::OCTANT) {
+            octant_nodes[octant_count++] = this->copy_node(octant, index);
+        } else if (type == CubeType::INDENTED) {
+            octant_indentations[indented_count++] = pack(cube_levels(octant));
+        }
+    }
+    return this->append(octant_nodes, octant_count, octant_indentations, indented_count, types, index);
+}
+
+OctreePool::Node OctreePool::copy_node(const OctreePool &source, const Node &node, RunIndex *index,
+                                       std::unordered_map<Node, Node, NodeHash> &copies) {
+    if (const auto copy = copies.find(node); copy != copies.end()) {
+        return copy->second;
+    }
+    std::array<Node, 8> octant_nodes;
+    std::array<PackedIndentations, 8> octant_indentations;
+    std::size_t octant_count = 0;
+    std::size_t indented_count = 0;
+    for (std::uint32_t i = 0; i < 8; i++) {
+        const auto type = static_cast<CubeType>(node.types >> (2 * i) & 0b11u);
+        if (type == CubeType::OCTANT) {
+            const Node octant = source.nodes[node.octants + octant_count];
+            octant_nodes[octant_count++] = this->copy_node(source, octant, index, copies);
+        } else if (type == CubeType::INDENTED) {
+            octant_indentations[indented_count] = source.indentation_pool[node.indentations + indented_count];
+            indented_count++;
+        }
+    }
+    const Node copy =
+        this->append(octant_nodes, octant_count, octant_indentations, indented_count, node.types, index);
+    copies.emplace(node, copy);
+    return copy;
+}
+
+OctreePool::Node OctreePool::replace(std::uint32_t node, std::size_t octant, CubeType type, const Node &octant_node,
+                                     const PackedIndentations &indentations) {
+    std::array<Node, 8> octant_nodes;
+    std::array<PackedIndentations, 8> octant_indentations;
+    std::size_t octant_count = 0;
+    std::size_t indented_count = 0;
+    std::uint16_t types = 0;
+    for (std::uint32_t i = 0; i < 8; i++) {
+        const CubeType octant_type = i == octant ? type : this->type(node, i);
+        types |= static_cast<std::uint16_t>(static_cast<std::uint32_t>(octant_type) << (2 * i));
+        if (octant_type == CubeType::OCTANT) {
+            octant_nodes[octant_count++] = i == octant ? octant_node : this->nodes[this->child(node, i)];
+        } else if (octant_type == CubeType::INDENTED) {
+            octant_indentations[indented_count++] =
+                i == octant ? indentations : this->indentation_pool[this->child(node, i)];
+        }
+    }
+    return this->append(octant_nodes, octant_count, octant_indentations, indented_count, types, nullptr);
+}
+
+std::pair<std::size_t, std::size_t> OctreePool::count_cubes(const Node &node) const {
+    // Count the cubes of every stored node once, identical nodes have identical subtrees.
+    std::unordered_map<Node, std::pair<std::size_t, std::size_t>, NodeHash> counts;
+    const auto count = [&](const auto &self, const Node &subtree) -> std::pair<std::size_t, std::size_t> {
+        if (const auto known = counts.find(subtree); known != counts.end()) {
+            return known->second;
+        }
+        std::pair<std::size_t, std::size_t> result{1, 0};
+        std::uint32_t octant_count = 0;
+        for (std::uint32_t i = 0; i < 8; i++) {
+            const auto type = static_cast<CubeType>(subtree.types >> (2 * i) & 0b11u);
+            if (type == CubeType::OCTANT) {
+                const auto octant = self(self, this->nodes[subtree.octants + octant_count++]);
+                result.first += octant.first;
+                result.second += octant.second;
+            } else if (type == CubeType::INDENTED) {
+                result.second++;
+            }
+        }
+        counts.emplace(subtree, result);
+        return result;
+    };
+    return count(count, node);
+}
+
+void OctreePool::rebuild(bool share) {
+    OctreePool pool(this->root_size, this->root_position);
+    pool.root_type = this->root_type;
+    if (this->root_type == CubeType::OCTANT) {
+        RunIndex index;
+        std::unordered_map<Node, Node, NodeHash> copies;
+        const Node node = pool.copy_node(*this, this->nodes[this->root_index], share ? &index : nullptr, copies);
+        pool.root_index = static_cast<std::uint32_t>(pool.nodes.size());
+        pool.nodes.push_back(node);
+    } else if (this->root_type == CubeType::INDENTED) {
+        pool.indentation_pool.push_back(this->indentation_pool[this->root_index]);
+    }
+    // Copying a shared subtree again only looks up the copy, the octree itself does not change.
+    pool.octree_nodes = this->octree_nodes;
+    *this = std::move(pool);
+}
+
+CubeView OctreePool::root() const {
+    return CubeView(this, this->root_type, this->root_index, this->root_size, this->root_position);
+}
+
+CubeType OctreePool::type(std::uint32_t node, std::size_t octant) const {
+    assert(node < this->nodes.size());
+    assert(octant < 8);
+    return static_cast<CubeType>(this->nodes[node].types >> (2 * octant) & 0b11u);
+}
+
+std::uint32_t OctreePool::child(std::uint32_t node, std::size_t octant) const {
+    const CubeType type = this->type(node, octant);
+    assert(type == CubeType::OCTANT || type == CubeType::INDENTED);
+    // Compare the types of all octants at once, the lower bit of each octant is set if its type is the same.
+    const std::uint32_t same = ~(this->nodes[node].types ^ (static_cast<std::uint32_t>(type) * 0x5555u));
+    std::uint32_t before = same & same >> 1 & 0x5555u & ((1u << (2 * octant)) - 1);
+    std::uint32_t count = 0;
+    for (; before != 0; before &= before - 1) {
+        count++;
+    }
+    const Node &parent = this->nodes[node];
+    return (type == CubeType::OCTANT ? parent.octants : parent.indentations) + count;
+}
+
+std::array<glm::tvec3<std::uint8_t>, 8> OctreePool::indentation_levels(std::uint32_t index) const {
+    assert(index < this->indentation_pool.size());
+    return unpack(this->indentation_pool[index]);
+}
+
+std::size_t OctreePool::node_count() const {
+    // Every node has 8 octants, only the root is no octant.
+    return 1 + 8 * this->octree_nodes;
+}
+
+std::size_t OctreePool::memory_usage() const {
+    return sizeof(OctreePool) + this->nodes.capacity() * sizeof(Node) +
+           this->indentation_pool.capacity() * sizeof(PackedIndentations);
+}
+
+void OctreePool::shrink_to_fit() {
+    this->nodes.shrink_to_fit();
+    this->indentation_pool.shrink_to_fit();
+}
+
+void OctreePool::assign(const std::vector<std::size_t> &path, Cube &cube) {
+    // Find the nodes on the path, they are copied from the bottom up as their subtrees may be shared.
+    std::vector<std::uint32_t> parents;
+    parents.reserve(path.size());
+    CubeType type = this->root_type;
+    std::uint32_t index = this->root_index;
+    for (const std::size_t octant : path) {
+        if (type != CubeType::OCTANT || octant >= 8) {
+            throw std::runtime_error("Error: The path does not lead to a cube of the octree!");
+        }
+        parents.push_back(index);
+        type = this->type(index, octant);
+        index = type == CubeType::OCTANT || type == CubeType::INDENTED ? this->child(index, octant) : 0;
+    }
+
+    if (type == CubeType::OCTANT) {
+        this->octree_nodes -= this->count_cubes(this->nodes[index]).first;
+    }
+
+    type = cube.type();
+    Node node{};
+    PackedIndentations indentations{};
+    if (type == CubeType::OCTANT) {
+        node = this->copy_node(cube, nullptr);
+    } else if (type == CubeType::INDENTED) {
+        indentations = pack(cube_levels(cube));
+    }
+    for (std::size_t i = path.size(); i-- > 0;) {
+        node = this->replace(parents[i], path[i], type, node, indentations);
+        type = CubeType::OCTANT;
+    }
+
+    this->root_type = type;
+    this->root_index = 0;
+    if (type == CubeType::OCTANT) {
+        this->root_index = static_cast<std::uint32_t>(this->nodes.size());
+        this->nodes.push_back(node);
+    } else if (type == CubeType::INDENTED) {
+        this->root_index = static_cast<std::uint32_t>(this->indentation_pool.size());
+        this->indentation_pool.push_back(indentations);
+    }
+}
+
+void OctreePool::share_subtrees() {
+    this->rebuild(true);
+}
+
+void OctreePool::compact() {
+    this->rebuild(false);
+}
+
+double OctreePool::Statistics::ratio() const {
+    const std::size_t stored = this->stored_nodes + this->stored_indentations;
+    return stored == 0 ? 1.0 : static_cast<double>(this->octree_nodes + this->octree_indentations) / stored;
+}
+
+OctreePool::Statistics OctreePool::statistics() const {
+    Statistics statistics;
+    statistics.stored_nodes = this->nodes.size();
+    statistics.stored_indentations = this->indentation_pool.size();
+    if (this->root_type == CubeType::INDENTED) {
+        statistics.octree_indentations = 1;
+    } else if (this->root_type == CubeType::OCTANT) {
+        std::tie(statistics.octree_nodes, statistics.octree_indentations) =
+            this->count_cubes(this->nodes[this->root_index]);
+    }
+    return statistics;
+}
+} // namespace inexor::vulkan_renderer::world
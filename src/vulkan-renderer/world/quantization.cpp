@@ -0,0 +1,63 @@
+#include "inexor/vulkan-renderer/world/quantization.hpp"
+
+#include "inexor/vulkan-renderer/world/cube.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cmath>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// Convert a value in [-1, 1] to a signed normalized 16 bit value.
+std::int16_t to_snorm(float value) {
+    return static_cast<std::int16_t>(std::round(glm::clamp(value, -1.0f, 1.0f) * 32767.0f));
+}
+
+/// Convert a signed normalized 16 bit value to a value in [-1, 1], as the vertex input of the GPU does.
+float from_snorm(std::int16_t value) {
+    return glm::max(static_cast<float>(value) / 32767.0f, -1.0f);
+}
+
+/// Get the sign of a value, 1 for 0.
+float sign(float value) {
+    return value >= 0.0f ? 1.0f : -1.0f;
+}
+} // namespace
+
+PositionQuantization PositionQuantization::for_chunk(float size, const glm::vec3 &position) {
+    // The chunk spans 2^15 steps, so that its far corner (2^15) fits into 16 bit as well.
+    return {position, size / static_cast<float>(MAX_INDENTATION << QUANTIZATION_DEPTH)};
+}
+
+std::array<std::uint16_t, 3> PositionQuantization::encode(const glm::vec3 &position) const {
+    const glm::vec3 steps = glm::clamp(glm::round((position - this->origin) / this->step), 0.0f, 65535.0f);
+    return {static_cast<std::uint16_t>(steps.x), static_cast<std::uint16_t>(steps.y),
+            static_cast<std::uint16_t>(steps.z)};
+}
+
+glm::vec3 PositionQuantization::decode(const std::array<std::uint16_t, 3> &steps) const {
+    return this->origin + glm::vec3(steps[0], steps[1], steps[2]) * this->step;
+}
+
+std::array<std::int16_t, 2> encode_normal(const glm::vec3 &normal) {
+    const float length = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+    if (length == 0.0f) {
+        return {0, 0};
+    }
+    const glm::vec3 projected = normal / length;
+    if (projected.z >= 0.0f) {
+        return {to_snorm(projected.x), to_snorm(projected.y)};
+    }
+    return {to_snorm((1.0f - std::abs(projected.y)) * sign(projected.x)),
+            to_snorm((1.0f - std::abs(projected.x)) * sign(projected.y))};
+}
+
+glm::vec3 decode_normal(const std::array<std::int16_t, 2> &encoded) {
+    glm::vec3 normal(from_snorm(encoded[0]), from_snorm(encoded[1]), 0.0f);
+    normal.z = 1.0f - std::abs(normal.x) - std::abs(normal.y);
+    const float fold = glm::max(-normal.z, 0.0f);
+    normal.x += normal.x >= 0.0f ? -fold : fold;
+    normal.y += normal.y >= 0.0f ? -fold : fold;
+    return glm::normalize(normal);
+}
+} // namespace inexor::vulkan_renderer::world
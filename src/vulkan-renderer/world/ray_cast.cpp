@@ -0,0 +1,182 @@
+#include "inexor/vulkan-renderer/world/ray_cast.hpp"
+
+#include "inexor/vulkan-renderer/thread_pool.hpp"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <future>
+#include <utility>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// The intersection of a ray with the bounds of a cube.
+struct BoxHit {
+    /// Distance at which the ray enters the bounds, negative if it starts within them.
+    float entry;
+
+    /// Distance at which the ray leaves the bounds.
+    float exit;
+
+    /// The axis of the side the ray enters through.
+    int entry_axis;
+
+    /// The axis of the side the ray leaves through.
+    int exit_axis;
+};
+
+/// Intersect a ray with the bounds of a cube (slab test).
+/// @return The intersection, std::nullopt if the ray misses the bounds or they are behind the origin.
+std::optional<BoxHit> intersect_bounds(const Ray &ray, const glm::vec3 &position, float size) {
+    BoxHit hit{-std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(), 0, 0};
+    for (int axis = 0; axis < 3; axis++) {
+        const float origin = ray.origin[axis];
+        const float direction = ray.direction[axis];
+        const float min = position[axis];
+        const float max = position[axis] + size;
+        if (direction == 0.0f) {
+            if (origin < min || origin > max) {
+                return std::nullopt;
+            }
+            continue;
+        }
+        float near = (min - origin) / direction;
+        float far = (max - origin) / direction;
+        if (near > far) {
+            std::swap(near, far);
+        }
+        if (near > hit.entry) {
+            hit.entry = near;
+            hit.entry_axis = axis;
+        }
+        if (far < hit.exit) {
+            hit.exit = far;
+            hit.exit_axis = axis;
+        }
+    }
+    if (hit.entry > hit.exit || hit.exit < 0.0f) {
+        return std::nullopt;
+    }
+    return hit;
+}
+
+/// Intersect a ray with a triangle from both sides (Möller-Trumbore).
+/// @return The distance of the intersection, std::nullopt if the triangle is missed or degenerated.
+std::optional<float> intersect_polygon(const Ray &ray, const std::array<glm::vec3, 3> &polygon) {
+    const glm::vec3 edge1 = polygon[1] - polygon[0];
+    const glm::vec3 edge2 = polygon[2] - polygon[0];
+    const glm::vec3 p = glm::cross(ray.direction, edge2);
+    const float determinant = glm::dot(edge1, p);
+    if (determinant == 0.0f) {
+        return std::nullopt;
+    }
+    const float inverse = 1.0f / determinant;
+    const glm::vec3 s = ray.origin - polygon[0];
+    const float u = glm::dot(s, p) * inverse;
+    if (u < 0.0f || u > 1.0f) {
+        return std::nullopt;
+    }
+    const glm::vec3 q = glm::cross(s, edge1);
+    const float v = glm::dot(ray.direction, q) * inverse;
+    if (v < 0.0f || u + v > 1.0f) {
+        return std::nullopt;
+    }
+    const float distance = glm::dot(edge2, q) * inverse;
+    if (distance < 0.0f) {
+        return std::nullopt;
+    }
+    return distance;
+}
+
+/// Cast a ray against a cube whose bounds are intersected by the ray.
+/// @param cube The cube.
+/// @param ray The ray.
+/// @param bounds The intersection of the ray with the bounds of the cube.
+/// @param hit The closest hit so far, replaced by any closer hit.
+/// @param max_distance The distance of the closest hit so far.
+void cast(Cube &cube, const Ray &ray, const BoxHit &bounds, std::optional<RayHit> &hit, float &max_distance) {
+    switch (cube.type()) {
+    case CubeType::EMPTY:
+        return;
+    case CubeType::FULL: {
+        // A ray which starts within the cube hits the side it leaves the cube through.
+        const bool inside = bounds.entry < 0.0f;
+        const float distance = inside ? bounds.exit : bounds.entry;
+        if (distance > max_distance) {
+            return;
+        }
+        const int axis = inside ? bounds.exit_axis : bounds.entry_axis;
+        const bool high = (ray.direction[axis] < 0.0f) != inside;
+        hit = RayHit{&cube, static_cast<std::size_t>(axis) * 2 + (high ? 1 : 0), ray.origin + ray.direction * distance,
+                     distance};
+        max_distance = distance;
+        return;
+    }
+    case CubeType::INDENTED: {
+        std::array<glm::tvec3<std::uint8_t>, 8> levels;
+        for (std::size_t i = 0; i < levels.size(); i++) {
+            levels[i] = (*cube.indentations)[i].vec();
+        }
+        const auto polygons = Cube::leaf_polygons(CubeType::INDENTED, cube.size(), cube.position(), levels);
+        for (std::size_t i = 0; i < polygons.size(); i++) {
+            const auto distance = intersect_polygon(ray, polygons[i]);
+            if (distance && *distance <= max_distance) {
+                hit = RayHit{&cube, i / 2, ray.origin + ray.direction * *distance, *distance};
+                max_distance = *distance;
+            }
+        }
+        return;
+    }
+    case CubeType::OCTANT:
+        // Visit the octants in the order the ray enters them, until they are further away than the closest hit.
+        std::array<std::pair<BoxHit, std::size_t>, 8> octants;
+        std::size_t count = 0;
+        const float half = cube.size() / 2;
+        for (std::size_t i = 0; i < 8; i++) {
+            const Cube &octant = *(*cube.octants)[i];
+            if (auto octant_bounds = intersect_bounds(ray, octant.position(), half)) {
+                octants[count++] = {*octant_bounds, i};
+            }
+        }
+        std::sort(octants.begin(), octants.begin() + static_cast<std::ptrdiff_t>(count),
+                  [](const auto &lhs, const auto &rhs) { return lhs.first.entry < rhs.first.entry; });
+        for (std::size_t i = 0; i < count && octants[i].first.entry <= max_distance; i++) {
+            cast(*(*cube.octants)[octants[i].second], ray, octants[i].first, hit, max_distance);
+        }
+        return;
+    }
+}
+} // namespace
+
+std::optional<RayHit> ray_cast(Cube &cube, const Ray &ray, float max_distance) {
+    assert(ray.direction != glm::vec3(0.0f));
+    std::optional<RayHit> hit;
+    if (const auto bounds = intersect_bounds(ray, cube.position(), cube.size())) {
+        if (bounds->entry <= max_distance) {
+            cast(cube, ray, *bounds, hit, max_distance);
+        }
+    }
+    return hit;
+}
+
+std::vector<std::optional<RayHit>> ray_cast(Cube &cube, const std::vector<Ray> &rays, ThreadPool &thread_pool,
+                                            float max_distance, std::size_t batch_size) {
+    assert(batch_size > 0);
+    std::vector<std::optional<RayHit>> hits(rays.size());
+    std::vector<std::future<void>> tasks;
+    for (std::size_t first = 0; first < rays.size(); first += batch_size) {
+        const std::size_t last = std::min(first + batch_size, rays.size());
+        tasks.push_back(thread_pool.execute([&cube, &rays, &hits, max_distance, first, last]() {
+            for (std::size_t i = first; i < last; i++) {
+                hits[i] = ray_cast(cube, rays[i], max_distance);
+            }
+        }));
+    }
+    for (auto &task : tasks) {
+        task.get();
+    }
+    return hits;
+}
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,77 @@
+#include "inexor/vulkan-renderer/world/subtree_index.hpp"
+
+#include "inexor/vulkan-renderer/world/cube.hpp"
+
+#include <utility>
+
+namespace inexor::vulkan_renderer::world {
+SubtreeIndex::SubtreeIndex(std::uint32_t depth, std::vector<std::size_t> offsets)
+    : index_depth(depth), node_offsets(std::move(offsets)) {}
+
+std::optional<SubtreeIndex> SubtreeIndex::build(const unsigned char *data, std::size_t byte_size,
+                                                std::uint32_t depth) {
+    SubtreeIndex index;
+    index.index_depth = depth;
+    BitStream stream(data, byte_size);
+    if (!index.collect(stream, byte_size * 8, 0)) {
+        return std::nullopt;
+    }
+    return index;
+}
+
+bool SubtreeIndex::collect(BitStream &stream, std::size_t stream_bits, std::uint32_t depth) {
+    this->node_offsets.push_back(stream_bits - stream.bits_left());
+    if (depth == this->index_depth) {
+        return SubtreeIndex::skip(stream);
+    }
+    const std::optional<std::uint64_t> type = stream.get(2);
+    if (!type) {
+        return false;
+    }
+    switch (static_cast<CubeType>(*type)) {
+    case CubeType::EMPTY:
+    case CubeType::FULL:
+        return true;
+    case CubeType::INDENTED:
+        return stream.get_indentations().has_value();
+    case CubeType::OCTANT:
+        for (std::uint32_t i = 0; i < 8; i++) {
+            if (!this->collect(stream, stream_bits, depth + 1)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+bool SubtreeIndex::skip(BitStream &stream) {
+    const std::optional<std::uint64_t> type = stream.get(2);
+    if (!type) {
+        return false;
+    }
+    switch (static_cast<CubeType>(*type)) {
+    case CubeType::EMPTY:
+    case CubeType::FULL:
+        return true;
+    case CubeType::INDENTED:
+        return stream.get_indentations().has_value();
+    case CubeType::OCTANT:
+        for (std::uint32_t i = 0; i < 8; i++) {
+            if (!SubtreeIndex::skip(stream)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+std::uint32_t SubtreeIndex::depth() const {
+    return this->index_depth;
+}
+
+const std::vector<std::size_t> &SubtreeIndex::offsets() const {
+    return this->node_offsets;
+}
+} // namespace inexor::vulkan_renderer::world
@@ -7,7 +7,8 @@ namespace inexor::vulkan_renderer::wrapper {
 MeshBuffer::MeshBuffer(MeshBuffer &&other) noexcept
     : name(std::move(other.name)), vertex_buffer(std::move(other.vertex_buffer)),
       index_buffer(std::move(other.index_buffer)), number_of_vertices(other.number_of_vertices),
-      number_of_indices(other.number_of_indices) {}
+      size_of_vertex_structure(other.size_of_vertex_structure), size_of_index_structure(other.size_of_index_structure),
+      number_of_indices(other.number_of_indices), index_buffer_available(other.index_buffer_available) {}
 
 MeshBuffer::MeshBuffer(const VkDevice device, VkQueue data_transfer_queue,
                        const std::uint32_t data_transfer_queue_family_index, const VmaAllocator vma_allocator,
@@ -19,13 +20,17 @@ MeshBuffer::MeshBuffer(const VkDevice device, VkQueue data_transfer_queue,
     // created!.
     : vertex_buffer(device, vma_allocator, name, size_of_vertex_structure * number_of_vertices,
                     VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_ONLY),
-      index_buffer(GPUMemoryBuffer(device, vma_allocator, name, size_of_index_structure * number_of_vertices,
-                                   VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-                                   VMA_MEMORY_USAGE_CPU_ONLY)) {
+      index_buffer(GPUMemoryBuffer(device, vma_allocator, name, size_of_index_structure * number_of_indices,
+                                   VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                                   VMA_MEMORY_USAGE_CPU_ONLY)),
+      number_of_vertices(static_cast<std::uint32_t>(number_of_vertices)),
+      size_of_vertex_structure(size_of_vertex_structure), size_of_index_structure(size_of_index_structure),
+      number_of_indices(static_cast<std::uint32_t>(number_of_indices)), index_buffer_available(true) {
     assert(device);
     assert(vma_allocator);
     assert(!name.empty());
     assert(size_of_vertex_structure > 0);
+    assert(size_of_index_structure == sizeof(std::uint16_t) || size_of_index_structure == sizeof(std::uint32_t));
 
     std::size_t vertex_buffer_size = size_of_vertex_structure * number_of_vertices;
     std::size_t index_buffer_size = size_of_index_structure * number_of_indices;
@@ -70,7 +75,7 @@ MeshBuffer::MeshBuffer(const VkDevice device, VkQueue data_transfer_queue,
     : vertex_buffer(device, vma_allocator, name, size_of_vertex_structure * number_of_vertices,
                     VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_ONLY),
       index_buffer(std::nullopt), number_of_vertices(static_cast<std::uint32_t>(number_of_vertices)),
-      number_of_indices(static_cast<std::uint32_t>(number_of_indices)) {
+      size_of_vertex_structure(size_of_vertex_structure) {
     assert(device);
     assert(vma_allocator);
     assert(!name.empty());
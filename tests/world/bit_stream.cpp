@@ -0,0 +1,77 @@
+#include "inexor/vulkan-renderer/world/bit_stream.hpp"
+#include "inexor/vulkan-renderer/world/bit_stream_writer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace inexor::vulkan_renderer::world {
+TEST(BitStream, GetAcrossByteAndWordBoundaries) {
+    std::vector<unsigned char> data = {0b1010'1100, 0xFF, 0x00, 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0};
+    BitStream stream(data.data(), data.size());
+
+    EXPECT_EQ(stream.bits_left(), 88);
+    EXPECT_EQ(stream.get(3), 0b101);
+    EXPECT_EQ(stream.peek(7), 0b0110'011);
+    EXPECT_EQ(stream.get(7), 0b0110'011);
+    EXPECT_TRUE(stream.skip(6));
+    EXPECT_EQ(stream.get(8), 0x00);
+    EXPECT_EQ(stream.get(57), 0x123456789ABCDEull << 1 | 1);
+    EXPECT_EQ(stream.bits_left(), 7);
+    EXPECT_FALSE(stream.get(8));
+    EXPECT_EQ(stream.get(7), 0b111'0000);
+    EXPECT_EQ(stream.bits_left(), 0);
+    EXPECT_FALSE(stream.get(1));
+}
+
+TEST(BitStream, GetIndentations) {
+    // 24 levels: 0, 1, 8 repeating, followed by a single set bit.
+    // 0 -> 0, 1 -> 1000, 8 -> 1111
+    std::vector<unsigned char> data;
+    std::uint64_t bits = 0;
+    std::uint8_t bit_count = 0;
+    for (int i = 0; i < 8; i++) {
+        bits = bits << 9 | 0b0'1000'1111;
+        bit_count += 9;
+        while (bit_count >= 8) {
+            data.push_back(static_cast<unsigned char>(bits >> (bit_count - 8)));
+            bit_count -= 8;
+        }
+    }
+    data.push_back(static_cast<unsigned char>((bits << (8 - bit_count)) | (1 << (7 - bit_count))));
+
+    BitStream stream(data.data(), data.size());
+    const auto levels = stream.get_indentations();
+    ASSERT_TRUE(levels);
+    for (const auto &level : *levels) {
+        EXPECT_EQ(level, glm::tvec3<std::uint8_t>(0, 1, 8));
+    }
+    EXPECT_EQ(stream.get(1), 1);
+
+    BitStream truncated(data.data(), data.size() - 2);
+    EXPECT_FALSE(truncated.get_indentations());
+}
+
+TEST(BitStreamWriter, RoundTrip) {
+    BitStreamWriter writer;
+    for (std::uint8_t size = 1; size <= BitStreamWriter::MAX_BITS; size++) {
+        writer.put((std::uint64_t{1} << (size - 1)) | 1, size);
+    }
+    std::array<glm::tvec3<std::uint8_t>, 8> levels;
+    for (std::uint8_t i = 0; i < 8; i++) {
+        levels[i] = {i, static_cast<std::uint8_t>(8 - i), static_cast<std::uint8_t>(i % 2 * 8)};
+    }
+    writer.put_indentations(levels);
+    const std::size_t bits = writer.bits_written();
+    const std::vector<unsigned char> data = writer.finish();
+    EXPECT_EQ(data.size(), (bits + 7) / 8);
+
+    BitStream stream(data.data(), data.size());
+    EXPECT_EQ(stream.get(1), 1);
+    for (std::uint8_t size = 2; size <= BitStream::MAX_BITS; size++) {
+        EXPECT_EQ(stream.get(size), (std::uint64_t{1} << (size - 1)) | 1);
+    }
+    EXPECT_EQ(stream.get_indentations(), levels);
+    EXPECT_LT(stream.bits_left(), 8);
+}
+} // namespace inexor::vulkan_renderer::world
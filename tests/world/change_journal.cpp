@@ -0,0 +1,57 @@
+#include "inexor/vulkan-renderer/world/change_journal.hpp"
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "make_octree.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+namespace inexor::vulkan_renderer::world {
+TEST(ChangeJournal, RecordsOriginalCube) {
+    auto cube = test_octree();
+    cube->make_reactive();
+    std::vector<Cube *> changed;
+    cube->journal()->subscribe([&changed](const std::vector<Cube *> &cubes) { changed = cubes; });
+
+    // A cube is recorded once per batch.
+    auto &octant = cube->octants.value()[6];
+    octant->indentations.value()[4].set_z(4);
+    octant->indentations.value()[5].set_x(2);
+    EXPECT_TRUE(changed.empty());
+    cube->journal()->flush();
+    EXPECT_EQ(changed, std::vector<Cube *>{octant.get()});
+
+    octant->indentations.value()[4].set_z(5);
+    cube->journal()->flush();
+    EXPECT_EQ(changed, std::vector<Cube *>{octant.get()});
+}
+
+TEST(ChangeJournal, ForgetsDestroyedCube) {
+    auto cube = test_octree();
+    cube->make_reactive();
+    std::vector<Cube *> changed;
+    cube->journal()->subscribe([&changed](const std::vector<Cube *> &cubes) { changed = cubes; });
+
+    // Assigned cubes are attached to the journal, a removed cube which is still alive stays recorded.
+    auto octant = cube->octants.value()[1];
+    *octant = Cube(CubeType::FULL, 0.5f, octant->position());
+    std::array<Indentation, 8> indentations;
+    *octant = Cube(indentations, 0.5f, octant->position());
+    octant->indentations.value()[0].set_y(1);
+    *cube = Cube(CubeType::EMPTY, 1.0f, {0.0f, 0.0f, 0.0f});
+    cube->journal()->flush();
+    EXPECT_EQ(changed, (std::vector<Cube *>{octant.get(), cube.get()}));
+
+    // A recorded cube which is destroyed is removed from the batch.
+    std::array<std::shared_ptr<Cube>, 8> octants;
+    for (auto &child : octants) {
+        child = std::make_shared<Cube>(CubeType::FULL, 0.5f, glm::vec3(0.0f));
+    }
+    *cube = Cube(octants, 1.0f, {0.0f, 0.0f, 0.0f});
+    *cube->octants.value()[0] = Cube(CubeType::EMPTY, 0.5f, {0.0f, 0.0f, 0.0f});
+    *cube = Cube(CubeType::FULL, 1.0f, {0.0f, 0.0f, 0.0f});
+    cube->journal()->flush();
+    EXPECT_EQ(changed, std::vector<Cube *>{cube.get()});
+}
+} // namespace inexor::vulkan_renderer::world
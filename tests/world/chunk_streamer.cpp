@@ -0,0 +1,161 @@
+#include "inexor/vulkan-renderer/world/chunk_streamer.hpp"
+#include "inexor/vulkan-renderer/world/octree_generator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// Generate a small random octree for every chunk.
+std::vector<unsigned char> load(const glm::ivec3 &coordinate) {
+    GeneratorSettings settings;
+    settings.seed = static_cast<std::uint32_t>(coordinate.x * 31 + coordinate.y * 17 + coordinate.z);
+    settings.depth = 2;
+    return generate_octree_data(settings);
+}
+
+/// Update the chunk streamer until all requested chunks are loaded, the failed chunks are appended to failed if given.
+/// @return The coordinates of the chunks which have been evicted meanwhile.
+std::vector<glm::ivec3> settle(ChunkStreamer &streamer, const glm::vec3 &position, const glm::vec3 &velocity,
+                               std::vector<ChunkStreamer::Failure> *failed = nullptr) {
+    std::vector<glm::ivec3> evicted;
+    do {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        const auto update = streamer.update(position, velocity);
+        evicted.insert(evicted.end(), update.evicted.begin(), update.evicted.end());
+        if (failed != nullptr) {
+            failed->insert(failed->end(), update.failed.begin(), update.failed.end());
+        }
+    } while (streamer.pending_count() > 0);
+    return evicted;
+}
+} // namespace
+
+TEST(ChunkStreamer, LoadAroundCamera) {
+    ThreadPool thread_pool(2);
+    StreamingOptions options;
+    options.chunk_size = 2.0f;
+    options.load_radius = 2.5f;
+    options.max_pending = 4;
+    ChunkStreamer streamer(thread_pool, load, options);
+    EXPECT_EQ(streamer.loaded_count(), 0);
+
+    settle(streamer, glm::vec3(1.0f), glm::vec3(0.0f));
+    // The centers of the chunk of the camera and its 6 neighbours are within the radius, the other ones are not.
+    EXPECT_EQ(streamer.loaded_count(), 7);
+    EXPECT_EQ(streamer.chunk({2, 0, 0}), nullptr);
+    EXPECT_EQ(streamer.chunk({1, 1, 0}), nullptr);
+
+    const auto chunk = streamer.chunk({-1, 0, 0});
+    ASSERT_NE(chunk, nullptr);
+    EXPECT_EQ(chunk->coordinate, glm::ivec3(-1, 0, 0));
+    EXPECT_EQ(chunk->octree->size(), 2.0f);
+    EXPECT_EQ(chunk->octree->position(), glm::vec3(-2.0f, 0.0f, 0.0f));
+    EXPECT_EQ(chunk->octree->serialize(), load({-1, 0, 0}));
+    EXPECT_GT(chunk->memory_usage, 0);
+
+    std::size_t memory_usage = 0;
+    for (const glm::ivec3 &coordinate : {glm::ivec3(0), glm::ivec3(1, 0, 0), glm::ivec3(-1, 0, 0), glm::ivec3(0, 1, 0),
+                                         glm::ivec3(0, -1, 0), glm::ivec3(0, 0, 1), glm::ivec3(0, 0, -1)}) {
+        ASSERT_NE(streamer.chunk(coordinate), nullptr);
+        memory_usage += streamer.chunk(coordinate)->memory_usage;
+    }
+    EXPECT_EQ(streamer.memory_usage(), memory_usage);
+}
+
+TEST(ChunkStreamer, Prefetch) {
+    ThreadPool thread_pool(2);
+    StreamingOptions options;
+    options.load_radius = 0.5f;
+    options.prefetch_time = 2.0f;
+    ChunkStreamer streamer(thread_pool, load, options);
+
+    // The chunks along the path of the next two seconds are loaded as well.
+    settle(streamer, glm::vec3(0.5f), glm::vec3(1.5f, 0.0f, 0.0f));
+    EXPECT_EQ(streamer.loaded_count(), 4);
+    for (int x = 0; x < 4; x++) {
+        EXPECT_NE(streamer.chunk({x, 0, 0}), nullptr);
+    }
+    EXPECT_EQ(streamer.chunk({-1, 0, 0}), nullptr);
+}
+
+TEST(ChunkStreamer, Eviction) {
+    ThreadPool thread_pool(2);
+    StreamingOptions options;
+    options.load_radius = 0.5f;
+    options.memory_budget = 0;
+    ChunkStreamer streamer(thread_pool, load, options);
+
+    // Requested chunks are kept even above the budget.
+    settle(streamer, glm::vec3(0.5f), glm::vec3(0.0f));
+    EXPECT_EQ(streamer.loaded_count(), 1);
+    ASSERT_NE(streamer.chunk({0, 0, 0}), nullptr);
+
+    // The chunk which is not requested anymore is evicted.
+    const auto evicted = settle(streamer, glm::vec3(1.5f, 0.5f, 0.5f), glm::vec3(0.0f));
+    ASSERT_EQ(evicted.size(), 1);
+    EXPECT_EQ(evicted[0], glm::ivec3(0));
+    EXPECT_EQ(streamer.chunk({0, 0, 0}), nullptr);
+    EXPECT_NE(streamer.chunk({1, 0, 0}), nullptr);
+    EXPECT_EQ(streamer.memory_usage(), streamer.chunk({1, 0, 0})->memory_usage);
+
+    // With memory for two chunks, the least recently used chunk is evicted first.
+    const ChunkLoader same_octree = [](const glm::ivec3 &) { return load({1, 0, 0}); };
+    options.memory_budget = 2 * streamer.chunk({1, 0, 0})->memory_usage;
+    ChunkStreamer lru(thread_pool, same_octree, options);
+    settle(lru, glm::vec3(0.5f), glm::vec3(0.0f));
+    settle(lru, glm::vec3(1.5f, 0.5f, 0.5f), glm::vec3(0.0f));
+    settle(lru, glm::vec3(2.5f, 0.5f, 0.5f), glm::vec3(0.0f));
+    EXPECT_EQ(lru.chunk({0, 0, 0}), nullptr);
+    EXPECT_NE(lru.chunk({1, 0, 0}), nullptr);
+    EXPECT_NE(lru.chunk({2, 0, 0}), nullptr);
+    EXPECT_LE(lru.memory_usage(), options.memory_budget);
+}
+
+TEST(ChunkStreamer, Failure) {
+    ThreadPool thread_pool(2);
+    StreamingOptions options;
+    options.load_radius = 0.5f;
+    std::atomic<std::size_t> attempts = 0;
+    const ChunkLoader failing = [&](const glm::ivec3 &coordinate) {
+        attempts++;
+        if (coordinate.x == 0) {
+            throw std::runtime_error("Error: The chunk does not exist!");
+        }
+        // The data of the other chunks is truncated, which fails to parse.
+        return std::vector<unsigned char>{};
+    };
+    ChunkStreamer streamer(thread_pool, failing, options);
+
+    std::vector<ChunkStreamer::Failure> failed;
+    settle(streamer, glm::vec3(0.5f), glm::vec3(0.0f), &failed);
+    ASSERT_EQ(failed.size(), 1);
+    EXPECT_EQ(failed[0].coordinate, glm::ivec3(0));
+    EXPECT_EQ(failed[0].error, "Error: The chunk does not exist!");
+    EXPECT_EQ(streamer.loaded_count(), 0);
+
+    // The failed chunk is not requested again while the camera stays.
+    for (int i = 0; i < 3; i++) {
+        EXPECT_TRUE(streamer.update(glm::vec3(0.5f), glm::vec3(0.0f)).failed.empty());
+        EXPECT_EQ(streamer.pending_count(), 0);
+    }
+    EXPECT_EQ(attempts, 1);
+
+    failed.clear();
+    settle(streamer, glm::vec3(1.5f, 0.5f, 0.5f), glm::vec3(0.0f), &failed);
+    ASSERT_EQ(failed.size(), 1);
+    EXPECT_EQ(failed[0].coordinate, glm::ivec3(1, 0, 0));
+    EXPECT_EQ(failed[0].error, "Error: Octree data ended before the type of a cube was read!");
+
+    // The chunk is retried when the camera returns.
+    failed.clear();
+    settle(streamer, glm::vec3(0.5f), glm::vec3(0.0f), &failed);
+    ASSERT_EQ(failed.size(), 1);
+    EXPECT_EQ(failed[0].coordinate, glm::ivec3(0));
+    EXPECT_EQ(attempts, 3);
+}
+} // namespace inexor::vulkan_renderer::world
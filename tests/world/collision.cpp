@@ -0,0 +1,88 @@
+#include "inexor/vulkan-renderer/thread_pool.hpp"
+#include "inexor/vulkan-renderer/world/collision.hpp"
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "make_octree.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// Create an indented cube whose upper side is lowered to half of its height.
+Cube make_indented(float size = 1.0f, const glm::vec3 &position = {0.0f, 0.0f, 0.0f}) {
+    std::array<Indentation, 8> indentations;
+    for (std::size_t corner : {2, 3, 6, 7}) {
+        indentations[corner] = Indentation(0, MAX_INDENTATION / 2, 0);
+    }
+    return Cube(indentations, size, position);
+}
+
+constexpr auto E = CubeType::EMPTY;
+constexpr auto F = CubeType::FULL;
+} // namespace
+
+TEST(Collision, Sphere) {
+    Cube cube = *make_octree({F, E, E, E, F, E, E, E});
+    EXPECT_TRUE(collides(cube, Sphere{{0.25f, 0.25f, -0.1f}, 0.2f}));
+    EXPECT_FALSE(collides(cube, Sphere{{0.25f, 0.25f, -0.1f}, 0.05f}));
+    EXPECT_FALSE(collides(cube, Sphere{{0.25f, 0.75f, 0.25f}, 0.2f}));
+    // Touching counts as a collision.
+    EXPECT_TRUE(collides(cube, Sphere{{0.25f, 0.75f, 0.25f}, 0.25f}));
+
+    std::vector<Cube *> leaves;
+    overlaps(cube, Sphere{{0.5f, 0.25f, 0.25f}, 0.1f}, leaves);
+    EXPECT_EQ(leaves, (std::vector<Cube *>{cube.octants.value()[0].get(), cube.octants.value()[4].get()}));
+}
+
+TEST(Collision, Box) {
+    Cube cube = *make_octree({F, E, E, E, F, E, E, E});
+    EXPECT_FALSE(collides(cube, Box{{0.4f, 0.6f, 0.1f}, {0.6f, 0.9f, 0.2f}}));
+    EXPECT_TRUE(collides(cube, Box{{0.4f, 0.5f, 0.1f}, {0.6f, 0.9f, 0.2f}}));
+    EXPECT_TRUE(collides(cube, Box{{-1.0f, -1.0f, -1.0f}, {2.0f, 2.0f, 2.0f}}));
+    EXPECT_FALSE(collides(cube, Box{{1.1f, 0.0f, 0.0f}, {2.0f, 1.0f, 1.0f}}));
+}
+
+TEST(Collision, Capsule) {
+    Cube cube = *make_octree({F, E, E, E, E, E, E, E});
+    EXPECT_FALSE(collides(cube, Capsule{{-0.5f, 0.75f, 0.25f}, {1.5f, 0.75f, 0.25f}, 0.2f}));
+    EXPECT_TRUE(collides(cube, Capsule{{-0.5f, 0.75f, 0.25f}, {1.5f, 0.75f, 0.25f}, 0.25f}));
+
+    // The bounds of the capsule overlap the leaf, but its distance to the edge of the leaf is 0.6 / sqrt(2).
+    EXPECT_FALSE(collides(cube, Capsule{{1.0f, 0.6f, 0.25f}, {0.6f, 1.0f, 0.25f}, 0.42f}));
+    EXPECT_TRUE(collides(cube, Capsule{{1.0f, 0.6f, 0.25f}, {0.6f, 1.0f, 0.25f}, 0.43f}));
+
+    // A capsule which degenerates to a sphere.
+    EXPECT_TRUE(collides(cube, Capsule{{0.25f, 0.25f, 0.25f}, {0.25f, 0.25f, 0.25f}, 0.0f}));
+}
+
+TEST(Collision, IndentedLeaf) {
+    Cube cube = make_indented();
+    EXPECT_FALSE(collides(cube, Sphere{{0.5f, 0.7f, 0.5f}, 0.1f}));
+    EXPECT_TRUE(collides(cube, Sphere{{0.5f, 0.7f, 0.5f}, 0.25f}));
+    // Shapes completely within the leaf touch none of its polygons.
+    EXPECT_TRUE(collides(cube, Sphere{{0.5f, 0.25f, 0.5f}, 0.1f}));
+    EXPECT_TRUE(collides(cube, Box{{0.4f, 0.1f, 0.4f}, {0.6f, 0.2f, 0.6f}}));
+    EXPECT_FALSE(collides(cube, Box{{0.4f, 0.6f, 0.4f}, {0.6f, 0.9f, 0.6f}}));
+    EXPECT_FALSE(collides(cube, Capsule{{0.0f, 0.75f, 0.5f}, {1.0f, 0.75f, 0.5f}, 0.2f}));
+    EXPECT_TRUE(collides(cube, Capsule{{0.0f, 0.75f, 0.5f}, {1.0f, 0.75f, 0.5f}, 0.3f}));
+}
+
+TEST(Collision, Batched) {
+    Cube cube = *make_octree({F, E, E, E, F, E, E, F});
+    *cube.octants.value()[2] = make_indented(0.5f, {0.0f, 0.5f, 0.0f});
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> distribution(-0.2f, 1.2f);
+    std::vector<Sphere> spheres(1000);
+    for (auto &sphere : spheres) {
+        sphere = {{distribution(generator), distribution(generator), distribution(generator)}, 0.1f};
+    }
+    ThreadPool thread_pool;
+    const auto hits = collides(cube, spheres, thread_pool, 64);
+    ASSERT_EQ(hits.size(), spheres.size());
+    for (std::size_t i = 0; i < spheres.size(); i++) {
+        EXPECT_EQ(hits[i] != 0, collides(cube, spheres[i]));
+    }
+}
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,158 @@
+#include "inexor/vulkan-renderer/thread_pool.hpp"
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "make_octree.hpp"
+
+#include <gtest/gtest.h>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+constexpr auto E = CubeType::EMPTY;
+constexpr auto F = CubeType::FULL;
+} // namespace
+
+TEST(Cube, SerializeRoundTrip) {
+    std::vector<unsigned char> data = {0xC4, 0x52, 0x03, 0xC0, 0x00, 0x00};
+    Cube cube = Cube::parse(data);
+
+    std::vector<unsigned char> serialized = cube.serialize();
+    ASSERT_LE(serialized.size(), data.size());
+    EXPECT_TRUE(std::equal(serialized.begin(), serialized.end(), data.begin()));
+
+    Cube parsed = Cube::parse(serialized);
+    EXPECT_EQ(parsed.polygons(), cube.polygons());
+    EXPECT_EQ(parsed.serialize(), serialized);
+}
+
+TEST(Cube, SerializeEditedIndentations) {
+    std::vector<unsigned char> data = {0xC4, 0x52, 0x03, 0xC0, 0x00, 0x00};
+    Cube cube = Cube::parse(data);
+    cube.octants.value()[6]->indentations.value()[4] = Indentation(8, 1, 3);
+    cube.octants.value()[6]->indentations.value()[7] = Indentation(0, 5, 0);
+
+    std::vector<unsigned char> serialized = cube.serialize();
+    Cube parsed = Cube::parse(serialized);
+    EXPECT_TRUE(parsed.octants.value()[6]->indentations.value()[4].equal_values(Indentation(8, 1, 3)));
+    EXPECT_TRUE(parsed.octants.value()[6]->indentations.value()[7].equal_values(Indentation(0, 5, 0)));
+    EXPECT_EQ(parsed.serialize(), serialized);
+}
+
+TEST(Cube, ParseParallel) {
+    // Two levels of octants, the last octant of each level is indented.
+    BitStreamWriter writer;
+    writer.put(static_cast<std::uint8_t>(CubeType::OCTANT), 2);
+    for (std::uint8_t i = 0; i < 8; i++) {
+        writer.put(static_cast<std::uint8_t>(CubeType::OCTANT), 2);
+        for (std::uint8_t j = 0; j < 8; j++) {
+            writer.put(static_cast<std::uint8_t>((i + j) % 3), 2);
+            if ((i + j) % 3 == static_cast<std::uint8_t>(CubeType::INDENTED)) {
+                writer.put_indentations({{{i, j, 0}, {1, 2, 3}, {8, 8, 8}, {0, 0, 0}, {j, i, 1}, {}, {}, {4, 4, 4}}});
+            }
+        }
+    }
+    const std::vector<unsigned char> data = writer.finish();
+    std::vector<unsigned char> copy = data;
+    Cube sequential = Cube::parse(copy);
+
+    ThreadPool thread_pool;
+    for (std::uint32_t depth = 0; depth < 4; depth++) {
+        Cube parallel = Cube::parse(data, thread_pool, depth);
+        EXPECT_EQ(parallel.serialize(), sequential.serialize());
+        EXPECT_EQ(parallel.polygons(), sequential.polygons());
+    }
+
+    // Polygons generated in parallel are identical to the ones of the serial path.
+    for (std::uint32_t depth = 0; depth < 4; depth++) {
+        EXPECT_EQ(sequential.polygons(thread_pool, depth), sequential.polygons());
+    }
+
+    const auto index = SubtreeIndex::build(data.data(), data.size(), 1);
+    ASSERT_TRUE(index);
+    EXPECT_EQ(index->offsets().size(), 9);
+    EXPECT_FALSE(SubtreeIndex::build(data.data(), data.size() - 1, 1));
+
+    // Stored offsets are checked against the data, subtrees which are scheduled already finish before the error.
+    const std::vector<std::size_t> offsets(index->offsets().begin(), index->offsets().begin() + 5);
+    EXPECT_THROW(static_cast<void>(Cube::parse(data, thread_pool, SubtreeIndex(1, offsets))), std::runtime_error);
+    std::vector<std::size_t> outside = index->offsets();
+    outside.back() = data.size() * 8 + 64;
+    EXPECT_THROW(static_cast<void>(Cube::parse(data, thread_pool, SubtreeIndex(1, outside))), std::runtime_error);
+}
+
+TEST(Cube, AssignIndentationLevels) {
+    Indentation indentation;
+    indentation = glm::tvec3<std::uint8_t>(1, 2, 3);
+    EXPECT_EQ(indentation.vec(), glm::tvec3<std::uint8_t>(1, 2, 3));
+    indentation = glm::tvec3<std::uint8_t>(4, 5, 6);
+    EXPECT_EQ(indentation.vec(), glm::tvec3<std::uint8_t>(4, 5, 6));
+}
+
+TEST(Cube, AssignSameIndentationLevels) {
+    auto cube = test_octree();
+    cube->make_reactive();
+    // Assigning the current levels is not recorded as a change.
+    Indentation &indentation = cube->octants.value()[6]->indentations.value()[4];
+    const glm::tvec3<std::uint8_t> levels = indentation.vec();
+    indentation = levels;
+    EXPECT_TRUE(cube->journal()->empty());
+    EXPECT_EQ(indentation.vec(), levels);
+}
+
+TEST(Cube, Aggregates) {
+    auto cube = make_octree({F, E, E, E, E, E, E, F});
+    EXPECT_EQ(cube->leaves(), 2);
+    cube->make_reactive();
+    EXPECT_EQ(cube->leaves(), 2);
+    EXPECT_EQ(cube->triangles(), 24);
+    EXPECT_EQ(cube->bounds(), (std::array<glm::vec3, 2>{glm::vec3(0.0f), glm::vec3(1.0f)}));
+
+    // Edits update the cached aggregates of all ancestors.
+    Cube &last = *cube->octants.value()[7];
+    std::array<Indentation, 8> indentations;
+    for (std::size_t corner : {2, 3, 6, 7}) {
+        indentations[corner] = Indentation(0, MAX_INDENTATION / 2, 0);
+    }
+    last = Cube(indentations, 0.5f, last.position());
+    EXPECT_EQ(cube->bounds().value()[1], glm::vec3(1.0f, 0.75f, 1.0f));
+    for (std::size_t corner : {2, 3, 6, 7}) {
+        last.indentations.value()[corner].set_y(MAX_INDENTATION);
+    }
+    EXPECT_EQ(cube->bounds().value()[1], glm::vec3(1.0f, 0.5f, 1.0f));
+
+    *cube->octants.value()[0] = Cube(CubeType::EMPTY, 0.5f, glm::vec3(0.0f));
+    EXPECT_EQ(cube->leaves(), 1);
+    EXPECT_EQ(cube->bounds().value()[0], glm::vec3(0.5f));
+    last = Cube(CubeType::EMPTY, 0.5f, last.position());
+    EXPECT_EQ(cube->leaves(), 0);
+    EXPECT_FALSE(cube->bounds());
+
+    // Assigning a cube to another one of a reactive octree copies the subtree, so edits only change one of them.
+    for (const auto &octant : *cube->octants) {
+        std::array<std::shared_ptr<Cube>, 8> children;
+        for (std::size_t i = 0; i < children.size(); i++) {
+            children[i] = std::make_shared<Cube>(i == 0 ? CubeType::FULL : CubeType::EMPTY, 0.25f,
+                                                 octant->position() + glm::vec3((i & 4) ? 0.25f : 0.0f,
+                                                                                (i & 2) ? 0.25f : 0.0f,
+                                                                                (i & 1) ? 0.25f : 0.0f));
+        }
+        *octant = Cube(children, 0.5f, octant->position());
+    }
+    EXPECT_EQ(cube->leaves(), 8);
+    *cube->octants.value()[1] = *cube->octants.value()[0];
+    *cube->octants.value()[0]->octants.value()[1] = Cube(CubeType::FULL, 0.25f, glm::vec3(0.0f, 0.0f, 0.25f));
+    EXPECT_EQ(cube->leaves(), 9);
+    EXPECT_EQ(cube->polygons().size(), 9 * 12);
+    EXPECT_EQ(cube->octants.value()[0]->leaves(), 2);
+    EXPECT_EQ(cube->octants.value()[1]->leaves(), 1);
+
+    // Subtrees which are shared already when the octree becomes reactive change in all cubes which share them.
+    const auto shared = make_octree({E, E, E, E, E, E, E, E});
+    std::array<std::shared_ptr<Cube>, 8> octants;
+    octants.fill(shared);
+    auto copies = std::make_shared<Cube>(octants, 2.0f, glm::vec3(0.0f));
+    copies->make_reactive();
+    EXPECT_EQ(copies->leaves(), 0);
+    *shared->octants.value()[0] = Cube(CubeType::FULL, 0.5f, glm::vec3(0.0f));
+    EXPECT_EQ(copies->leaves(), 8);
+    EXPECT_EQ(shared->leaves(), 1);
+}
+} // namespace inexor::vulkan_renderer::world
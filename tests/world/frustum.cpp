@@ -0,0 +1,51 @@
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/frustum.hpp"
+#include "inexor/vulkan-renderer/world/incremental_mesh.hpp"
+#include "make_octree.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <gtest/gtest.h>
+
+#include <memory>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// Get the frustum of a camera at a position which looks along the negative z-axis.
+Frustum camera_frustum(const glm::vec3 &position, float fov) {
+    const glm::mat4 projection = glm::perspective(glm::radians(fov), 1.0f, 0.1f, 100.0f);
+    return Frustum(projection * glm::translate(glm::mat4(1.0f), -position));
+}
+
+constexpr auto E = CubeType::EMPTY;
+constexpr auto F = CubeType::FULL;
+} // namespace
+
+TEST(Frustum, Intersect) {
+    const Frustum frustum = camera_frustum({0.0f, 0.0f, 0.0f}, 90.0f);
+    EXPECT_EQ(frustum.intersect({-1.0f, -1.0f, -6.0f}, {1.0f, 1.0f, -4.0f}), Frustum::Intersection::INSIDE);
+    EXPECT_EQ(frustum.intersect({-1.0f, -1.0f, 4.0f}, {1.0f, 1.0f, 6.0f}), Frustum::Intersection::OUTSIDE);
+    EXPECT_EQ(frustum.intersect({10.0f, -1.0f, -6.0f}, {12.0f, 1.0f, -4.0f}), Frustum::Intersection::OUTSIDE);
+    EXPECT_EQ(frustum.intersect({-1.0f, -1.0f, -0.5f}, {1.0f, 1.0f, 0.5f}), Frustum::Intersection::INTERSECTING);
+    EXPECT_EQ(frustum.intersect({-1.0f, -1.0f, -200.0f}, {1.0f, 1.0f, -50.0f}), Frustum::Intersection::INTERSECTING);
+}
+
+TEST(Frustum, VisiblePolygons) {
+    auto cube = make_octree({F, E, E, E, F, E, E, E});
+    IncrementalMesh mesh(cube);
+    mesh.update();
+
+    // A narrow frustum only sees the leaf in octant 0.
+    const auto narrow = mesh.visible(camera_frustum({0.25f, 0.25f, 3.0f}, 5.0f));
+    ASSERT_EQ(narrow.size(), 1);
+    EXPECT_EQ(narrow[0].first, 0);
+    EXPECT_EQ(narrow[0].count, IncrementalMesh::SLOT_SIZE);
+
+    // The whole octree is visible as a single range.
+    const auto wide = mesh.visible(camera_frustum({0.5f, 0.5f, 3.0f}, 90.0f));
+    ASSERT_EQ(wide.size(), 1);
+    EXPECT_EQ(wide[0].first, 0);
+    EXPECT_EQ(wide[0].count, 2 * IncrementalMesh::SLOT_SIZE);
+
+    EXPECT_TRUE(mesh.visible(camera_frustum({0.5f, 0.5f, -3.0f}, 90.0f)).empty());
+}
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,112 @@
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/incremental_mesh.hpp"
+#include "make_octree.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+constexpr auto E = CubeType::EMPTY;
+constexpr auto F = CubeType::FULL;
+
+/// Get options which keep hidden faces, so that the slots match Cube::polygons.
+MeshOptions all_faces() {
+    MeshOptions options;
+    options.cull_hidden_faces = false;
+    return options;
+}
+} // namespace
+
+TEST(IncrementalMesh, IndentationEditPatchesOneSlot) {
+    auto cube = test_octree();
+    IncrementalMesh mesh(cube, std::nullopt, all_faces());
+    EXPECT_TRUE(mesh.update().rebuilt);
+    EXPECT_EQ(mesh.polygons(), cube->polygons());
+    EXPECT_FALSE(mesh.is_dirty());
+
+    cube->octants.value()[6]->indentations.value()[4].set_z(4);
+    cube->octants.value()[6]->indentations.value()[4] += {1, 1, -3};
+    const auto update = mesh.update();
+    EXPECT_FALSE(update.rebuilt);
+    ASSERT_EQ(update.ranges.size(), 1);
+    // Octant 6 is the fourth leaf.
+    EXPECT_EQ(update.ranges[0].first, 3 * IncrementalMesh::SLOT_SIZE);
+    EXPECT_EQ(update.ranges[0].count, IncrementalMesh::SLOT_SIZE);
+    EXPECT_EQ(mesh.polygons(), cube->polygons());
+}
+
+TEST(IncrementalMesh, NeighbouringSlotsAreMerged) {
+    auto cube = test_octree();
+    IncrementalMesh mesh(cube, std::nullopt, all_faces());
+    mesh.update();
+
+    // Octants 3 and 4 are the second and third leaf.
+    *cube->octants.value()[3] = Cube(CubeType::EMPTY, 0.5f, {0.0f, 0.5f, 0.5f});
+    *cube->octants.value()[4] = Cube(CubeType::EMPTY, 0.5f, {0.5f, 0.0f, 0.0f});
+    const auto update = mesh.update();
+    EXPECT_FALSE(update.rebuilt);
+    ASSERT_EQ(update.ranges.size(), 1);
+    EXPECT_EQ(update.ranges[0].first, IncrementalMesh::SLOT_SIZE);
+    EXPECT_EQ(update.ranges[0].count, 2 * IncrementalMesh::SLOT_SIZE);
+    // Empty leaves keep their slot with degenerated polygons.
+    EXPECT_EQ(mesh.polygons().size(), 4 * IncrementalMesh::SLOT_SIZE);
+    EXPECT_EQ(mesh.polygons()[IncrementalMesh::SLOT_SIZE], (std::array<glm::vec3, 3>{}));
+}
+
+TEST(IncrementalMesh, StructuralChangeRebuilds) {
+    auto cube = test_octree();
+    IncrementalMesh mesh(cube, std::nullopt, all_faces());
+    mesh.update();
+
+    // An empty cube does not own a slot.
+    *cube->octants.value()[0] = Cube(CubeType::FULL, 0.5f, {0.0f, 0.0f, 0.0f});
+    EXPECT_TRUE(mesh.update().rebuilt);
+    EXPECT_EQ(mesh.polygons(), cube->polygons());
+
+    // A leaf which is split into octants.
+    auto &leaf = cube->octants.value()[1];
+    std::array<std::shared_ptr<Cube>, 8> octants;
+    for (std::size_t i = 0; i < octants.size(); i++) {
+        octants[i] = std::make_shared<Cube>(i % 2 == 0 ? CubeType::FULL : CubeType::EMPTY, 0.25f,
+                                            leaf->position() + glm::vec3((i & 4) ? 0.25f : 0.0f,
+                                                                         (i & 2) ? 0.25f : 0.0f,
+                                                                         (i & 1) ? 0.25f : 0.0f));
+    }
+    *leaf = Cube(octants, leaf->size(), leaf->position());
+    EXPECT_TRUE(mesh.update().rebuilt);
+    EXPECT_EQ(mesh.polygons(), cube->polygons());
+
+    // The new octants are connected by the rebuild.
+    *leaf->octants.value()[2] = Cube(CubeType::EMPTY, 0.25f, leaf->octants.value()[2]->position());
+    EXPECT_FALSE(mesh.update().rebuilt);
+}
+
+TEST(IncrementalMesh, HiddenFacesFollowNeighbours) {
+    auto cube = make_octree({F, E, E, E, F, E, E, E});
+    IncrementalMesh mesh(cube);
+    mesh.update();
+    // The higher x side of octant 0 and the lower x side of octant 4 are hidden.
+    const auto full = cube->polygons();
+    ASSERT_EQ(mesh.polygons().size(), 2 * IncrementalMesh::SLOT_SIZE);
+    for (std::size_t i = 0; i < full.size(); i++) {
+        const bool hidden = i == 2 || i == 3 || i == IncrementalMesh::SLOT_SIZE || i == IncrementalMesh::SLOT_SIZE + 1;
+        const std::array<glm::vec3, 3> expected = hidden ? std::array<glm::vec3, 3>{} : full[i];
+        EXPECT_EQ(mesh.polygons()[i], expected);
+    }
+
+    // Emptying octant 4 uncovers the side of octant 0, whose slot is rewritten as well.
+    *cube->octants.value()[4] = Cube(CubeType::EMPTY, 0.5f, {0.5f, 0.0f, 0.0f});
+    const auto update = mesh.update();
+    EXPECT_FALSE(update.rebuilt);
+    ASSERT_EQ(update.ranges.size(), 1);
+    EXPECT_EQ(update.ranges[0].first, 0);
+    EXPECT_EQ(update.ranges[0].count, 2 * IncrementalMesh::SLOT_SIZE);
+    const auto remaining = cube->polygons();
+    ASSERT_EQ(remaining.size(), IncrementalMesh::SLOT_SIZE);
+    EXPECT_TRUE(std::equal(remaining.begin(), remaining.end(), mesh.polygons().begin()));
+}
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,100 @@
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/incremental_mesh.hpp"
+#include "inexor/vulkan-renderer/world/indexed_mesh.hpp"
+
+#include <glm/glm.hpp>
+#include <gtest/gtest.h>
+
+#include <memory>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// Expand an indexed mesh to polygons.
+std::vector<std::array<glm::vec3, 3>> expand(const IndexedMesh &mesh) {
+    std::vector<std::array<glm::vec3, 3>> polygons;
+    for (std::size_t i = 0; i < mesh.indices.size(); i += 3) {
+        polygons.push_back({mesh.vertices.at(mesh.indices[i]), mesh.vertices.at(mesh.indices[i + 1]),
+                            mesh.vertices.at(mesh.indices[i + 2])});
+    }
+    return polygons;
+}
+} // namespace
+
+TEST(IndexedMesh, FromPolygons) {
+    Cube full(CubeType::FULL, 1.0f, {0.0f, 0.0f, 0.0f});
+    const IndexedMesh cube_mesh = IndexedMesh::from_polygons(full.polygons());
+    EXPECT_EQ(cube_mesh.vertices.size(), 8);
+    EXPECT_EQ(cube_mesh.indices.size(), 36);
+    EXPECT_EQ(expand(cube_mesh), full.polygons());
+
+    std::vector<unsigned char> data = {0xC4, 0x52, 0x03, 0xC0, 0x00, 0x00};
+    Cube cube = Cube::parse(data);
+    const auto polygons = cube.polygons();
+    const IndexedMesh mesh = IndexedMesh::from_polygons(polygons);
+    EXPECT_EQ(expand(mesh), polygons);
+    // Neighbouring cubes share their corners.
+    EXPECT_LT(mesh.vertices.size(), cube.leaves() * 8);
+    ASSERT_TRUE(mesh.has_16_bit_indices());
+    const auto indices = mesh.indices_16_bit();
+    EXPECT_TRUE(std::equal(indices.begin(), indices.end(), mesh.indices.begin(), mesh.indices.end()));
+}
+
+TEST(IndexedMesh, IncrementalMeshSlots) {
+    std::vector<unsigned char> data = {0xC4, 0x52, 0x03, 0xC0, 0x00, 0x00};
+    auto cube = std::make_shared<Cube>(Cube::parse(data));
+    IncrementalMesh incremental_mesh(cube);
+    incremental_mesh.update();
+
+    const auto &polygons = incremental_mesh.polygons();
+    const IndexedMesh mesh = incremental_mesh.indexed({0, polygons.size()});
+    EXPECT_EQ(mesh.vertices.size(), cube->leaves() * IncrementalMesh::SLOT_VERTICES);
+    EXPECT_EQ(mesh.normals.size(), mesh.vertices.size());
+    EXPECT_EQ(mesh.materials.size(), mesh.vertices.size());
+    EXPECT_EQ(expand(mesh), polygons);
+
+    // The vertices of each face have the normal of the face.
+    for (std::size_t i = 0; i < mesh.indices.size(); i += 3) {
+        const glm::vec3 &a = mesh.vertices[mesh.indices[i]];
+        const glm::vec3 &b = mesh.vertices[mesh.indices[i + 1]];
+        const glm::vec3 &c = mesh.vertices[mesh.indices[i + 2]];
+        const glm::vec3 &normal = mesh.normals[mesh.indices[i]];
+        EXPECT_EQ(mesh.normals[mesh.indices[i + 1]], normal);
+        EXPECT_EQ(mesh.normals[mesh.indices[i + 2]], normal);
+        EXPECT_LE(glm::dot(glm::cross(b - a, c - a), normal), 0.0f);
+    }
+
+    // The indices of a single slot refer to the vertices of the whole mesh.
+    const IndexedMesh slot = incremental_mesh.indexed({IncrementalMesh::SLOT_SIZE, IncrementalMesh::SLOT_SIZE});
+    EXPECT_EQ(slot.vertices.size(), IncrementalMesh::SLOT_VERTICES);
+    EXPECT_TRUE(std::equal(slot.indices.begin(), slot.indices.end(),
+                           mesh.indices.begin() + IncrementalMesh::SLOT_SIZE * 3));
+}
+
+TEST(IndexedMesh, IncrementalMeshMaterials) {
+    std::vector<unsigned char> data = {0xC4, 0x52, 0x03, 0xC0, 0x00, 0x00};
+    auto cube = std::make_shared<Cube>(Cube::parse(data));
+    MeshOptions options;
+    options.material = [](Cube &leaf, std::size_t face) {
+        return static_cast<std::uint16_t>(leaf.type() == CubeType::INDENTED ? 100 + face : face);
+    };
+    IncrementalMesh incremental_mesh(cube, std::nullopt, options);
+    incremental_mesh.update();
+
+    const IndexedMesh mesh = incremental_mesh.indexed({0, incremental_mesh.polygons().size()});
+    for (std::size_t i = 0; i < mesh.vertices.size(); i++) {
+        const std::size_t face = i % IncrementalMesh::SLOT_VERTICES / IncrementalMesh::FACE_VERTICES;
+        EXPECT_EQ(mesh.materials[i] % 100, face);
+    }
+
+    // Octant 6 is the fourth leaf, which gets the materials of a full cube after the edit.
+    const IncrementalMesh::Range fourth_slot{3 * IncrementalMesh::SLOT_SIZE, IncrementalMesh::SLOT_SIZE};
+    EXPECT_EQ(incremental_mesh.indexed(fourth_slot).materials[0], 100);
+    *cube->octants.value()[6] = Cube(CubeType::FULL, 0.5f, {0.5f, 0.5f, 0.0f});
+    const auto update = incremental_mesh.update();
+    ASSERT_FALSE(update.rebuilt);
+    const IndexedMesh slot = incremental_mesh.indexed(fourth_slot);
+    for (std::size_t i = 0; i < slot.vertices.size(); i++) {
+        EXPECT_EQ(slot.materials[i], i / IncrementalMesh::FACE_VERTICES);
+    }
+}
+} // namespace inexor::vulkan_renderer::world
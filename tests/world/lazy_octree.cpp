@@ -0,0 +1,114 @@
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/lazy_octree.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+namespace inexor::vulkan_renderer::world {
+TEST(LazyOctree, SameGeometryAsCube) {
+    std::vector<unsigned char> data = {0xC4, 0x52, 0x03, 0xC0, 0x00, 0x00};
+    Cube cube = Cube::parse(data);
+    LazyOctree octree(data.data(), data.size());
+
+    EXPECT_EQ(octree.node_count(), 1);
+    EXPECT_EQ(octree.polygons(), cube.polygons());
+    EXPECT_EQ(octree.leaves(), cube.leaves());
+    EXPECT_EQ(octree.node_count(), 9);
+}
+
+TEST(LazyOctree, OnlyMaterializesAccessedRegions) {
+    // Two levels of octants filled with full cubes.
+    BitStreamWriter writer;
+    writer.put(static_cast<std::uint8_t>(CubeType::OCTANT), 2);
+    for (std::uint8_t i = 0; i < 8; i++) {
+        writer.put(static_cast<std::uint8_t>(CubeType::OCTANT), 2);
+        for (std::uint8_t j = 0; j < 8; j++) {
+            writer.put(static_cast<std::uint8_t>(CubeType::FULL), 2);
+        }
+    }
+    const std::vector<unsigned char> data = writer.finish();
+    LazyOctree octree(data.data(), data.size(), 4);
+
+    const auto leaf = octree.find({3.5f, 0.5f, 3.5f});
+    ASSERT_TRUE(leaf);
+    EXPECT_EQ(octree.type(*leaf), CubeType::FULL);
+    EXPECT_EQ(octree.node_count(), 17);
+    EXPECT_FALSE(octree.find({5.0f, 0.0f, 0.0f}));
+
+    EXPECT_EQ(octree.polygons({0.1f, 0.1f, 0.1f}, {0.9f, 0.9f, 0.9f}).size(), 12);
+    EXPECT_EQ(octree.node_count(), 25);
+}
+
+TEST(LazyOctree, IndexedChildren) {
+    // Two levels of octants, the children of the first level are the last ones in the data.
+    BitStreamWriter writer;
+    writer.put(static_cast<std::uint8_t>(CubeType::OCTANT), 2);
+    for (std::uint8_t i = 0; i < 8; i++) {
+        writer.put(static_cast<std::uint8_t>(CubeType::OCTANT), 2);
+        for (std::uint8_t j = 0; j < 8; j++) {
+            writer.put(static_cast<std::uint8_t>((i + j) % 2 == 0 ? CubeType::FULL : CubeType::EMPTY), 2);
+        }
+    }
+    const std::vector<unsigned char> data = writer.finish();
+    const auto index = SubtreeIndex::build(data.data(), data.size(), 1);
+    ASSERT_TRUE(index);
+
+    LazyOctree indexed(data.data(), data.size(), *index);
+    LazyOctree scanned(data.data(), data.size());
+    const auto leaf = indexed.find({0.9f, 0.9f, 0.9f});
+    ASSERT_TRUE(leaf);
+    EXPECT_EQ(leaf, scanned.find({0.9f, 0.9f, 0.9f}));
+    EXPECT_EQ(indexed.node_count(), 17);
+    EXPECT_EQ(indexed.polygons(), scanned.polygons());
+
+    // Offsets which do not match the data are rejected.
+    std::vector<std::size_t> offsets = index->offsets();
+    offsets.pop_back();
+    EXPECT_THROW(LazyOctree(data.data(), data.size(), SubtreeIndex(1, offsets)), std::runtime_error);
+    offsets = index->offsets();
+    std::swap(offsets[1], offsets[2]);
+    EXPECT_THROW(LazyOctree(data.data(), data.size(), SubtreeIndex(1, offsets)), std::runtime_error);
+    offsets = index->offsets();
+    offsets.back() = data.size() * 8 + 64;
+    EXPECT_THROW(LazyOctree(data.data(), data.size(), SubtreeIndex(1, offsets)), std::runtime_error);
+}
+
+TEST(LazyOctree, OpenMappedFile) {
+    std::vector<unsigned char> data = {0xC4, 0x52, 0x03, 0xC0, 0x00, 0x00};
+    const std::string file_name = (std::filesystem::temp_directory_path() / "lazy_octree_test.bin").string();
+    {
+        std::ofstream file(file_name, std::ios::binary);
+        file.write(reinterpret_cast<const char *>(data.data()), data.size());
+    }
+    auto octree = LazyOctree::open(file_name);
+    ASSERT_TRUE(octree);
+    EXPECT_EQ(octree->polygons(), Cube::parse(data).polygons());
+    octree.reset();
+
+    // An empty file does not contain an octree.
+    std::ofstream(file_name, std::ios::binary | std::ios::trunc).close();
+    EXPECT_FALSE(LazyOctree::open(file_name));
+    std::filesystem::remove(file_name);
+
+    EXPECT_FALSE(LazyOctree::open("does_not_exist.bin"));
+}
+
+TEST(LazyOctree, TruncatedData) {
+    // The root is split, but the data ends after three of its octants.
+    const std::vector<unsigned char> octants = {0xC4};
+    LazyOctree octree(octants.data(), octants.size());
+    EXPECT_THROW(static_cast<void>(octree.children(LazyOctree::root())), std::runtime_error);
+
+    // An indented root without its indentations.
+    const std::vector<unsigned char> indented = {0x80};
+    LazyOctree leaf(indented.data(), indented.size());
+    EXPECT_EQ(leaf.type(LazyOctree::root()), CubeType::INDENTED);
+    EXPECT_THROW(static_cast<void>(leaf.indentation_levels(LazyOctree::root())), std::runtime_error);
+
+    EXPECT_THROW(LazyOctree(octants.data(), 0), std::runtime_error);
+}
+} // namespace inexor::vulkan_renderer::world
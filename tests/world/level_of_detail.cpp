@@ -0,0 +1,103 @@
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/frustum.hpp"
+#include "inexor/vulkan-renderer/world/incremental_mesh.hpp"
+#include "inexor/vulkan-renderer/world/level_of_detail.hpp"
+#include "make_octree.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+constexpr auto E = CubeType::EMPTY;
+constexpr auto F = CubeType::FULL;
+} // namespace
+
+TEST(LevelOfDetail, SolidFraction) {
+    EXPECT_FLOAT_EQ(LevelOfDetail::solid_fraction(*make_octree({F, F, E, E, F, E, E, E})), 3.0f / 8.0f);
+    std::array<Indentation, 8> indentations;
+    indentations[0] = glm::tvec3<std::uint8_t>(MAX_INDENTATION, 0, 0);
+    Cube indented(indentations, 1.0f, {0.0f, 0.0f, 0.0f});
+    EXPECT_FLOAT_EQ(LevelOfDetail::solid_fraction(indented), 1.0f - 1.0f / 24.0f);
+}
+
+TEST(LevelOfDetail, Approximate) {
+    const LevelOfDetail lod;
+    EXPECT_EQ(lod.approximate(*make_octree({F, F, F, F, F, F, F, F})).type, CubeType::FULL);
+    EXPECT_EQ(lod.approximate(*make_octree({F, F, F, E, E, E, E, E})).type, CubeType::EMPTY);
+
+    // The corner of the empty octant is indented to the center of the cube.
+    const auto approximation = lod.approximate(*make_octree({F, F, F, F, F, F, F, E}));
+    EXPECT_EQ(approximation.type, CubeType::INDENTED);
+    EXPECT_EQ(approximation.levels[0], glm::tvec3<std::uint8_t>(0));
+    EXPECT_EQ(approximation.levels[7], glm::tvec3<std::uint8_t>(MAX_INDENTATION / 2));
+}
+
+TEST(LevelOfDetail, Hysteresis) {
+    auto cube = make_octree({F, E, E, E, E, E, E, F});
+    LevelOfDetail lod({16.0f, 0.1f, 0.5f});
+    // The octree collapses beyond a distance of 17.6 and expands within 14.4.
+    EXPECT_FALSE(lod.update(*cube, {18.0f, 0.5f, 0.5f}));
+    EXPECT_FALSE(lod.is_collapsed(cube.get()));
+    EXPECT_TRUE(lod.update(*cube, {19.0f, 0.5f, 0.5f}));
+    EXPECT_TRUE(lod.is_collapsed(cube.get()));
+    EXPECT_FALSE(lod.update(*cube, {16.0f, 0.5f, 0.5f}));
+    EXPECT_TRUE(lod.is_collapsed(cube.get()));
+    EXPECT_TRUE(lod.update(*cube, {15.0f, 0.5f, 0.5f}));
+    EXPECT_FALSE(lod.is_collapsed(cube.get()));
+    EXPECT_EQ(lod.collapsed_count(), 0);
+}
+
+TEST(LevelOfDetail, IncrementalMesh) {
+    auto cube = make_octree({F, F, F, F, F, F, E, F});
+    // Hidden faces are kept, so that the slots of the leaves can be compared with Cube::polygons.
+    MeshOptions options;
+    options.cull_hidden_faces = false;
+    IncrementalMesh mesh(cube, LodOptions{}, options);
+    mesh.update();
+    EXPECT_EQ(mesh.polygons().size(), 7 * IncrementalMesh::SLOT_SIZE);
+    const Frustum everything(glm::ortho(-2.0f, 2.0f, -2.0f, 2.0f, -2.0f, 2.0f));
+
+    // Collapsing keeps the slots of the leaves, only the first one is drawn.
+    EXPECT_TRUE(mesh.update_level_of_detail({100.0f, 0.0f, 0.0f}));
+    auto update = mesh.update();
+    EXPECT_FALSE(update.rebuilt);
+    ASSERT_EQ(update.ranges.size(), 1);
+    EXPECT_EQ(update.ranges[0].count, 7 * IncrementalMesh::SLOT_SIZE);
+    EXPECT_EQ(mesh.polygons().size(), 7 * IncrementalMesh::SLOT_SIZE);
+    LevelOfDetail lod;
+    lod.update(*cube, {100.0f, 0.0f, 0.0f});
+    const auto approximation = lod.polygons(*cube);
+    EXPECT_TRUE(std::equal(approximation.begin(), approximation.end(), mesh.polygons().begin()));
+    EXPECT_EQ(mesh.polygons().back(), (std::array<glm::vec3, 3>{}));
+    auto visible = mesh.visible(everything);
+    ASSERT_EQ(visible.size(), 1);
+    EXPECT_EQ(visible[0].first, 0);
+    EXPECT_EQ(visible[0].count, IncrementalMesh::SLOT_SIZE);
+
+    // A change within a collapsed subtree regenerates its approximation.
+    *cube->octants.value()[0] = Cube(CubeType::EMPTY, 0.5f, {0.0f, 0.0f, 0.0f});
+    update = mesh.update();
+    EXPECT_FALSE(update.rebuilt);
+    lod.update(*cube, {100.0f, 0.0f, 0.0f});
+    const auto changed = lod.polygons(*cube);
+    EXPECT_NE(changed, approximation);
+    EXPECT_TRUE(std::equal(changed.begin(), changed.end(), mesh.polygons().begin()));
+    EXPECT_FALSE(mesh.update_level_of_detail({100.0f, 0.0f, 0.0f}));
+
+    // Expanding restores the leaves.
+    EXPECT_TRUE(mesh.update_level_of_detail({0.5f, 0.5f, 0.5f}));
+    update = mesh.update();
+    EXPECT_FALSE(update.rebuilt);
+    // The leaf which became empty keeps its slot.
+    const auto polygons = cube->polygons();
+    EXPECT_EQ(mesh.polygons().front(), (std::array<glm::vec3, 3>{}));
+    EXPECT_TRUE(std::equal(polygons.begin(), polygons.end(), mesh.polygons().begin() + IncrementalMesh::SLOT_SIZE));
+    visible = mesh.visible(everything);
+    ASSERT_EQ(visible.size(), 1);
+    EXPECT_EQ(visible[0].count, 7 * IncrementalMesh::SLOT_SIZE);
+}
+} // namespace inexor::vulkan_renderer::world
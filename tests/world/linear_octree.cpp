@@ -0,0 +1,75 @@
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/linear_octree.hpp"
+#include "make_octree.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+constexpr auto F = CubeType::FULL;
+constexpr auto O = CubeType::OCTANT;
+} // namespace
+
+TEST(LinearOctree, Keys) {
+    // x = 0b11, y = 0b00, z = 0b10: octant 0b101 on the first and 0b100 on the second level.
+    const LinearOctree::Key key = LinearOctree::encode(2, {3, 0, 2});
+    EXPECT_EQ(key, LinearOctree::child(LinearOctree::child(1, 5), 4));
+    EXPECT_EQ(LinearOctree::depth(key), 2);
+    EXPECT_EQ(LinearOctree::parent(key), LinearOctree::child(1, 5));
+    EXPECT_EQ(LinearOctree::decode(key), (std::array<std::uint32_t, 3>{3, 0, 2}));
+    const LinearOctree::Key deep = LinearOctree::encode(LinearOctree::MAX_DEPTH, {0x1FFFFF, 12345, 0x100000});
+    EXPECT_EQ(LinearOctree::decode(deep), (std::array<std::uint32_t, 3>{0x1FFFFF, 12345, 0x100000}));
+}
+
+TEST(LinearOctree, LocateLikeDescent) {
+    std::vector<unsigned char> data = {0xC4, 0x52, 0x03, 0xC0, 0x00, 0x00};
+    auto cube = std::make_shared<Cube>(Cube::parse(data));
+    const LinearOctree octree(cube);
+    EXPECT_EQ(octree.size(), 9);
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    for (std::size_t i = 0; i < 100; i++) {
+        const glm::vec3 point = {distribution(generator), distribution(generator), distribution(generator)};
+        EXPECT_EQ(octree.find(point), cube->find(point));
+    }
+    EXPECT_EQ(octree.find(glm::vec3(1.0f, 1.0f, 1.0f)), cube->octants.value()[7].get());
+    EXPECT_EQ(octree.find(glm::vec3(1.5f, 0.0f, 0.0f)), nullptr);
+}
+
+TEST(LinearOctree, Neighbour) {
+    auto cube = make_octree({O, F, F, F, F, F, F, F});
+    const LinearOctree octree(cube);
+    // The higher x neighbour of the octant 4 of octant 0 is the larger leaf in octant 4.
+    EXPECT_EQ(octree.neighbour(LinearOctree::child(LinearOctree::child(1, 0), 4), 1), LinearOctree::child(1, 4));
+    // The lower x neighbour of octant 4 is octant 0, which has octants.
+    EXPECT_EQ(octree.neighbour(LinearOctree::child(1, 4), 0), LinearOctree::child(1, 0));
+    EXPECT_EQ(octree.neighbour(LinearOctree::child(LinearOctree::child(1, 0), 4), 0),
+              LinearOctree::child(LinearOctree::child(1, 0), 0));
+    EXPECT_FALSE(octree.neighbour(LinearOctree::child(1, 0), 0));
+    EXPECT_FALSE(octree.neighbour(LinearOctree::child(1, 7), 5));
+}
+
+TEST(LinearOctree, KeptInSyncOnFlush) {
+    auto cube = make_octree({F, F, F, F, F, F, F, F});
+    const LinearOctree octree(cube);
+    EXPECT_EQ(octree.size(), 9);
+
+    // Split octant 7 into full cubes.
+    *cube->octants.value()[7] = *make_octree({F, F, F, F, F, F, F, O})->octants.value()[7];
+    EXPECT_EQ(octree.size(), 9);
+    cube->journal()->flush();
+    EXPECT_EQ(octree.size(), 17);
+    const glm::vec3 point = {0.9f, 0.9f, 0.9f};
+    EXPECT_EQ(octree.find(point), cube->find(point));
+    EXPECT_EQ(octree.key(cube->find(point)), LinearOctree::child(LinearOctree::child(1, 7), 7));
+
+    // Merge it back into a leaf.
+    *cube->octants.value()[7] = Cube(CubeType::EMPTY, 0.5f, {0.5f, 0.5f, 0.5f});
+    cube->journal()->flush();
+    EXPECT_EQ(octree.size(), 9);
+    EXPECT_EQ(octree.find(point), cube->octants.value()[7].get());
+}
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/world/cube.hpp"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace inexor::vulkan_renderer::world {
+/// Create an octree of size 1 whose octants have the given types, octants of CubeType::OCTANT are filled with full
+/// cubes.
+/// @param types The type of each octant.
+/// @return The octree.
+inline std::shared_ptr<Cube> make_octree(const std::array<CubeType, 8> &types) {
+    std::array<std::shared_ptr<Cube>, 8> octants;
+    for (std::size_t i = 0; i < octants.size(); i++) {
+        const glm::vec3 position((i & 4) ? 0.5f : 0.0f, (i & 2) ? 0.5f : 0.0f, (i & 1) ? 0.5f : 0.0f);
+        if (types[i] != CubeType::OCTANT) {
+            octants[i] = std::make_shared<Cube>(types[i], 0.5f, position);
+            continue;
+        }
+        std::array<std::shared_ptr<Cube>, 8> children;
+        for (std::size_t j = 0; j < children.size(); j++) {
+            children[j] = std::make_shared<Cube>(
+                CubeType::FULL, 0.25f,
+                position + glm::vec3((j & 4) ? 0.25f : 0.0f, (j & 2) ? 0.25f : 0.0f, (j & 1) ? 0.25f : 0.0f));
+        }
+        octants[i] = std::make_shared<Cube>(children, 0.5f, position);
+    }
+    return std::make_shared<Cube>(octants, 1.0f, glm::vec3(0.0f, 0.0f, 0.0f));
+}
+
+/// Parse a small octree with empty, full and indented octants (octant 6 is indented).
+/// @return The octree.
+inline std::shared_ptr<Cube> test_octree() {
+    std::vector<unsigned char> data = {0xC4, 0x52, 0x03, 0xC0, 0x00, 0x00};
+    return std::make_shared<Cube>(Cube::parse(data));
+}
+} // namespace inexor::vulkan_renderer::world
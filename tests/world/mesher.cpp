@@ -0,0 +1,191 @@
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/mesher.hpp"
+#include "make_octree.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// Get the normals (not normalized, so their length is twice the area) of polygons.
+std::vector<glm::vec3> normals(const std::vector<std::array<glm::vec3, 3>> &polygons) {
+    std::vector<glm::vec3> normals;
+    for (const auto &polygon : polygons) {
+        normals.push_back(glm::cross(polygon[1] - polygon[0], polygon[2] - polygon[0]));
+    }
+    return normals;
+}
+
+/// Get the sum of the normals of polygons which point into a direction.
+glm::vec3 sum(const std::vector<glm::vec3> &normals, const glm::vec3 &direction) {
+    glm::vec3 sum(0.0f);
+    for (const auto &normal : normals) {
+        if (glm::dot(normal, direction) > 0) {
+            sum += normal;
+        }
+    }
+    return sum;
+}
+} // namespace
+
+TEST(Mesher, WithoutCullingSameAsCube) {
+    std::vector<unsigned char> data = {0xC4, 0x52, 0x03, 0xC0, 0x00, 0x00};
+    Cube cube = Cube::parse(data);
+    MeshOptions options;
+    options.cull_hidden_faces = false;
+    Mesher mesher(options);
+    const auto polygons = mesher.polygons(cube);
+    EXPECT_EQ(polygons.size(), cube.polygons().size());
+    EXPECT_EQ(mesher.statistics().hidden_triangles, 0);
+}
+
+TEST(Mesher, AdjacentFullCubes) {
+    constexpr auto E = CubeType::EMPTY;
+    constexpr auto F = CubeType::FULL;
+    // Octant 0 and 4 share the face at x = 0.5.
+    Cube cube = *make_octree({F, E, E, E, F, E, E, E});
+    Mesher mesher;
+    EXPECT_EQ(mesher.polygons(cube).size(), 20);
+    EXPECT_EQ(mesher.statistics().leaves, 2);
+    EXPECT_EQ(mesher.statistics().hidden_triangles, 4);
+
+    // Only the outer surface of a solid cube remains.
+    Cube solid = *make_octree({F, F, F, F, F, F, F, F});
+    EXPECT_EQ(mesher.polygons(solid).size(), 6 * 4 * 2);
+}
+
+TEST(Mesher, AcrossLevels) {
+    constexpr auto E = CubeType::EMPTY;
+    constexpr auto F = CubeType::FULL;
+    constexpr auto O = CubeType::OCTANT;
+    // Octant 4 is a solid block of 8 full cubes.
+    Cube cube = *make_octree({F, E, E, E, O, E, E, E});
+
+    Mesher mesher;
+    const auto polygons = mesher.polygons(cube);
+    // The larger cube and the 4 smaller cubes next to it hide each other, the smaller cubes hide 12 pairs of faces.
+    EXPECT_EQ(mesher.statistics().hidden_triangles, 2 + 4 * 2 + 12 * 2 * 2);
+    EXPECT_EQ(polygons.size(), 12 + 8 * 12 - mesher.statistics().hidden_triangles);
+}
+
+TEST(Mesher, IndentedFaces) {
+    constexpr auto E = CubeType::EMPTY;
+    constexpr auto F = CubeType::FULL;
+    Cube cube = *make_octree({F, E, E, E, F, E, E, E});
+    std::array<Indentation, 8> indentations;
+    // Corner 4 lies on the face which touches octant 4.
+    indentations[4] = Indentation(0, 1, 0);
+    *(*cube.octants)[0] = Cube(indentations, 0.5f, {0.0f, 0.0f, 0.0f});
+
+    Mesher mesher;
+    // The indented face is still hidden by the full cube, but does not hide the face of the full cube.
+    static_cast<void>(mesher.polygons(cube));
+    EXPECT_EQ(mesher.statistics().hidden_triangles, 2);
+
+    // The face is indented into the cube and not hidden anymore.
+    indentations[4] = Indentation(1, 0, 0);
+    *(*cube.octants)[0] = Cube(indentations, 0.5f, {0.0f, 0.0f, 0.0f});
+    static_cast<void>(mesher.polygons(cube));
+    EXPECT_EQ(mesher.statistics().hidden_triangles, 0);
+}
+
+TEST(Mesher, MergeFaces) {
+    constexpr auto E = CubeType::EMPTY;
+    constexpr auto F = CubeType::FULL;
+    // A floor of 2 x 2 cubes.
+    Cube cube = *make_octree({F, F, E, E, F, F, E, E});
+    Mesher mesher;
+    const auto polygons = mesher.polygons(cube);
+    EXPECT_EQ(polygons.size(), 32);
+
+    MeshOptions options;
+    options.merge_faces = true;
+    Mesher merging_mesher(options);
+    const auto merged_polygons = merging_mesher.polygons(cube);
+    // Every side of the floor is one rectangle.
+    EXPECT_EQ(merged_polygons.size(), 12);
+    EXPECT_EQ(merging_mesher.statistics().merged_triangles, 20);
+
+    // The rectangles cover the same area with the same winding order.
+    const auto expected = normals(polygons);
+    const auto actual = normals(merged_polygons);
+    for (const glm::vec3 direction : {glm::vec3(1, 0, 0), glm::vec3(-1, 0, 0), glm::vec3(0, 1, 0),
+                                      glm::vec3(0, -1, 0), glm::vec3(0, 0, 1), glm::vec3(0, 0, -1)}) {
+        EXPECT_EQ(sum(actual, direction), sum(expected, direction));
+    }
+}
+
+TEST(Mesher, MergeOnlyFullFaces) {
+    constexpr auto E = CubeType::EMPTY;
+    constexpr auto F = CubeType::FULL;
+    Cube cube = *make_octree({F, F, E, E, F, F, E, E});
+    std::array<Indentation, 8> indentations;
+    // Corner 3 (lower x, higher y, higher z) is indented, the upper side and the sides at lower x and higher z are not
+    // complete squares anymore.
+    indentations[3] = Indentation(0, 1, 0);
+    *(*cube.octants)[1] = Cube(indentations, 0.5f, {0.0f, 0.0f, 0.5f});
+
+    MeshOptions options;
+    options.merge_faces = true;
+    Mesher mesher(options);
+    const auto polygons = mesher.polygons(cube);
+    // Bottom, higher x and lower z: 1 rectangle each, lower x and higher z: 1 rectangle and 1 face each, top: the
+    // remaining L-shape is split into 2 rectangles and 1 face.
+    EXPECT_EQ(polygons.size(), 2 * (1 + 1 + 1 + 2 + 2 + 3));
+}
+
+TEST(Mesher, FaceAttributes) {
+    constexpr auto E = CubeType::EMPTY;
+    constexpr auto F = CubeType::FULL;
+    Cube cube = *make_octree({F, F, E, E, F, F, E, E});
+    std::array<Indentation, 8> indentations;
+    indentations[3] = Indentation(0, 1, 0);
+    *(*cube.octants)[1] = Cube(indentations, 0.5f, {0.0f, 0.0f, 0.5f});
+
+    MeshOptions options;
+    options.material = [](Cube &leaf, std::size_t face) {
+        return static_cast<std::uint16_t>(leaf.type() == CubeType::INDENTED ? 10 + face : face);
+    };
+    Mesher mesher(options);
+    const auto polygons = mesher.polygons(cube);
+    const auto vertices = mesher.vertices(cube);
+    ASSERT_EQ(vertices.size(), polygons.size());
+    for (std::size_t i = 0; i < vertices.size(); i++) {
+        // Both polygons of a face have the normal of the face, which points away from the polygons.
+        const glm::vec3 &normal = vertices[i][0].normal;
+        EXPECT_NEAR(glm::length(normal), 1.0f, 1e-6f);
+        EXPECT_LT(glm::dot(normals({polygons[i]})[0], normal), 0.0f);
+        for (std::size_t j = 0; j < 3; j++) {
+            EXPECT_EQ(vertices[i][j].position, polygons[i][j]);
+            EXPECT_EQ(vertices[i][j].normal, normal);
+            EXPECT_EQ(vertices[i][j].material, vertices[i][0].material);
+            EXPECT_EQ(vertices[i][j].texture_coordinate, Mesher::texture_coordinate(polygons[i][j], normal));
+        }
+        EXPECT_EQ(vertices[i][0].normal, vertices[i ^ 1][0].normal);
+    }
+
+    // The upper side of the floor has the normal (0, 1, 0) and the material of the upper side, apart from the
+    // indented leaf.
+    std::size_t upper_sides = 0;
+    for (const auto &polygon : vertices) {
+        if (polygon[0].normal == glm::vec3(0.0f, 1.0f, 0.0f)) {
+            EXPECT_EQ(polygon[0].material, 3);
+            EXPECT_EQ(polygon[0].texture_coordinate, glm::vec2(polygon[0].position.x, polygon[0].position.z));
+            upper_sides++;
+        }
+    }
+    EXPECT_EQ(upper_sides, 3 * 2);
+
+    // Faces of different materials are not merged.
+    options.merge_faces = true;
+    options.material = [](Cube &leaf, std::size_t /*face*/) {
+        return static_cast<std::uint16_t>(leaf.position().x > 0.0f ? 1 : 0);
+    };
+    Cube floor = *make_octree({F, F, E, E, F, F, E, E});
+    Mesher merging_mesher(options);
+    const auto merged = merging_mesher.vertices(floor);
+    // The sides at lower and higher x are one rectangle each, the other 4 sides are split into 2 rectangles.
+    EXPECT_EQ(merged.size(), 2 * (2 + 4 * 2));
+}
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,163 @@
+#include "inexor/vulkan-renderer/world/change_journal.hpp"
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/octree_delta.hpp"
+#include "inexor/vulkan-renderer/world/octree_generator.hpp"
+#include "inexor/vulkan-renderer/world/octree_history.hpp"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// Get the cube at a path of an octree.
+Cube &at(Cube &root, const std::vector<std::size_t> &path) {
+    Cube *cube = &root;
+    for (const std::size_t octant : path) {
+        cube = cube->octants.value()[octant].get();
+    }
+    return *cube;
+}
+
+/// Create a delta which indents the corners of a cube.
+OctreeDelta indent(const std::vector<std::size_t> &path) {
+    OctreeDelta delta;
+    delta.path = path;
+    delta.type = CubeType::INDENTED;
+    delta.levels[0] = {1, 0, 8};
+    delta.levels[7] = {2, 3, 4};
+    return delta;
+}
+
+/// Create a delta which splits a cube into octants.
+OctreeDelta split(const std::vector<std::size_t> &path, CubeType octant_type) {
+    OctreeDelta delta;
+    delta.path = path;
+    delta.type = CubeType::OCTANT;
+    delta.octant_type = octant_type;
+    return delta;
+}
+
+/// Create a delta which replaces a cube by a leaf of a type.
+OctreeDelta leaf(const std::vector<std::size_t> &path, CubeType type) {
+    OctreeDelta delta;
+    delta.path = path;
+    delta.type = type;
+    return delta;
+}
+
+/// Generate an octree which is subdivided down to depth 3 everywhere.
+std::vector<unsigned char> generate() {
+    GeneratorSettings settings;
+    settings.seed = 7;
+    settings.depth = 3;
+    return generate_octree_data(settings);
+}
+} // namespace
+
+TEST(OctreeDelta, Encoding) {
+    const std::vector<OctreeDelta> deltas{leaf({}, CubeType::EMPTY), leaf({1, 2}, CubeType::FULL), indent({7, 0, 3}),
+                                          split({4}, CubeType::FULL), split({5, 5}, CubeType::EMPTY)};
+    const auto data = encode_deltas(deltas);
+    const auto decoded = decode_deltas(data);
+    ASSERT_EQ(decoded.size(), deltas.size());
+    for (std::size_t i = 0; i < deltas.size(); i++) {
+        EXPECT_EQ(decoded[i].path, deltas[i].path);
+        EXPECT_EQ(decoded[i].type, deltas[i].type);
+    }
+    EXPECT_EQ(decoded[2].levels, deltas[2].levels);
+    EXPECT_EQ(decoded[3].octant_type, CubeType::FULL);
+    EXPECT_EQ(decoded[4].octant_type, CubeType::EMPTY);
+
+    // The count (32 bits), the depth (5 bits), two octants (6 bits) and the type (2 bits).
+    EXPECT_EQ(encode_deltas({leaf({1, 2}, CubeType::FULL)}).size(), 6);
+
+    auto truncated = data;
+    truncated.pop_back();
+    EXPECT_THROW(static_cast<void>(decode_deltas(truncated)), std::runtime_error);
+    EXPECT_THROW(static_cast<void>(encode_deltas({leaf({8}, CubeType::FULL)})), std::runtime_error);
+    EXPECT_THROW(static_cast<void>(encode_deltas({leaf(std::vector<std::size_t>(MAX_DELTA_DEPTH + 1, 0),
+                                                       CubeType::FULL)})),
+                 std::runtime_error);
+}
+
+TEST(OctreeDelta, DiffAndApply) {
+    auto data = generate();
+    Cube octree = Cube::parse(data);
+    OctreeHistory history(octree);
+    const auto before = history.snapshot();
+
+    for (const auto &delta : {indent({3, 5}), split({6, 1, 2}, CubeType::FULL), leaf({0}, CubeType::FULL)}) {
+        const Cube &cube = at(*history.snapshot(), delta.path);
+        Cube replacement = delta.cube(cube.size(), cube.position());
+        history.assign(delta.path, replacement);
+    }
+    const auto after = history.snapshot();
+
+    // The shared subtrees are skipped, the deltas reproduce the edits.
+    const auto deltas = diff_octrees(before, after);
+    ASSERT_EQ(deltas.size(), 3);
+    EXPECT_EQ(deltas[0].path, (std::vector<std::size_t>{0}));
+    EXPECT_EQ(deltas[1].path, (std::vector<std::size_t>{3, 5}));
+    EXPECT_EQ(deltas[2].path, (std::vector<std::size_t>{6, 1, 2}));
+
+    Cube copy = Cube::parse(data);
+    apply_deltas(copy, decode_deltas(encode_deltas(deltas)));
+    EXPECT_EQ(copy.serialize(), after->serialize());
+
+    // Octrees which share nothing are compared completely, subtrees are recreated with the deltas of their leaves.
+    auto other_data = generate();
+    const auto other = std::make_shared<Cube>(Cube::parse(other_data));
+    EXPECT_TRUE(diff_octrees(std::make_shared<Cube>(Cube::parse(data)), other).empty());
+    const auto empty = std::make_shared<Cube>(CubeType::EMPTY, DEFAULT_CUBE_SIZE, DEFAULT_CUBE_POSITION);
+    Cube rebuilt(CubeType::EMPTY, DEFAULT_CUBE_SIZE, DEFAULT_CUBE_POSITION);
+    apply_deltas(rebuilt, diff_octrees(empty, other));
+    EXPECT_EQ(rebuilt.serialize(), data);
+}
+
+TEST(OctreeDelta, Compaction) {
+    const std::vector<OctreeDelta> deltas{indent({2}),
+                                          split({2}, CubeType::FULL),
+                                          leaf({2, 5}, CubeType::EMPTY),
+                                          leaf({4, 1}, CubeType::FULL),
+                                          split({2}, CubeType::EMPTY),
+                                          indent({2, 3})};
+    const auto compacted = compact_deltas(deltas);
+    ASSERT_EQ(compacted.size(), 3);
+    EXPECT_EQ(compacted[0].path, (std::vector<std::size_t>{4, 1}));
+    EXPECT_EQ(compacted[1].path, (std::vector<std::size_t>{2}));
+    EXPECT_EQ(compacted[1].octant_type, CubeType::EMPTY);
+    EXPECT_EQ(compacted[2].path, (std::vector<std::size_t>{2, 3}));
+
+    auto data = generate();
+    Cube all = Cube::parse(data);
+    apply_deltas(all, deltas);
+    Cube compact = Cube::parse(data);
+    apply_deltas(compact, compacted);
+    EXPECT_EQ(compact.serialize(), all.serialize());
+
+    // A delta of the root replaces everything before.
+    EXPECT_EQ(compact_deltas({indent({1, 2}), leaf({}, CubeType::FULL)}).size(), 1);
+}
+
+TEST(OctreeDelta, BatchedApply) {
+    auto data = generate();
+    Cube octree = Cube::parse(data);
+    octree.make_reactive();
+    std::size_t batches = 0;
+    std::size_t changes = 0;
+    octree.journal()->subscribe([&](const std::vector<Cube *> &cubes) {
+        batches++;
+        changes += cubes.size();
+    });
+
+    apply_deltas(octree, {indent({1, 1}), leaf({1, 2}, CubeType::FULL), split({6, 6, 6}, CubeType::FULL)});
+    EXPECT_EQ(batches, 1);
+    EXPECT_EQ(changes, 3);
+    EXPECT_TRUE(octree.journal()->empty());
+    EXPECT_EQ(at(octree, {6, 6, 6}).octants.value()[0]->type(), CubeType::FULL);
+
+    // A path through a leaf is rejected.
+    EXPECT_THROW(apply_deltas(octree, {leaf({1, 2, 0}, CubeType::EMPTY)}), std::runtime_error);
+}
+} // namespace inexor::vulkan_renderer::world
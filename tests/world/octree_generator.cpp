@@ -0,0 +1,66 @@
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/octree_generator.hpp"
+
+#include <gtest/gtest.h>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+/// Count the leaves of an octree by type and sum the volume of the leaves which are not empty.
+void count(Cube &cube, std::array<std::size_t, 4> &types, double &volume) {
+    types[static_cast<std::size_t>(cube.type())]++;
+    if (cube.type() == CubeType::OCTANT) {
+        for (const auto &octant : *cube.octants) {
+            count(*octant, types, volume);
+        }
+    } else if (cube.type() != CubeType::EMPTY) {
+        volume += static_cast<double>(cube.size()) * cube.size() * cube.size();
+    }
+}
+} // namespace
+
+TEST(OctreeGenerator, Deterministic) {
+    GeneratorSettings settings;
+    settings.seed = 42;
+    settings.depth = 4;
+    settings.coherence = 0.3f;
+    const auto data = generate_octree_data(settings);
+    EXPECT_EQ(generate_octree_data(settings), data);
+    EXPECT_EQ(generate_octree(settings).serialize(), data);
+    settings.seed = 43;
+    EXPECT_NE(generate_octree_data(settings), data);
+}
+
+TEST(OctreeGenerator, FillRatio) {
+    GeneratorSettings settings;
+    settings.depth = 4;
+    settings.fill_ratio = 0.3f;
+    settings.indentation_probability = 0.0f;
+    Cube cube = generate_octree(settings);
+    std::array<std::size_t, 4> types{};
+    double volume = 0.0;
+    count(cube, types, volume);
+    // Without coherence, the octree is subdivided down to the deepest level.
+    EXPECT_EQ(types[static_cast<std::size_t>(CubeType::OCTANT)], 1 + 8 + 64 + 512);
+    EXPECT_EQ(types[static_cast<std::size_t>(CubeType::EMPTY)] + types[static_cast<std::size_t>(CubeType::FULL)],
+              4096);
+    EXPECT_EQ(types[static_cast<std::size_t>(CubeType::INDENTED)], 0);
+    EXPECT_NEAR(volume, 0.3, 0.03);
+
+    // Coherent octrees consist of fewer and larger leaves with the same fill ratio on average.
+    settings.coherence = 0.2f;
+    settings.indentation_probability = 1.0f;
+    double total_volume = 0.0;
+    constexpr std::uint32_t SEEDS = 50;
+    for (std::uint32_t seed = 0; seed < SEEDS; seed++) {
+        settings.seed = seed;
+        Cube coherent = generate_octree(settings);
+        std::array<std::size_t, 4> coherent_types{};
+        double coherent_volume = 0.0;
+        count(coherent, coherent_types, coherent_volume);
+        EXPECT_LT(coherent_types[static_cast<std::size_t>(CubeType::OCTANT)], 1 + 8 + 64 + 512);
+        EXPECT_EQ(coherent_types[static_cast<std::size_t>(CubeType::FULL)], 0);
+        total_volume += coherent_volume;
+    }
+    EXPECT_NEAR(total_volume / SEEDS, 0.3, 0.1);
+}
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,122 @@
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/octree_history.hpp"
+#include "make_octree.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+constexpr auto O = CubeType::OCTANT;
+} // namespace
+
+TEST(OctreeHistory, SharesUnchangedSubtrees) {
+    Cube octree = *make_octree({O, O, O, O, O, O, O, O});
+    OctreeHistory history(octree);
+    const auto first = history.snapshot();
+    EXPECT_NE(first.get(), &octree);
+    EXPECT_EQ(first->leaves(), 64);
+
+    Cube empty(CubeType::EMPTY, 0.25f, {0.5f, 0.25f, 0.0f});
+    history.assign({4, 2}, empty);
+    const auto second = history.snapshot();
+
+    // The first version is unchanged.
+    EXPECT_EQ(first->leaves(), 64);
+    EXPECT_EQ(second->leaves(), 63);
+    EXPECT_EQ(second->octants.value()[4]->octants.value()[2]->type(), CubeType::EMPTY);
+
+    // Only the path to the edited cube has been copied.
+    for (std::size_t i = 0; i < 8; i++) {
+        EXPECT_EQ(first->octants.value()[i] == second->octants.value()[i], i != 4);
+        EXPECT_EQ(first->octants.value()[4]->octants.value()[i] == second->octants.value()[4]->octants.value()[i],
+                  i != 2);
+    }
+
+    // Changing the original octree does not change the history.
+    *octree.octants.value()[0] = Cube(CubeType::EMPTY, 0.5f, {0.0f, 0.0f, 0.0f});
+    EXPECT_EQ(history.snapshot()->octants.value()[0]->type(), CubeType::OCTANT);
+}
+
+TEST(OctreeHistory, UndoRedo) {
+    Cube octree = *make_octree({O, O, O, O, O, O, O, O});
+    OctreeHistory history(octree, 2);
+    const auto first = history.snapshot();
+    EXPECT_FALSE(history.undo());
+    EXPECT_FALSE(history.redo());
+
+    Cube empty(CubeType::EMPTY, 0.5f, {0.0f, 0.0f, 0.0f});
+    history.assign({0}, empty);
+    const auto second = history.snapshot();
+    Cube full(CubeType::FULL, 1.0f, {0.0f, 0.0f, 0.0f});
+    history.assign({}, full);
+    const auto third = history.snapshot();
+    EXPECT_EQ(third->leaves(), 1);
+    EXPECT_EQ(history.undo_count(), 2);
+
+    EXPECT_TRUE(history.undo());
+    EXPECT_EQ(history.snapshot(), second);
+    EXPECT_TRUE(history.undo());
+    EXPECT_EQ(history.snapshot(), first);
+    EXPECT_FALSE(history.undo());
+    EXPECT_EQ(history.redo_count(), 2);
+    EXPECT_TRUE(history.redo());
+    EXPECT_EQ(history.snapshot(), second);
+
+    // A new edit discards the undone versions.
+    history.assign({1}, empty = Cube(CubeType::EMPTY, 0.5f, {0.0f, 0.0f, 0.5f}));
+    EXPECT_EQ(history.redo_count(), 0);
+    EXPECT_FALSE(history.redo());
+    EXPECT_EQ(history.snapshot()->leaves(), 48);
+
+    // Only the two most recent versions before the current one are kept.
+    history.assign({2}, empty = Cube(CubeType::EMPTY, 0.5f, {0.0f, 0.5f, 0.0f}));
+    EXPECT_EQ(history.snapshot()->leaves(), 40);
+    EXPECT_EQ(history.undo_count(), 2);
+    EXPECT_TRUE(history.undo());
+    EXPECT_TRUE(history.undo());
+    EXPECT_EQ(history.snapshot(), second);
+    EXPECT_FALSE(history.undo());
+}
+
+TEST(OctreeHistory, InvalidEdits) {
+    Cube octree = *make_octree({O, O, O, O, O, O, O, O});
+    OctreeHistory history(octree);
+    Cube empty(CubeType::EMPTY, 0.25f, {0.0f, 0.0f, 0.0f});
+    EXPECT_THROW(history.assign({0, 0, 0}, empty), std::runtime_error);
+    EXPECT_THROW(history.assign({8}, empty), std::runtime_error);
+    EXPECT_THROW(history.assign({1, 0}, empty), std::runtime_error);
+    EXPECT_EQ(history.undo_count(), 0);
+}
+
+TEST(OctreeHistory, ConcurrentReaders) {
+    Cube octree = *make_octree({O, O, O, O, O, O, O, O});
+    OctreeHistory history(octree);
+    const auto first = history.snapshot();
+    const auto polygons = first->polygons();
+
+    // Mesh a snapshot on another thread while the edits continue.
+    std::thread reader([&] {
+        for (int i = 0; i < 100; i++) {
+            EXPECT_EQ(first->polygons().size(), polygons.size());
+            EXPECT_LE(history.snapshot()->leaves(), 64);
+        }
+    });
+    for (std::size_t i = 0; i < 64; i++) {
+        const std::size_t octant = i / 8;
+        const std::size_t child = i % 8;
+        const glm::vec3 position = glm::vec3((octant & 4) ? 0.5f : 0.0f, (octant & 2) ? 0.5f : 0.0f,
+                                             (octant & 1) ? 0.5f : 0.0f) +
+                                   glm::vec3((child & 4) ? 0.25f : 0.0f, (child & 2) ? 0.25f : 0.0f,
+                                             (child & 1) ? 0.25f : 0.0f);
+        Cube empty(CubeType::EMPTY, 0.25f, position);
+        history.assign({octant, child}, empty);
+    }
+    reader.join();
+    EXPECT_EQ(history.snapshot()->leaves(), 0);
+    EXPECT_EQ(first->polygons(), polygons);
+}
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,153 @@
+#include "inexor/vulkan-renderer/world/bit_stream_writer.hpp"
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/octree_pool.hpp"
+
+#include <gtest/gtest.h>
+
+namespace inexor::vulkan_renderer::world {
+TEST(OctreePool, SameGeometryAsCube) {
+    std::vector<unsigned char> data = {0xC4, 0x52, 0x03, 0xC0, 0x00, 0x00};
+    Cube cube = Cube::parse(data);
+    const OctreePool pool = OctreePool::parse(data);
+
+    EXPECT_EQ(pool.root().type(), CubeType::OCTANT);
+    EXPECT_EQ(pool.node_count(), 9);
+    EXPECT_EQ(pool.root().leaves(), cube.leaves());
+    EXPECT_EQ(pool.root().polygons(), cube.polygons());
+    EXPECT_EQ(OctreePool(cube).root().polygons(), cube.polygons());
+}
+
+TEST(OctreePool, CompactEncoding) {
+    // Octants of every type on two levels, the types of the octants are mixed in both orders.
+    BitStreamWriter writer;
+    writer.put(static_cast<std::uint8_t>(CubeType::OCTANT), 2);
+    for (std::uint8_t i = 0; i < 8; i++) {
+        const auto type = static_cast<CubeType>(i % 4);
+        writer.put(static_cast<std::uint8_t>(type), 2);
+        if (type == CubeType::INDENTED) {
+            std::array<glm::tvec3<std::uint8_t>, 8> levels;
+            for (std::uint8_t corner = 0; corner < 8; corner++) {
+                levels[corner] = {corner, static_cast<std::uint8_t>(MAX_INDENTATION - corner), i};
+            }
+            writer.put_indentations(levels);
+        } else if (type == CubeType::OCTANT) {
+            for (std::uint8_t j = 0; j < 8; j++) {
+                writer.put(static_cast<std::uint8_t>(3 - (i + j) % 3), 2);
+                if (3 - (i + j) % 3 == static_cast<std::uint8_t>(CubeType::INDENTED)) {
+                    writer.put_indentations({});
+                } else if (3 - (i + j) % 3 == static_cast<std::uint8_t>(CubeType::OCTANT)) {
+                    for (std::uint8_t k = 0; k < 8; k++) {
+                        writer.put(static_cast<std::uint8_t>(CubeType::FULL), 2);
+                    }
+                }
+            }
+        }
+    }
+    std::vector<unsigned char> data = writer.finish();
+    Cube cube = Cube::parse(data);
+    OctreePool pool = OctreePool::parse(data);
+
+    EXPECT_EQ(pool.root().polygons(), cube.polygons());
+    EXPECT_EQ(pool.root().octant(2).indentation_levels(), OctreePool(cube).root().octant(2).indentation_levels());
+    EXPECT_EQ(pool.root().octant(6).indentation_levels()[7], (glm::tvec3<std::uint8_t>{7, 1, 6}));
+
+    // Only the 8 cubes of CubeType::OCTANT are nodes, empty and full cubes take no memory of their own.
+    EXPECT_EQ(pool.node_count(), 1 + 8 * 8);
+    pool.shrink_to_fit();
+    EXPECT_EQ(pool.memory_usage(), sizeof(OctreePool) + 8 * 12 + 8 * 12);
+
+    // Polygons are appended to the buffer of the caller.
+    std::vector<std::array<glm::vec3, 3>> polygons(1);
+    pool.root().polygons(polygons);
+    EXPECT_EQ(polygons.size(), 1 + pool.root().leaves() * 12);
+}
+
+namespace {
+/// Write an octree whose 8 octants are identical subtrees.
+std::vector<unsigned char> repeated_octree() {
+    BitStreamWriter writer;
+    writer.put(static_cast<std::uint8_t>(CubeType::OCTANT), 2);
+    for (std::uint8_t i = 0; i < 8; i++) {
+        writer.put(static_cast<std::uint8_t>(CubeType::OCTANT), 2);
+        writer.put(static_cast<std::uint8_t>(CubeType::FULL), 2);
+        writer.put(static_cast<std::uint8_t>(CubeType::INDENTED), 2);
+        std::array<glm::tvec3<std::uint8_t>, 8> levels;
+        for (std::uint8_t corner = 0; corner < 8; corner++) {
+            levels[corner] = {corner, 0, static_cast<std::uint8_t>(MAX_INDENTATION - corner)};
+        }
+        writer.put_indentations(levels);
+        writer.put(static_cast<std::uint8_t>(CubeType::OCTANT), 2);
+        for (std::uint8_t j = 0; j < 8; j++) {
+            writer.put(static_cast<std::uint8_t>(j % 2 == 0 ? CubeType::FULL : CubeType::EMPTY), 2);
+        }
+        for (std::uint8_t j = 3; j < 8; j++) {
+            writer.put(static_cast<std::uint8_t>(CubeType::EMPTY), 2);
+        }
+    }
+    return writer.finish();
+}
+} // namespace
+
+TEST(OctreePool, SharesIdenticalSubtrees) {
+    std::vector<unsigned char> data = repeated_octree();
+    Cube cube = Cube::parse(data);
+    const OctreePool pool = OctreePool::parse(data);
+    const OctreePool shared = OctreePool::parse(data, true);
+
+    EXPECT_EQ(shared.root().polygons(), cube.polygons());
+    EXPECT_EQ(shared.node_count(), pool.node_count());
+    EXPECT_EQ(pool.statistics().ratio(), 1.0);
+
+    // The root and its 8 octants are stored, the subtrees of the octants only once.
+    const auto statistics = shared.statistics();
+    EXPECT_EQ(statistics.octree_nodes, 17);
+    EXPECT_EQ(statistics.octree_indentations, 8);
+    EXPECT_EQ(statistics.stored_nodes, 10);
+    EXPECT_EQ(statistics.stored_indentations, 1);
+    EXPECT_DOUBLE_EQ(statistics.ratio(), 25.0 / 11.0);
+
+    // Sharing afterwards gives the same result as sharing during parsing.
+    OctreePool copy(cube);
+    copy.share_subtrees();
+    EXPECT_EQ(copy.statistics().stored_nodes, 10);
+    EXPECT_EQ(copy.root().polygons(), cube.polygons());
+    EXPECT_EQ(OctreePool(cube, true).statistics().stored_nodes, 10);
+}
+
+TEST(OctreePool, CopyOnWrite) {
+    std::vector<unsigned char> data = repeated_octree();
+    Cube cube = Cube::parse(data);
+    OctreePool pool = OctreePool::parse(data, true);
+
+    // Only the edited occurrence of the shared subtree changes.
+    Cube &target = *cube.octants.value()[5]->octants.value()[1];
+    target = Cube(CubeType::FULL, target.size(), target.position());
+    pool.assign({5, 1}, target);
+    EXPECT_EQ(pool.root().polygons(), cube.polygons());
+    EXPECT_EQ(pool.root().octant(4).octant(1).type(), CubeType::INDENTED);
+    EXPECT_EQ(pool.root().octant(5).octant(1).type(), CubeType::FULL);
+    EXPECT_EQ(pool.statistics().octree_indentations, 7);
+    EXPECT_EQ(pool.node_count(), 1 + 8 * 17);
+
+    // The copied nodes stay in the pools until they are compacted.
+    EXPECT_EQ(pool.statistics().stored_nodes, 10 + 1 + 8 + 1);
+    pool.compact();
+    EXPECT_EQ(pool.statistics().stored_nodes, 11);
+    EXPECT_EQ(pool.root().polygons(), cube.polygons());
+    pool.share_subtrees();
+    EXPECT_EQ(pool.statistics().stored_nodes, 10);
+    EXPECT_EQ(pool.root().polygons(), cube.polygons());
+
+    // Replacing a subtree updates the number of cubes, octant 2 and its last octant are removed.
+    Cube &octant = *cube.octants.value()[2];
+    octant = Cube(CubeType::EMPTY, octant.size(), octant.position());
+    pool.assign({2}, octant);
+    EXPECT_EQ(pool.node_count(), 1 + 8 * 15);
+    EXPECT_EQ(pool.statistics().octree_nodes, 15);
+
+    pool.assign({}, cube);
+    EXPECT_EQ(pool.root().polygons(), cube.polygons());
+    EXPECT_EQ(pool.node_count(), 1 + 8 * 15);
+    EXPECT_THROW(pool.assign({0, 3, 0, 0}, cube), std::runtime_error);
+}
+} // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,55 @@
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/quantization.hpp"
+
+#include <glm/glm.hpp>
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace inexor::vulkan_renderer::world {
+TEST(Quantization, Position) {
+    const glm::vec3 origin(-2.0f, 0.0f, 4.0f);
+    const auto quantization = PositionQuantization::for_chunk(8.0f, origin);
+
+    // The corners of the chunk.
+    EXPECT_EQ(quantization.encode(origin), (std::array<std::uint16_t, 3>{0, 0, 0}));
+    EXPECT_EQ(quantization.encode(origin + glm::vec3(8.0f)), (std::array<std::uint16_t, 3>{32768, 32768, 32768}));
+
+    // Every indentation step of a cube on the deepest quantized level is represented exactly.
+    const float size = 8.0f / static_cast<float>(1u << QUANTIZATION_DEPTH);
+    const glm::vec3 cube = origin + glm::vec3(1234.0f, 17.0f, 4095.0f) * size;
+    for (std::uint8_t level = 0; level <= MAX_INDENTATION; level++) {
+        const glm::vec3 position = cube + glm::vec3(level, MAX_INDENTATION - level, level) * (size / MAX_INDENTATION);
+        const glm::vec3 decoded = quantization.decode(quantization.encode(position));
+        EXPECT_EQ(decoded.x, position.x);
+        EXPECT_EQ(decoded.y, position.y);
+        EXPECT_EQ(decoded.z, position.z);
+    }
+
+    // Positions outside of the chunk are clamped.
+    EXPECT_EQ(quantization.encode(origin + glm::vec3(-1.0f, 100.0f, 0.0f)),
+              (std::array<std::uint16_t, 3>{0, 65535, 0}));
+}
+
+TEST(Quantization, Normal) {
+    for (const glm::vec3 &axis : {glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f),
+                                  glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, -1.0f)}) {
+        const glm::vec3 decoded = decode_normal(encode_normal(axis * 3.0f));
+        EXPECT_NEAR(decoded.x, axis.x, 1e-4f);
+        EXPECT_NEAR(decoded.y, axis.y, 1e-4f);
+        EXPECT_NEAR(decoded.z, axis.z, 1e-4f);
+    }
+
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    for (int i = 0; i < 1000; i++) {
+        const glm::vec3 normal =
+            glm::normalize(glm::vec3(distribution(generator), distribution(generator), distribution(generator)));
+        EXPECT_NEAR(glm::distance(decode_normal(encode_normal(normal)), normal), 0.0f, 1e-4f);
+    }
+
+    // A zero vector results in a valid normal.
+    const glm::vec3 zero = decode_normal(encode_normal(glm::vec3(0.0f)));
+    EXPECT_EQ(zero.z, 1.0f);
+}
+} // namespace inexor::vulkan_renderer::world
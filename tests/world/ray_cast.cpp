@@ -0,0 +1,97 @@
+#include "inexor/vulkan-renderer/thread_pool.hpp"
+#include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/world/ray_cast.hpp"
+#include "make_octree.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+
+namespace inexor::vulkan_renderer::world {
+namespace {
+constexpr auto E = CubeType::EMPTY;
+constexpr auto F = CubeType::FULL;
+} // namespace
+
+TEST(RayCast, FullLeaf) {
+    Cube cube = *make_octree({F, E, E, E, F, E, E, E});
+    const auto side = ray_cast(cube, {{-1.0f, 0.25f, 0.25f}, {1.0f, 0.0f, 0.0f}});
+    ASSERT_TRUE(side);
+    EXPECT_EQ(side->leaf, cube.octants.value()[0].get());
+    EXPECT_EQ(side->face, 0);
+    EXPECT_EQ(side->point, glm::vec3(0.0f, 0.25f, 0.25f));
+    EXPECT_FLOAT_EQ(side->distance, 1.0f);
+
+    // The closer of both octants is hit from the higher side.
+    const auto back = ray_cast(cube, {{3.0f, 0.25f, 0.25f}, {-2.0f, 0.0f, 0.0f}});
+    ASSERT_TRUE(back);
+    EXPECT_EQ(back->leaf, cube.octants.value()[4].get());
+    EXPECT_EQ(back->face, 1);
+    EXPECT_FLOAT_EQ(back->distance, 1.0f);
+
+    const auto top = ray_cast(cube, {{0.25f, 2.0f, 0.25f}, {0.0f, -1.0f, 0.0f}});
+    ASSERT_TRUE(top);
+    EXPECT_EQ(top->face, 3);
+    EXPECT_FLOAT_EQ(top->distance, 1.5f);
+
+    // A ray which starts within a leaf hits the side it leaves the leaf through.
+    const auto inside = ray_cast(cube, {{0.25f, 0.25f, 0.25f}, {0.0f, 0.0f, 1.0f}});
+    ASSERT_TRUE(inside);
+    EXPECT_EQ(inside->face, 5);
+    EXPECT_FLOAT_EQ(inside->distance, 0.25f);
+}
+
+TEST(RayCast, Miss) {
+    Cube cube = *make_octree({F, E, E, E, F, E, E, E});
+    EXPECT_FALSE(ray_cast(cube, {{0.25f, 2.0f, 0.25f}, {0.0f, 1.0f, 0.0f}}));
+    EXPECT_FALSE(ray_cast(cube, {{0.25f, 0.75f, -1.0f}, {0.0f, 0.0f, 1.0f}}));
+    EXPECT_FALSE(ray_cast(cube, {{-1.0f, 0.25f, 0.25f}, {1.0f, 0.0f, 0.0f}}, 0.5f));
+}
+
+TEST(RayCast, IndentedLeaf) {
+    // The upper corners are indented to half of the height of the cube.
+    std::array<Indentation, 8> indentations;
+    for (const std::size_t corner : {2, 3, 6, 7}) {
+        indentations[corner] = glm::tvec3<std::uint8_t>(0, MAX_INDENTATION / 2, 0);
+    }
+    Cube cube(indentations, 1.0f, {0.0f, 0.0f, 0.0f});
+    const auto hit = ray_cast(cube, {{0.3f, 2.0f, 0.6f}, {0.0f, -1.0f, 0.0f}});
+    ASSERT_TRUE(hit);
+    EXPECT_EQ(hit->leaf, &cube);
+    EXPECT_EQ(hit->face, 3);
+    EXPECT_FLOAT_EQ(hit->distance, 1.5f);
+    EXPECT_FLOAT_EQ(hit->point.y, 0.5f);
+
+    // The ray passes through the indented part of the bounds.
+    const auto side = ray_cast(cube, {{-1.0f, 0.75f, 0.5f}, {1.0f, 0.0f, 0.0f}});
+    EXPECT_FALSE(side);
+}
+
+TEST(RayCast, Batched) {
+    std::vector<unsigned char> data = {0xC4, 0x52, 0x03, 0xC0, 0x00, 0x00};
+    Cube cube = Cube::parse(data);
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<Ray> rays(1000);
+    for (auto &ray : rays) {
+        ray.origin = {distribution(generator) + 0.5f, 2.0f, distribution(generator) + 0.5f};
+        ray.direction = {distribution(generator), -1.0f, distribution(generator)};
+    }
+
+    ThreadPool thread_pool(2);
+    const auto hits = ray_cast(cube, rays, thread_pool, 10.0f, 64);
+    ASSERT_EQ(hits.size(), rays.size());
+    std::size_t hit_count = 0;
+    for (std::size_t i = 0; i < rays.size(); i++) {
+        const auto hit = ray_cast(cube, rays[i], 10.0f);
+        ASSERT_EQ(hits[i].has_value(), hit.has_value());
+        if (hit) {
+            hit_count++;
+            EXPECT_EQ(hits[i]->leaf, hit->leaf);
+            EXPECT_EQ(hits[i]->distance, hit->distance);
+        }
+    }
+    EXPECT_GT(hit_count, 0);
+}
+} // namespace inexor::vulkan_renderer::world